@@ -98,6 +98,11 @@ AudioPluginAudioProcessorEditor::AudioPluginAudioProcessorEditor (AudioPluginAud
         };
     addAndMakeVisible(buttonInvokeSongDocumentExchange.get());
 
+    toggleEmbedRenderedAudio = std::make_unique<juce::ToggleButton>();
+    toggleEmbedRenderedAudio->setButtonText("Embed audio");
+    toggleEmbedRenderedAudio->getToggleStateValue().referTo(processorRef.getEditorState().getPropertyAsValue("State_EmbedRenderedAudio", nullptr));
+    addAndMakeVisible(toggleEmbedRenderedAudio.get());
+
     progressPanel = std::make_unique<ProgressPanel>();
     addChildComponent(progressPanel.get());
 
@@ -109,6 +114,9 @@ AudioPluginAudioProcessorEditor::AudioPluginAudioProcessorEditor (AudioPluginAud
     valueIsVoicevoxEngineHasSpeakerListUpdated.referTo(processorRef.getEditorState(), "VoicevoxEngine_HasSpeakerListUpdated", nullptr);
     valueIsVoicevoxEngineHasSpeakerListUpdated.forceUpdateOfCachedValue();
 
+    valueIsVoicevoxEngineReady.referTo(processorRef.getEditorState(), "VoicevoxEngine_IsReady", nullptr);
+    valueIsVoicevoxEngineReady.forceUpdateOfCachedValue();
+
     // Initial update
     updateView(true);
 
@@ -165,6 +173,7 @@ void AudioPluginAudioProcessorEditor::resized()
 
             // Exchange
             buttonInvokeSongDocumentExchange->setBounds(rect_transport.removeFromRight(120).reduced(8));
+            toggleEmbedRenderedAudio->setBounds(rect_transport.removeFromRight(120).reduced(8));
 
             buttonTransportMenu->setBounds(rect_transport.removeFromLeft(120).reduced(8));
             labelTimecodeDisplay->setBounds(rect_transport.reduced(8));
@@ -195,6 +204,12 @@ void AudioPluginAudioProcessorEditor::valueTreePropertyChanged(juce::ValueTree&
             should_update_view = true;
         }
 
+        if (propertyId == valueIsVoicevoxEngineReady.getPropertyID())
+        {
+            valueIsVoicevoxEngineReady.forceUpdateOfCachedValue();
+            should_update_view = true;
+        }
+
         if (propertyId == valueIsVoicevoxEngineHasSpeakerListUpdated.getPropertyID())
         {
             valueIsVoicevoxEngineHasSpeakerListUpdated.forceUpdateOfCachedValue();
@@ -241,6 +256,10 @@ void AudioPluginAudioProcessorEditor::updateView(bool isInitial)
 {
     progressPanel->setVisible(valueIsVoicevoxEngineTaskRunning);
 
+    // Requests are accepted before the engine is ready, but would wait for it to start.
+    buttonInvokeHumming->setEnabled(valueIsVoicevoxEngineReady);
+    buttonInvokeSongDocumentExchange->setEnabled(valueIsVoicevoxEngineReady);
+
     if (isInitial)
     {
         {
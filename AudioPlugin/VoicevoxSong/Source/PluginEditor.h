@@ -62,8 +62,10 @@ private:
     std::unique_ptr<ProgressPanel> progressPanel;
     juce::CachedValue<bool> valueIsVoicevoxEngineTaskRunning;
     juce::CachedValue<bool> valueIsVoicevoxEngineHasSpeakerListUpdated;
+    juce::CachedValue<bool> valueIsVoicevoxEngineReady;
 
     std::unique_ptr<juce::TextButton> buttonInvokeSongDocumentExchange;
+    std::unique_ptr<juce::ToggleButton> toggleEmbedRenderedAudio;
     std::unique_ptr<juce::ThreadWithProgressWindow> processTaskThread;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioPluginAudioProcessorEditor)
@@ -1,5 +1,9 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "State/PluginStateArchive.h"
+#include "Score/SongDocumentArchive.h"
+#include "Audio/WavAudioCodec.h"
+#include "Engine/AudioQueryJson.h"
 
 #include <cocotone_song_editor_formats/cocotone_song_editor_formats.h>
 #include <cocotone_song_editor_basics/SongEditor/Document/Test/TestData.h>
@@ -18,6 +22,9 @@ AudioPluginAudioProcessor::AudioPluginAudioProcessor()
     , applicationState("application_state")
     , isSyncToHostTransport(false)
 {
+    // Created here on the message thread, so the rendering threads only ever copy it.
+    juce::WeakReference<AudioPluginAudioProcessor> weak_reference(this);
+
     // Application state related.
     applicationState.setProperty("Player_CanPlay", juce::var(false), nullptr);
     applicationState.setProperty("Player_IsPlaying", juce::var(false), nullptr);
@@ -27,9 +34,11 @@ AudioPluginAudioProcessor::AudioPluginAudioProcessor()
     applicationState.addListener(this);
 
     editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(false), nullptr);
+    editorState.setProperty("VoicevoxEngine_IsReady", juce::var(false), nullptr);
     editorState.setProperty("VoicevoxEngine_SelectedTalkSpeakerIdentifier", juce::var(""), nullptr);
     editorState.setProperty("VoicevoxEngine_SelectedHummingSpeakerIdentifier", juce::var(""), nullptr);
     editorState.setProperty("VoicevoxEngine_HasSpeakerListUpdated", juce::var(false), nullptr);
+    editorState.setProperty("State_EmbedRenderedAudio", juce::var(false), nullptr);
 
     voicevoxMapSpeakerIdentifierToSpeakerId.clear();
     voicevoxTalkSpeakerIdentifierList.clear();
@@ -39,9 +48,6 @@ AudioPluginAudioProcessor::AudioPluginAudioProcessor()
     audioFormatManager = std::make_unique<juce::AudioFormatManager>();
     audioFormatManager->registerBasicFormats();
 
-    audioBufferingThread = std::make_unique<juce::TimeSliceThread>("AudioBufferingThread");
-    audioBufferingThread->startThread();
-
     audioTransportSource = std::make_unique<juce::AudioTransportSource>();
 
     hostSyncAudioSourcePlayer = std::make_unique<cctn::HostSyncAudioSourcePlayer>();
@@ -50,23 +56,79 @@ AudioPluginAudioProcessor::AudioPluginAudioProcessor()
     audioDataForAudioThumbnail = std::make_unique<AudioDataForAudioThumbnail>();
     audioDataForAudioThumbnail->audioBuffer.clear();
    
-    voicevoxEngine = std::make_unique<cctn::VoicevoxEngine>();
+    // The engine comes up in the background, independently of prepareToPlay and releaseResources.
+    if (const auto daemon_port = SynthesisDaemonClient::getPortFromEnvironment())
+    {
+        synthesisDaemonClient = std::make_unique<SynthesisDaemonClient>();
+        if (synthesisDaemonClient->connect(daemon_port.value()))
+        {
+            synthesisDaemonClient->requestMetadataAsync(
+                [this] {
+                    voicevoxEnginePoolReady();
+                });
+        }
+        else
+        {
+            juce::Logger::outputDebugString("[SynthesisDaemonClient] no daemon on port " + juce::String(daemon_port.value()) + ", rendering in process");
+            synthesisDaemonClient.reset();
+        }
+    }
+
+    voicevoxEnginePool->addListener(this);
+    if (synthesisDaemonClient == nullptr)
+    {
+        // An instance joining a pool that is already warm is ready right away. Metadata the pool
+        // reads from the cache within warmUpAsync() is notified by the pool, only metadata it
+        // already had is not.
+        const bool had_metadata = voicevoxEnginePool->hasMetadata();
+        voicevoxEnginePool->warmUpAsync();
+        if (voicevoxEnginePool->isReady())
+        {
+            voicevoxEnginePoolReady();
+        }
+        else if (had_metadata)
+        {
+            voicevoxEnginePoolMetadataAvailable();
+        }
+    }
+
+    voicevoxRequestQueue = std::make_unique<VoicevoxRequestQueue>(voicevoxEnginePool.getScheduler(), *synthesisCache, *audioQueryCache);
+    synthesisRequestRouter = std::make_unique<SynthesisRequestRouter>(*voicevoxRequestQueue, *synthesisCache, *audioQueryCache, synthesisDaemonClient.get());
+    voicevoxRequestQueue->setPlayheadPositionProvider(
+        [this]() -> std::optional<double> {
+            const auto time_in_seconds = this->getLastPositionInfo().getTimeInSeconds();
+            if (!time_in_seconds.hasValue())
+            {
+                return std::nullopt;
+            }
+
+            return *time_in_seconds;
+        });
 
     songDocumentEditor = std::make_shared<cctn::song::SongDocumentEditor>();
     songTransportEmulator = std::make_unique<cctn::song::TransportEmulator>();
 
+    phraseAudioCache = std::make_unique<PhraseAudioCache>();
+
     currentSongDocument = std::move(cctn::song::SongEditorOperation::makeDefaultSongDocument());
     songDocumentEditor->attachDocument(currentSongDocument);
 
     audioTransportSource->addChangeListener(this);
 
+    renderedAudioRecall = std::make_unique<RenderedAudioRecall>();
+
     // Initial update
     isSyncToHostTransport = (bool)applicationState.getProperty("Player_IsSyncToHostTransport");
 }
 
 AudioPluginAudioProcessor::~AudioPluginAudioProcessor()
 {
-    voicevoxEngine->shutdown();
+    renderedAudioRecall.reset();
+
+    voicevoxEnginePool->removeListener(this);
+    synthesisRequestRouter.reset();
+    synthesisDaemonClient.reset();
+    voicevoxRequestQueue.reset();
 
     audioTransportSource->removeChangeListener(this);
 
@@ -150,24 +212,11 @@ void AudioPluginAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
 
     audioTransportSource->prepareToPlay(samplesPerBlock, sampleRate);
 
-    voicevoxEngine->start();
-    voicevoxMapSpeakerIdentifierToSpeakerId = voicevoxEngine->getSpeakerIdentifierToSpeakerIdMap();
-    voicevoxTalkSpeakerIdentifierList = voicevoxEngine->getTalkSpeakerIdentifierList();
-    voicevoxHummingSpeakerIdentifierList = voicevoxEngine->getHummingSpeakerIdentifierList();
-
-    editorState.setProperty("VoicevoxEngine_HasSpeakerIdUpdated", juce::var(true), nullptr);
-    
-    juce::Logger::outputDebugString(this->getMetaJsonStringify());
-
     hostSyncAudioSourcePlayer->prepareToPlay(samplesPerBlock, sampleRate);
 }
 
 void AudioPluginAudioProcessor::releaseResources()
 {
-    voicevoxEngine->stop();
-    voicevoxTalkSpeakerIdentifierList.clear();
-    voicevoxHummingSpeakerIdentifierList.clear();
-    voicevoxMapSpeakerIdentifierToSpeakerId.clear();
 
     hostSyncAudioSourcePlayer->releaseResources();
 }
@@ -267,26 +316,77 @@ juce::AudioProcessorEditor* AudioPluginAudioProcessor::createEditor()
 //==============================================================================
 void AudioPluginAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
-    juce::ignoreUnused (destData);
+    PluginStateArchive::Contents contents;
+    contents.songDocument = SongDocumentArchive::write(*currentSongDocument.get());
+    contents.selectedTalkSpeakerIdentifier = editorState.getProperty("VoicevoxEngine_SelectedTalkSpeakerIdentifier").toString();
+    contents.selectedHummingSpeakerIdentifier = editorState.getProperty("VoicevoxEngine_SelectedHummingSpeakerIdentifier").toString();
+
+    // Embedding the rendered audio is opt-in, it makes the host session considerably larger.
+    contents.embedsRenderedAudio = (bool)editorState.getProperty("State_EmbedRenderedAudio");
+    if (contents.embedsRenderedAudio)
+    {
+        // Copied under the lock, compressed outside it so a render landing meanwhile is not held up.
+        juce::AudioBuffer<float> audio_buffer;
+        double sample_rate = 0.0;
+        {
+            const juce::ScopedLock lock(audioDataForAudioThumbnailLock);
+            audio_buffer.makeCopyOf(audioDataForAudioThumbnail->audioBuffer);
+            sample_rate = audioDataForAudioThumbnail->sampleRate;
+        }
+
+        contents.compressedAudio = PluginStateArchive::compressAudio(audio_buffer, sample_rate);
+    }
+
+    PluginStateArchive::write(contents, destData);
 }
 
 void AudioPluginAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
-    juce::ignoreUnused (data, sizeInBytes);
+    const auto contents = PluginStateArchive::read(data, sizeInBytes);
+    if (!contents.has_value())
+    {
+        return;
+    }
+
+    auto restore_editor_state =
+        [this, restored = contents.value()] {
+            editorState.setProperty("VoicevoxEngine_SelectedTalkSpeakerIdentifier", restored.selectedTalkSpeakerIdentifier, nullptr);
+            editorState.setProperty("VoicevoxEngine_SelectedHummingSpeakerIdentifier", restored.selectedHummingSpeakerIdentifier, nullptr);
+            editorState.setProperty("State_EmbedRenderedAudio", restored.embedsRenderedAudio, nullptr);
+
+            // The embedded audio was rendered from this document, so the two come back together.
+            if (auto restored_document = SongDocumentArchive::read(restored.songDocument))
+            {
+                songDocumentEditor->detachDocument();
+                currentSongDocument = std::move(restored_document);
+                songDocumentEditor->attachDocument(currentSongDocument);
+            }
+        };
+
+    if (juce::MessageManager::existsAndIsCurrentThread())
+    {
+        restore_editor_state();
+    }
+    else
+    {
+        callAsyncWhileAlive(restore_editor_state);
+    }
+
+    // Decoded lazily off the calling thread, the engine is not involved at all.
+    if (contents->compressedAudio.getSize() > 0)
+    {
+        renderedAudioRecall->decodeAsync(contents->compressedAudio,
+            [this](const cctn::AudioBufferInfo& audioBufferInfo) {
+                this->loadVoicevoxEngineAudioBufferInfo(audioBufferInfo);
+            });
+    }
 }
 
 //==============================================================================
 void AudioPluginAudioProcessor::loadAudioFile(const juce::File& fileToLoad)
 {
     // Unload the previous file source and delete it..
-    audioTransportSource->stop();
-    audioTransportSource->setSource(nullptr);
-    audioFormatReaderSource.reset();
+    unloadTransportSource();
 
     juce::AudioFormatReader* reader = audioFormatManager->createReaderFor(fileToLoad);
 
@@ -296,17 +396,20 @@ void AudioPluginAudioProcessor::loadAudioFile(const juce::File& fileToLoad)
 
         audioTransportSource->setSource(audioFormatReaderSource.get(),
             32768,
-            audioBufferingThread.get(),
+            &audioBufferingThread.getObject(),
             reader->sampleRate,
             2);
 
         // Update audio thumbnail
-        audioDataForAudioThumbnail->sampleRate = reader->sampleRate;
-        audioDataForAudioThumbnail->audioBuffer.clear();
-        audioDataForAudioThumbnail->audioBuffer.setSize(2, reader->lengthInSamples);
-        reader->read(&audioDataForAudioThumbnail->audioBuffer, 0, reader->lengthInSamples, 0, true, true);
+        {
+            const juce::ScopedLock lock(audioDataForAudioThumbnailLock);
+            audioDataForAudioThumbnail->sampleRate = reader->sampleRate;
+            audioDataForAudioThumbnail->audioBuffer.clear();
+            audioDataForAudioThumbnail->audioBuffer.setSize(2, reader->lengthInSamples);
+            reader->read(&audioDataForAudioThumbnail->audioBuffer, 0, reader->lengthInSamples, 0, true, true);
+        }
         
-        juce::MessageManager::callAsync(
+        callAsyncWhileAlive(
             [this] {
                 this->resetAudioThumbnail();
             });
@@ -323,45 +426,10 @@ void AudioPluginAudioProcessor::loadAudioFile(const juce::File& fileToLoad)
     }
 }
 
-void AudioPluginAudioProcessor::loadAudioFileStream(std::unique_ptr<juce::InputStream> audioFileStream)
-{
-    // Unload the previous file source and delete it..
-    audioTransportSource->stop();
-    audioTransportSource->setSource(nullptr);
-    audioFormatReaderSource.reset();
-
-    juce::AudioFormatReader* reader = audioFormatManager->createReaderFor(std::move(audioFileStream));
-
-    if (reader != nullptr)
-    {
-        audioFormatReaderSource = std::make_unique<juce::AudioFormatReaderSource>(reader, true);
-
-        audioTransportSource->setSource(audioFormatReaderSource.get(),
-            32768,
-            audioBufferingThread.get(),
-            reader->sampleRate,
-            2);
-
-        // Update audio thumbnail
-        audioDataForAudioThumbnail->sampleRate = reader->sampleRate;
-        audioDataForAudioThumbnail->audioBuffer.clear();
-        audioDataForAudioThumbnail->audioBuffer.setSize(2, reader->lengthInSamples);
-        reader->read(&audioDataForAudioThumbnail->audioBuffer, 0, reader->lengthInSamples, 0, true, true);
-
-        juce::MessageManager::callAsync(
-            [this] {
-                this->resetAudioThumbnail();
-                this->updatePlayerState();
-            });
-    }
-}
-
 void AudioPluginAudioProcessor::loadVoicevoxEngineAudioBufferInfo(const cctn::AudioBufferInfo& audioBufferInfo)
 {
     // Unload the previous file source and delete it..
-    audioTransportSource->stop();
-    audioTransportSource->setSource(nullptr);
-    memoryAudioSource.reset();
+    unloadTransportSource();
 
     juce::AudioBuffer<float> stereonized_buffer;
     stereonized_buffer.setSize(2, audioBufferInfo.audioBuffer.getNumSamples());
@@ -374,47 +442,90 @@ void AudioPluginAudioProcessor::loadVoicevoxEngineAudioBufferInfo(const cctn::Au
 
     audioTransportSource->setSource(memoryAudioSource.get(),
         32768,
-        audioBufferingThread.get(),
+        &audioBufferingThread.getObject(),
         audioBufferInfo.sampleRate,
         2);
 
     // Update audio thumbnail
-    audioDataForAudioThumbnail->sampleRate = audioBufferInfo.sampleRate;
-    audioDataForAudioThumbnail->audioBuffer.clear();
-    audioDataForAudioThumbnail->audioBuffer.makeCopyOf(stereonized_buffer, false);
+    {
+        const juce::ScopedLock lock(audioDataForAudioThumbnailLock);
+        audioDataForAudioThumbnail->sampleRate = audioBufferInfo.sampleRate;
+        audioDataForAudioThumbnail->audioBuffer.clear();
+        audioDataForAudioThumbnail->audioBuffer.makeCopyOf(stereonized_buffer, false);
+    }
 
-    juce::MessageManager::callAsync(
+    callAsyncWhileAlive(
         [this] {
             this->resetAudioThumbnail();
             this->updatePlayerState();
         });
 }
 
+void AudioPluginAudioProcessor::previewVoicevoxEngineAudioBufferInfo(const cctn::AudioBufferInfo& audioBufferInfo)
+{
+    juce::AudioBuffer<float> stereonized_buffer;
+    stereonized_buffer.setSize(2, audioBufferInfo.audioBuffer.getNumSamples());
+    stereonized_buffer.copyFrom(0, 0, audioBufferInfo.audioBuffer.getReadPointer(0), audioBufferInfo.audioBuffer.getNumSamples());
+    stereonized_buffer.copyFrom(1, 0, audioBufferInfo.audioBuffer.getReadPointer(0), audioBufferInfo.audioBuffer.getNumSamples());
+
+    hostSyncAudioSourcePlayer->setAudioBufferToPlay(stereonized_buffer, audioBufferInfo.sampleRate);
+
+    // Update audio thumbnail
+    {
+        const juce::ScopedLock lock(audioDataForAudioThumbnailLock);
+        audioDataForAudioThumbnail->sampleRate = audioBufferInfo.sampleRate;
+        audioDataForAudioThumbnail->audioBuffer.clear();
+        audioDataForAudioThumbnail->audioBuffer.makeCopyOf(stereonized_buffer, false);
+    }
+
+    callAsyncWhileAlive(
+        [this] {
+            this->resetAudioThumbnail();
+        });
+}
+
 void AudioPluginAudioProcessor::clearAudioFileHandle()
 {
     // Unload the previous file source and delete it..
-    audioTransportSource->stop();
-    audioTransportSource->setSource(nullptr);
-    audioFormatReaderSource.reset();
+    unloadTransportSource();
 
     hostSyncAudioSourcePlayer->clearAudioBufferToPlay();
 
     // Update audio thumbnail
-    audioDataForAudioThumbnail->sampleRate = 0.0;
-    audioDataForAudioThumbnail->audioBuffer.clear();
+    {
+        const juce::ScopedLock lock(audioDataForAudioThumbnailLock);
+        audioDataForAudioThumbnail->sampleRate = 0.0;
+        audioDataForAudioThumbnail->audioBuffer.clear();
+    }
 
-    juce::MessageManager::callAsync(
+    callAsyncWhileAlive(
         [this] {
             this->resetAudioThumbnail();
             this->updatePlayerState();
         });
 }
 
+void AudioPluginAudioProcessor::unloadTransportSource()
+{
+    // Taken out under the lock first, so a preview attaching it meanwhile finds none; it is deleted once detached below.
+    std::unique_ptr<ProgressiveAudioSource> previous_progressive_audio_source;
+    {
+        const juce::ScopedLock lock(songRenderSessionLock);
+        previous_progressive_audio_source = std::move(progressiveAudioSource);
+    }
+
+    audioTransportSource->stop();
+    audioTransportSource->setSource(nullptr);
+    audioFormatReaderSource.reset();
+    memoryAudioSource.reset();
+}
+
 void AudioPluginAudioProcessor::resetAudioThumbnail()
 {
     audioThumbnail->clear();
 
     juce::Uuid uuid;
+    const juce::ScopedLock lock(audioDataForAudioThumbnailLock);
     audioThumbnail->setSource(&audioDataForAudioThumbnail->audioBuffer, audioDataForAudioThumbnail->sampleRate, uuid.hash());
 }
 
@@ -432,42 +543,70 @@ void AudioPluginAudioProcessor::updatePlayerState()
 }
 
 //==============================================================================
-void AudioPluginAudioProcessor::requestSynthesis(juce::int64 speakerId, const juce::String& audio_query_json)
+void AudioPluginAudioProcessor::requestSynthesis(juce::int64 /*speakerId*/, const juce::String& audio_query_json)
 {
-    //const auto result = voicevoxClient->loadModel(speakerId);
-    //if (result.failed())
-    //{
-    //    juce::Logger::outputDebugString(result.getErrorMessage());
-    //}
+    const auto normalized_audio_query = AudioQueryJson::normalize(audio_query_json);
+    if (!normalized_audio_query.has_value())
+    {
+        juce::Logger::outputDebugString("[AudioPluginAudioProcessor] not an AudioQuery, nothing to synthesize");
+        return;
+    }
+
+    // Latest wins: whatever this processor requested before is no longer needed.
+    const auto cancellation_token = voicevoxRequestQueue->supersedePreviousRequests();
+
+    cctn::VoicevoxEngineRequest request;
+    request.requestId = juce::Uuid();
+    request.speakerId = voicevoxMapSpeakerIdentifierToSpeakerId[editorState.getProperty("VoicevoxEngine_SelectedTalkSpeakerIdentifier").toString()];
+    request.processType = cctn::VoicevoxEngineProcessType::kTalk;
 
-    //juce::var json_parsed = juce::JSON::parse(audio_query_json);
-    //const auto audio_query_json_conv = juce::JSON::toString(json_parsed, true);
+    synthesisRequestRouter->submitSynthesis(request, normalized_audio_query.value(),
+        [this](const cctn::VoicevoxEngineArtefact& artefact) {
+            juce::Logger::outputDebugString(artefact.requestId.toString());
+            this->synthesisRequestRouter->logStatistics();
+
+            if (const auto audio_buffer_info = WavAudioCodec::decodeArtefact(artefact))
+            {
+                this->loadVoicevoxEngineAudioBufferInfo(audio_buffer_info.value());
+            }
+            else
+            {
+                this->clearAudioFileHandle();
+            }
 
-    //auto memory_wav = voicevoxClient->synthesis(speakerId, audio_query_json_conv);
+            callAsyncWhileAlive(
+                [this] {
+                    editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(false), nullptr);
+                });
+        },
+        cancellation_token);
 
-    //if (memory_wav.has_value())
-    //{
-    //    loadAudioFileStream(std::make_unique<juce::MemoryInputStream>(memory_wav.value(), true));
-    //}
+    editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(true), nullptr);
 }
 
 void AudioPluginAudioProcessor::requestTextToSpeech(juce::int64 speakerId, const juce::String& text)
 {
+    // Latest wins: whatever this processor requested before is no longer needed.
+    const auto cancellation_token = voicevoxRequestQueue->supersedePreviousRequests();
+
     cctn::VoicevoxEngineRequest request;
     request.requestId = juce::Uuid();
     request.speakerId = voicevoxMapSpeakerIdentifierToSpeakerId[editorState.getProperty("VoicevoxEngine_SelectedTalkSpeakerIdentifier").toString()];
     request.text = text;
     request.processType = cctn::VoicevoxEngineProcessType::kTalk;
 
-    voicevoxEngine->requestAsync(request,
+    requestEngineAsync(request,
         [this](const cctn::VoicevoxEngineArtefact& artefact) {
             juce::Logger::outputDebugString(artefact.requestId.toString());
+            // A single request is the whole session here.
+            this->synthesisRequestRouter->logStatistics();
 
-            if (artefact.wavBinary.has_value())
+            // Decoded once into float samples, which playback and the thumbnail then share.
+            if (const auto audio_buffer_info = WavAudioCodec::decodeArtefact(artefact))
             {
-                this->loadAudioFileStream(std::make_unique<juce::MemoryInputStream>(artefact.wavBinary.value(), true));
+                this->loadVoicevoxEngineAudioBufferInfo(audio_buffer_info.value());
 
-                juce::MessageManager::callAsync(
+                callAsyncWhileAlive(
                     [this] {
                         editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(false), nullptr);
                     });
@@ -476,18 +615,22 @@ void AudioPluginAudioProcessor::requestTextToSpeech(juce::int64 speakerId, const
             {
                 this->clearAudioFileHandle();
 
-                juce::MessageManager::callAsync(
+                callAsyncWhileAlive(
                     [this] {
                         editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(false), nullptr);
                     });
             }
-        });
+        },
+        cancellation_token);
 
     editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(true), nullptr);
 }
 
 void AudioPluginAudioProcessor::requestHumming(juce::int64 /*speakerId*/, const juce::String& text)
 {
+    // Latest wins: whatever this processor requested before is no longer needed.
+    const auto cancellation_token = voicevoxRequestQueue->supersedePreviousRequests();
+
     cctn::VoicevoxEngineRequest request;
     request.requestId = juce::Uuid();
     request.speakerId = voicevoxMapSpeakerIdentifierToSpeakerId[editorState.getProperty("VoicevoxEngine_SelectedHummingSpeakerIdentifier").toString()];
@@ -495,15 +638,17 @@ void AudioPluginAudioProcessor::requestHumming(juce::int64 /*speakerId*/, const
     request.sampleRate = 24000;
     request.processType = cctn::VoicevoxEngineProcessType::kHumming;
 
-    voicevoxEngine->requestAsync(request,
+    requestEngineAsync(request,
         [this](const cctn::VoicevoxEngineArtefact& artefact) {
             juce::Logger::outputDebugString(artefact.requestId.toString());
+            // A single request is the whole session here.
+            this->synthesisRequestRouter->logStatistics();
 
             if (artefact.audioBufferInfo.has_value())
             {
                 this->loadVoicevoxEngineAudioBufferInfo(artefact.audioBufferInfo.value());
 
-                juce::MessageManager::callAsync(
+                callAsyncWhileAlive(
                     [this] {
                         editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(false), nullptr);
                     });
@@ -512,29 +657,326 @@ void AudioPluginAudioProcessor::requestHumming(juce::int64 /*speakerId*/, const
             {
                 this->clearAudioFileHandle();
                 
-                juce::MessageManager::callAsync(
+                callAsyncWhileAlive(
                     [this] {
                         editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(false), nullptr);
                     });
             }
-        });
+        },
+        cancellation_token);
 
     editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(true), nullptr);
 }
 
-void AudioPluginAudioProcessor::requestSongWithSongEditorDocument(juce::int64 speakerId_unused)
+void AudioPluginAudioProcessor::requestSongWithSongEditorDocument(juce::int64 /*speakerId_unused*/)
 {
     cctn::song::VoicevoxTranspileTarget transpiler;
     const juce::String score_json = transpiler.transpile(*currentSongDocument.get());
  
     juce::Logger::outputDebugString(score_json);
 
-    requestHumming(speakerId_unused, score_json);
+    const auto speaker_id = voicevoxMapSpeakerIdentifierToSpeakerId[editorState.getProperty("VoicevoxEngine_SelectedHummingSpeakerIdentifier").toString()];
+    const double sample_rate = 24000;
+
+    // Phrases are fingerprinted together with everything else that changes their audio.
+    const auto fingerprint_salt = juce::String(speaker_id) + "|" + juce::String(sample_rate);
+
+    // Latest wins: whatever this processor requested before is no longer needed.
+    const auto cancellation_token = voicevoxRequestQueue->supersedePreviousRequests();
+
+    auto session = std::make_shared<SongRenderSession>();
+    session->phrases = ScorePhraseSplitter().split(score_json, fingerprint_salt);
+    session->totalFrames = ScorePhraseSplitter::getTotalFrames(score_json);
+
+    std::vector<const ScorePhrase*> phrases_to_render;
+    for (const auto& phrase : session->phrases)
+    {
+        if (phraseAudioCache->contains(phrase.fingerprint))
+        {
+            continue;
+        }
+
+        // Each phrase is looked up on its own, so one rendered before is a hit however it was batched then;
+        // only the misses are batched.
+        const auto phrase_entry = synthesisCache->lookup(SynthesisCache::makeKey(ScorePhraseBatcher::makePhraseRequest(phrase, speaker_id, sample_rate)));
+        if (phrase_entry.has_value() && phrase_entry->audioBufferInfo.has_value())
+        {
+            phraseAudioCache->store(phrase.fingerprint, phrase_entry->audioBufferInfo.value());
+            continue;
+        }
+
+        phrases_to_render.push_back(&phrase);
+    }
+
+    juce::Logger::outputDebugString("[IncrementalRender] " + juce::String((int)phrases_to_render.size()) + " of " + juce::String((int)session->phrases.size()) + " phrases to render.");
+
+    {
+        const juce::ScopedLock lock(songRenderSessionLock);
+        currentSongRenderSession = session;
+    }
+
+    session->numPhrasesPending = (int)phrases_to_render.size();
+
+    if (phrases_to_render.empty())
+    {
+        completeSongRenderSession(session);
+        return;
+    }
+
+    // The previews of this session play through a fresh progressive source, attached once the start of the score is ready.
+    unloadTransportSource();
+    {
+        const juce::ScopedLock lock(songRenderSessionLock);
+        progressiveAudioSource = std::make_unique<ProgressiveAudioSource>(2);
+    }
+
+    // Pending phrases render a few at a time in one request, but in at least as many requests as can run at once.
+    const auto batches = ScorePhraseBatcher().makeBatches(phrases_to_render, voicevoxEnginePool.getScheduler().getCoreBudget());
+
+    juce::Logger::outputDebugString("[IncrementalRender] " + juce::String((int)batches.size()) + " batches.");
+
+    for (const auto& batch : batches)
+    {
+        std::vector<ScorePhrase> batch_phrases;
+        for (const auto phrase_idx : batch.phraseIndices)
+        {
+            batch_phrases.push_back(*phrases_to_render[(size_t)phrase_idx]);
+        }
+
+        cctn::VoicevoxEngineRequest request;
+        request.requestId = juce::Uuid();
+        request.speakerId = speaker_id;
+        request.scoreJson = batch.scoreJson;
+        request.sampleRate = sample_rate;
+        request.processType = cctn::VoicevoxEngineProcessType::kHumming;
+
+        requestEngineAsync(request,
+            [this, session, batch, batch_phrases, speaker_id, sample_rate](const cctn::VoicevoxEngineArtefact& artefact) {
+                if (artefact.audioBufferInfo.has_value())
+                {
+                    for (int phrase_idx = 0; phrase_idx < (int)batch_phrases.size(); phrase_idx++)
+                    {
+                        const auto& phrase = batch_phrases[(size_t)phrase_idx];
+                        if (const auto phrase_audio = ScorePhraseBatcher::extractPhraseAudio(batch, phrase_idx, phrase, artefact.audioBufferInfo.value()))
+                        {
+                            phraseAudioCache->store(phrase.fingerprint, phrase_audio.value());
+
+                            // Stored per phrase, for the lookups before batching; the batch's render time is not split between its phrases.
+                            SynthesisCache::Entry phrase_entry;
+                            phrase_entry.audioBufferInfo = phrase_audio.value();
+                            synthesisCache->store(SynthesisCache::makeKey(ScorePhraseBatcher::makePhraseRequest(phrase, speaker_id, sample_rate)), phrase_entry);
+                        }
+                    }
+                }
+
+                if ((session->numPhrasesPending -= (int)batch_phrases.size()) == 0)
+                {
+                    this->completeSongRenderSession(session);
+                }
+                else
+                {
+                    this->previewSongRenderSession(session);
+                }
+            },
+            cancellation_token,
+            RequestPriority::kBackground,
+            juce::jmax(0.0, batch_phrases.front().startFrame / ScorePhraseSplitter::kFramesPerSecond));
+    }
+
+    editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(true), nullptr);
+}
+
+void AudioPluginAudioProcessor::previewSongRenderSession(const std::shared_ptr<SongRenderSession>& session)
+{
+    // Phrases complete on several queue workers at once, so previews are serialized with the final load.
+    const juce::ScopedLock lock(songRenderSessionLock);
+    if (session != currentSongRenderSession)
+    {
+        return;
+    }
+
+    // Finished phrases become playable right away; the ones still rendering stay silent.
+    const auto stitched_audio = phraseAudioCache->stitch(session->phrases, session->totalFrames, true);
+    if (stitched_audio.has_value())
+    {
+        this->previewVoicevoxEngineAudioBufferInfo(stitched_audio.value());
+        this->appendSongPreviewAudio(session, stitched_audio.value());
+    }
+}
+
+void AudioPluginAudioProcessor::appendSongPreviewAudio(const std::shared_ptr<SongRenderSession>& session, const cctn::AudioBufferInfo& stitchedAudio)
+{
+    // Called under songRenderSessionLock, which makes this the progressive source's single writer.
+    if (progressiveAudioSource == nullptr || stitchedAudio.sampleRate <= 0.0)
+    {
+        return;
+    }
+
+    // Audio before the first phrase still rendering no longer changes, so that part is appended
+    // for the transport; phrases are rendered roughly in timeline order, so it keeps growing.
+    int first_pending_frame = std::numeric_limits<int>::max();
+    for (const auto& phrase : session->phrases)
+    {
+        if (!phraseAudioCache->contains(phrase.fingerprint))
+        {
+            first_pending_frame = juce::jmin(first_pending_frame, phrase.startFrame);
+        }
+    }
+
+    const auto num_stitched_samples = stitchedAudio.audioBuffer.getNumSamples();
+    const auto num_final_samples = first_pending_frame == std::numeric_limits<int>::max()
+                                       ? num_stitched_samples
+                                       : juce::jlimit(0, num_stitched_samples, juce::roundToInt(first_pending_frame * stitchedAudio.sampleRate / ScorePhraseSplitter::kFramesPerSecond));
+
+    const auto num_samples_written = (int)progressiveAudioSource->getNumSamplesWritten();
+    if (num_final_samples <= num_samples_written)
+    {
+        return;
+    }
+
+    progressiveAudioSource->appendSamples(stitchedAudio.audioBuffer, num_samples_written, num_final_samples - num_samples_written);
+
+    if (num_samples_written > 0)
+    {
+        return;
+    }
+
+    // The transport is only ever changed on the message thread; by then the session may have been completed or superseded.
+    callAsyncWhileAlive(
+        [this, session, sample_rate = stitchedAudio.sampleRate] {
+            {
+                const juce::ScopedLock lock(songRenderSessionLock);
+                if (session != currentSongRenderSession || progressiveAudioSource == nullptr)
+                {
+                    return;
+                }
+
+                // No read-ahead buffering, the source holds its position while later phrases are rendered.
+                audioTransportSource->setSource(progressiveAudioSource.get(),
+                    0,
+                    nullptr,
+                    sample_rate,
+                    2);
+            }
+
+            this->updatePlayerState();
+        });
+}
+
+void AudioPluginAudioProcessor::completeSongRenderSession(const std::shared_ptr<SongRenderSession>& session)
+{
+    const juce::ScopedLock lock(songRenderSessionLock);
+    if (session != currentSongRenderSession)
+    {
+        return;
+    }
+
+    currentSongRenderSession.reset();
+    synthesisRequestRouter->logStatistics();
+
+    const auto stitched_audio = phraseAudioCache->stitch(session->phrases, session->totalFrames);
+    phraseAudioCache->retainOnly(session->phrases);
+
+    if (stitched_audio.has_value())
+    {
+        this->loadVoicevoxEngineAudioBufferInfo(stitched_audio.value());
+    }
+    else
+    {
+        this->clearAudioFileHandle();
+    }
+
+    callAsyncWhileAlive(
+        [this] {
+            editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(false), nullptr);
+        });
+}
+
+void AudioPluginAudioProcessor::requestEngineAsync(const cctn::VoicevoxEngineRequest& request, std::function<void(const cctn::VoicevoxEngineArtefact&)> callback, CancellationTokenPtr cancellationToken,
+                                                   RequestPriority priority, std::optional<double> timelinePositionInSeconds)
+{
+    synthesisRequestRouter->submit(request, std::move(callback), std::move(cancellationToken), priority, timelinePositionInSeconds);
+}
+
+void AudioPluginAudioProcessor::callAsyncWhileAlive(std::function<void()> function)
+{
+    juce::MessageManager::callAsync(
+        [weak_reference = juce::WeakReference<AudioPluginAudioProcessor>(this), function = std::move(function)] {
+            if (weak_reference != nullptr)
+            {
+                function();
+            }
+        });
+}
+
+void AudioPluginAudioProcessor::voicevoxEnginePoolMetadataAvailable()
+{
+    callAsyncWhileAlive(
+        [this] {
+            this->handleVoicevoxEngineMetadataAvailable();
+        });
+}
+
+void AudioPluginAudioProcessor::voicevoxEnginePoolReady()
+{
+    callAsyncWhileAlive(
+        [this] {
+            this->handleVoicevoxEngineReady();
+        });
+}
+
+void AudioPluginAudioProcessor::handleVoicevoxEngineMetadataAvailable()
+{
+    if (synthesisDaemonClient != nullptr)
+    {
+        const auto daemon_metadata = synthesisDaemonClient->getMetadata().value_or(SynthesisDaemonProtocol::Metadata());
+        voicevoxMapSpeakerIdentifierToSpeakerId = daemon_metadata.speakerIdentifierToSpeakerId;
+        voicevoxTalkSpeakerIdentifierList = daemon_metadata.talkSpeakerIdentifierList;
+        voicevoxHummingSpeakerIdentifierList = daemon_metadata.hummingSpeakerIdentifierList;
+    }
+    else
+    {
+        voicevoxMapSpeakerIdentifierToSpeakerId = voicevoxEnginePool->getSpeakerIdentifierToSpeakerIdMap();
+        voicevoxTalkSpeakerIdentifierList = voicevoxEnginePool->getTalkSpeakerIdentifierList();
+        voicevoxHummingSpeakerIdentifierList = voicevoxEnginePool->getHummingSpeakerIdentifierList();
+    }
+
+    // Rendered audio on disk is only valid for the models, their variant and the dictionary it was rendered with.
+    const auto model_variant = VoicevoxModelVariants::toString(voicevoxEnginePool->getSettings().modelVariant);
+    const auto model_version = juce::String::toHexString((getMetaJsonStringify() + model_variant).hashCode64());
+    synthesisCache->setModelVersion(model_version);
+    audioQueryCache->setModelVersion(model_version);
+
+    juce::Logger::outputDebugString(this->getMetaJsonStringify());
+
+    editorState.setProperty("VoicevoxEngine_HasSpeakerListUpdated", juce::var(true), nullptr);
+}
+
+void AudioPluginAudioProcessor::handleVoicevoxEngineReady()
+{
+    if (voicevoxTalkSpeakerIdentifierList.isEmpty() && voicevoxHummingSpeakerIdentifierList.isEmpty())
+    {
+        handleVoicevoxEngineMetadataAvailable();
+    }
+
+    editorState.setProperty("VoicevoxEngine_IsReady", juce::var(true), nullptr);
 }
 
 juce::String AudioPluginAudioProcessor::getMetaJsonStringify()
 {
-    return juce::JSON::toString(voicevoxEngine->getMetaJson());
+    if (synthesisDaemonClient != nullptr)
+    {
+        const auto daemon_metadata = synthesisDaemonClient->getMetadata();
+        return daemon_metadata.has_value() ? juce::JSON::toString(daemon_metadata->metaJson) : juce::String("{}");
+    }
+
+    // Reading the metadata before it is available would block until an engine has started.
+    if (!voicevoxEnginePool->hasMetadata())
+    {
+        return "{}";
+    }
+
+    return juce::JSON::toString(voicevoxEnginePool->getMetaJson());
 }
 
 //==============================================================================
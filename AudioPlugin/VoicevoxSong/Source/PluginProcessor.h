@@ -5,12 +5,24 @@
 #include <voicevox_juce_extra/voicevox_juce_extra.h>
 #include <cocotone_song_editor_basics/cocotone_song_editor_basics.h>
 #include "SpinLockedPositionInfo.h"
+#include "Cache/AudioQueryCache.h"
+#include "Cache/SynthesisCache.h"
+#include "Engine/SharedVoicevoxEnginePool.h"
+#include "Engine/VoicevoxRequestQueue.h"
+#include "Engine/SynthesisRequestRouter.h"
+#include "Daemon/SynthesisDaemonClient.h"
+#include "State/RenderedAudioRecall.h"
+#include "Score/PhraseAudioCache.h"
+#include "Score/ScorePhraseBatcher.h"
+#include "Playback/ProgressiveAudioSource.h"
+#include "Playback/SharedAudioBufferingThread.h"
 
 //==============================================================================
 class AudioPluginAudioProcessor final
     : public juce::AudioProcessor
     , private juce::ValueTree::Listener
     , private juce::ChangeListener
+    , private VoicevoxEnginePool::Listener
 {
 public:
     //==============================================================================
@@ -51,8 +63,9 @@ public:
 
     //==============================================================================
     void loadAudioFile(const juce::File& fileToLoad);
-    void loadAudioFileStream(std::unique_ptr<juce::InputStream> audioFileStream);
     void loadVoicevoxEngineAudioBufferInfo(const cctn::AudioBufferInfo& audioBufferInfo);
+    // Replaces what the host synced player and the thumbnail show; the transport plays the previews through the progressive source.
+    void previewVoicevoxEngineAudioBufferInfo(const cctn::AudioBufferInfo& audioBufferInfo);
     void clearAudioFileHandle();
 
     // Should call on juce::MessageThread
@@ -65,6 +78,7 @@ public:
     void requestHumming(juce::int64 speakerId, const juce::String& text);
     void requestSongWithSongEditorDocument(juce::int64 speakerId_unused);
     juce::String getMetaJsonStringify();
+    SynthesisCache::Statistics getSynthesisCacheStatistics() const { return synthesisCache->getStatistics(); }
 
     //==============================================================================
     juce::AudioFormatManager& getAudioFormatManager() const { return *audioFormatManager.get(); }
@@ -94,15 +108,43 @@ private:
     // juce::ValueTree::Listener
     void valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged, const juce::Identifier& propertyId) override;
 
+    // VoicevoxEnginePool::Listener
+    void voicevoxEnginePoolMetadataAvailable() override;
+    void voicevoxEnginePoolReady() override;
+
     //==============================================================================
     void updateCurrentTimeInfoFromHost(const juce::AudioPlayHead::PositionInfo& newPositionInfo);
 
+    // Called on the message thread once the speaker lists are known, possibly before an engine has started.
+    void handleVoicevoxEngineMetadataAvailable();
+    // Called on the message thread once the engine warm-up has finished.
+    void handleVoicevoxEngineReady();
+    // Runs the function on the message thread, unless the processor has been deleted by then,
+    // as when a host scanning plugins deletes it right after creating it.
+    void callAsyncWhileAlive(std::function<void()> function);
+
+    //==============================================================================
+    // Serves the request from the process-wide cache, or queues it for the engine on a miss.
+    void requestEngineAsync(const cctn::VoicevoxEngineRequest& request, std::function<void(const cctn::VoicevoxEngineArtefact&)> callback, CancellationTokenPtr cancellationToken,
+                            RequestPriority priority = RequestPriority::kInteractive, std::optional<double> timelinePositionInSeconds = std::nullopt);
+
+    //==============================================================================
+    struct SongRenderSession;
+    void previewSongRenderSession(const std::shared_ptr<SongRenderSession>& session);
+    void appendSongPreviewAudio(const std::shared_ptr<SongRenderSession>& session, const cctn::AudioBufferInfo& stitchedAudio);
+    void completeSongRenderSession(const std::shared_ptr<SongRenderSession>& session);
+    // Stops playback and detaches and deletes every source.
+    void unloadTransportSource();
+
     //==============================================================================
     // Audio
     std::unique_ptr<juce::AudioFormatManager> audioFormatManager;
-    std::unique_ptr<juce::TimeSliceThread> audioBufferingThread;
+    // Shared with the other instances of the plugin.
+    juce::SharedResourcePointer<SharedAudioBufferingThread> audioBufferingThread;
     std::unique_ptr<juce::AudioFormatReaderSource> audioFormatReaderSource;
     std::unique_ptr<juce::MemoryAudioSource> memoryAudioSource;
+    // Previews of the session being rendered; guarded by songRenderSessionLock.
+    std::unique_ptr<ProgressiveAudioSource> progressiveAudioSource;
     std::unique_ptr<juce::AudioTransportSource> audioTransportSource;
     
     // Host sync audio source player
@@ -119,19 +161,45 @@ private:
         JUCE_LEAK_DETECTOR(AudioDataForAudioThumbnail)
     };
     std::unique_ptr<AudioDataForAudioThumbnail> audioDataForAudioThumbnail;
+    // Written from the message thread and the engine callbacks, read by the host in getStateInformation.
+    juce::CriticalSection audioDataForAudioThumbnailLock;
 
     // Position info
     SpinLockedPositionInfo spinLockedLastPositionInfo;
     juce::AudioPlayHead::PositionInfo playTriggeredPositionInfo;
 
     // Voicevox Engine
-    std::unique_ptr<cctn::VoicevoxEngine> voicevoxEngine;
+    // Shared with the other instances of the plugin; the request queue stays per instance.
+    SharedVoicevoxEnginePool::Reference voicevoxEnginePool;
+    juce::SharedResourcePointer<SynthesisCache> synthesisCache;
+    juce::SharedResourcePointer<AudioQueryCache> audioQueryCache;
+    std::unique_ptr<VoicevoxRequestQueue> voicevoxRequestQueue;
+    // Set when rendering through VoicevoxSynthesisDaemon; the local engines then stay stopped.
+    std::unique_ptr<SynthesisDaemonClient> synthesisDaemonClient;
+    // Created after the queue and the daemon client, destroyed before them.
+    std::unique_ptr<SynthesisRequestRouter> synthesisRequestRouter;
+
+    // Session recall
+    std::unique_ptr<RenderedAudioRecall> renderedAudioRecall;
 
     // SongEditor for Voicevox
     std::shared_ptr<cctn::song::SongDocument> currentSongDocument;
     std::shared_ptr<cctn::song::SongDocumentEditor> songDocumentEditor;
     std::unique_ptr<cctn::song::TransportEmulator> songTransportEmulator;
 
+    // Incremental phrase rendering
+    struct SongRenderSession
+    {
+        std::vector<ScorePhrase> phrases;
+        int totalFrames{ 0 };
+        std::atomic<int> numPhrasesPending{ 0 };
+
+        JUCE_LEAK_DETECTOR(SongRenderSession)
+    };
+    std::unique_ptr<PhraseAudioCache> phraseAudioCache;
+    juce::CriticalSection songRenderSessionLock;
+    std::shared_ptr<SongRenderSession> currentSongRenderSession;
+
     // State
     juce::ValueTree applicationState;
     juce::ValueTree editorState;
@@ -142,5 +210,6 @@ private:
 
     std::atomic<bool> isSyncToHostTransport;
 
+    JUCE_DECLARE_WEAK_REFERENCEABLE (AudioPluginAudioProcessor)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioPluginAudioProcessor)
 };
@@ -0,0 +1,126 @@
+#include "PhraseAudioCache.h"
+
+//==============================================================================
+PhraseAudioCache::PhraseAudioCache()
+{
+}
+
+PhraseAudioCache::~PhraseAudioCache()
+{
+}
+
+//==============================================================================
+bool PhraseAudioCache::contains(const juce::String& fingerprint) const
+{
+    const juce::ScopedLock scoped_lock(lock);
+    return phraseAudio.count(fingerprint) > 0;
+}
+
+void PhraseAudioCache::store(const juce::String& fingerprint, const cctn::AudioBufferInfo& audioBufferInfo)
+{
+    const juce::ScopedLock scoped_lock(lock);
+    phraseAudio[fingerprint] = audioBufferInfo;
+}
+
+void PhraseAudioCache::retainOnly(const std::vector<ScorePhrase>& phrases)
+{
+    std::set<juce::String> fingerprints_to_keep;
+    for (const auto& phrase : phrases)
+    {
+        fingerprints_to_keep.insert(phrase.fingerprint);
+    }
+
+    const juce::ScopedLock scoped_lock(lock);
+    for (auto it = phraseAudio.begin(); it != phraseAudio.end();)
+    {
+        if (fingerprints_to_keep.count(it->first) == 0)
+        {
+            it = phraseAudio.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+std::optional<cctn::AudioBufferInfo> PhraseAudioCache::stitch(const std::vector<ScorePhrase>& phrases, int totalFrames, bool allowMissingPhrases) const
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    if (phrases.empty())
+    {
+        return std::nullopt;
+    }
+
+    double sample_rate = 0.0;
+    int end_frame = totalFrames;
+    for (const auto& phrase : phrases)
+    {
+        end_frame = juce::jmax(end_frame, phrase.startFrame + phrase.numFrames);
+
+        const auto it = phraseAudio.find(phrase.fingerprint);
+        if (it == phraseAudio.end())
+        {
+            if (allowMissingPhrases)
+            {
+                continue;
+            }
+
+            return std::nullopt;
+        }
+
+        sample_rate = it->second.sampleRate;
+    }
+
+    if (sample_rate <= 0.0)
+    {
+        return std::nullopt;
+    }
+
+    const double samples_per_frame = sample_rate / ScorePhraseSplitter::kFramesPerSecond;
+
+    cctn::AudioBufferInfo stitched;
+    stitched.sampleRate = sample_rate;
+    stitched.audioBuffer.setSize(1, juce::roundToInt(end_frame * samples_per_frame));
+    stitched.audioBuffer.clear();
+
+    juce::AudioBuffer<float> faded_buffer;
+    for (const auto& phrase : phrases)
+    {
+        const auto it = phraseAudio.find(phrase.fingerprint);
+        if (it == phraseAudio.end() || it->second.audioBuffer.getNumSamples() == 0)
+        {
+            continue;
+        }
+
+        // Padding rests of neighbouring phrases overlap, so fading each phrase in and out
+        // over its padding and mixing them gives a crossfade across the gap.
+        faded_buffer.makeCopyOf(it->second.audioBuffer);
+        const int num_phrase_samples = faded_buffer.getNumSamples();
+        const int num_fade_in_samples = juce::jmin(num_phrase_samples / 2, juce::roundToInt(phrase.leadingRestFrames * samples_per_frame));
+        const int num_fade_out_samples = juce::jmin(num_phrase_samples / 2, juce::roundToInt(phrase.trailingRestFrames * samples_per_frame));
+
+        if (num_fade_in_samples > 0)
+        {
+            faded_buffer.applyGainRamp(0, 0, num_fade_in_samples, 0.0f, 1.0f);
+        }
+
+        if (num_fade_out_samples > 0)
+        {
+            faded_buffer.applyGainRamp(0, num_phrase_samples - num_fade_out_samples, num_fade_out_samples, 1.0f, 0.0f);
+        }
+
+        const int dest_start_sample = juce::roundToInt(phrase.startFrame * samples_per_frame);
+        const int source_start_sample = juce::jmax(0, -dest_start_sample);
+        const int num_samples = juce::jmin(num_phrase_samples - source_start_sample,
+                                           stitched.audioBuffer.getNumSamples() - juce::jmax(0, dest_start_sample));
+
+        if (num_samples > 0)
+        {
+            stitched.audioBuffer.addFrom(0, juce::jmax(0, dest_start_sample), faded_buffer, 0, source_start_sample, num_samples);
+        }
+    }
+
+    return stitched;
+}
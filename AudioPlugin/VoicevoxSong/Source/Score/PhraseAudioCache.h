@@ -0,0 +1,39 @@
+#pragma once
+
+#include <voicevox_juce_extra/voicevox_juce_extra.h>
+#include "Score/ScorePhraseSplitter.h"
+
+//==============================================================================
+// PhraseAudioCache
+//
+// Keeps the rendered audio of each score phrase by fingerprint so that an edit
+// only re-renders the phrases whose notes changed. Accessed from the message
+// thread and from engine callbacks.
+//==============================================================================
+class PhraseAudioCache final
+{
+public:
+    //==============================================================================
+    PhraseAudioCache();
+    ~PhraseAudioCache();
+
+    //==============================================================================
+    bool contains(const juce::String& fingerprint) const;
+    void store(const juce::String& fingerprint, const cctn::AudioBufferInfo& audioBufferInfo);
+
+    // Drops the audio of phrases which are no longer part of the score.
+    void retainOnly(const std::vector<ScorePhrase>& phrases);
+
+    // Places the audio of every phrase at its position in the score, crossfading
+    // neighbouring phrases over their padding rests.
+    // Returns nullopt while any phrase has not been rendered yet, unless missing
+    // phrases are allowed, in which case they are left silent.
+    std::optional<cctn::AudioBufferInfo> stitch(const std::vector<ScorePhrase>& phrases, int totalFrames, bool allowMissingPhrases = false) const;
+
+private:
+    //==============================================================================
+    mutable juce::CriticalSection lock;
+    std::map<juce::String, cctn::AudioBufferInfo> phraseAudio;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhraseAudioCache)
+};
@@ -0,0 +1,17 @@
+#include "SongDocumentArchive.h"
+
+//==============================================================================
+juce::String SongDocumentArchive::write(const cctn::song::SongDocument& document)
+{
+    return cctn::song::SongDocumentSerializer().serialize(document);
+}
+
+std::shared_ptr<cctn::song::SongDocument> SongDocumentArchive::read(const juce::String& documentText)
+{
+    if (documentText.isEmpty())
+    {
+        return nullptr;
+    }
+
+    return cctn::song::SongDocumentSerializer().deserialize(documentText);
+}
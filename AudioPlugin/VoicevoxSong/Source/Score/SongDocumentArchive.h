@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cocotone_song_editor_basics/cocotone_song_editor_basics.h>
+#include <cocotone_song_editor_formats/cocotone_song_editor_formats.h>
+
+//==============================================================================
+// SongDocumentArchive
+//
+// The Song document as stored in the plugin state, written by the
+// cocotone_song_editor_formats serializer. Unlike the VOICEVOX score it keeps
+// tempo, time signature and the notes' musical positions, so the recalled
+// document is the one the user edited.
+// - The VOICEVOX score is derived from the document again when rendering.
+//==============================================================================
+class SongDocumentArchive final
+{
+public:
+    //==============================================================================
+    static juce::String write(const cctn::song::SongDocument& document);
+
+    // nullptr when the text is not a document.
+    static std::shared_ptr<cctn::song::SongDocument> read(const juce::String& documentText);
+
+private:
+    SongDocumentArchive() = delete;
+};
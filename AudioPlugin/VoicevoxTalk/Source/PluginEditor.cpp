@@ -1,6 +1,7 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include "View/JsonTreeItem.h"
+#include "Engine/AudioQueryJson.h"
 
 //==============================================================================
 AudioPluginAudioProcessorEditor::AudioPluginAudioProcessorEditor (AudioPluginAudioProcessor& p)
@@ -58,6 +59,15 @@ AudioPluginAudioProcessorEditor::AudioPluginAudioProcessorEditor (AudioPluginAud
     textEditor = std::make_unique<juce::TextEditor>();
     textEditor->setMultiLine(true);
     textEditor->setFont(textEditor->getFont().withPointHeight(15));
+    textEditor->setText(processorRef.getEditorState().getProperty("VoicevoxEngine_TalkText").toString(), false);
+    textEditor->onTextChange = [safe_this = juce::Component::SafePointer(this)] {
+        if (safe_this.getComponent() == nullptr)
+        {
+            return;
+        }
+
+        safe_this->processorRef.getEditorState().setProperty("VoicevoxEngine_TalkText", safe_this->textEditor->getText(), nullptr);
+        };
     addAndMakeVisible(textEditor.get());
     comboboxTalkSpeakerChoice = std::make_unique<juce::ComboBox>();
     comboboxTalkSpeakerChoice->onChange =
@@ -72,6 +82,20 @@ AudioPluginAudioProcessorEditor::AudioPluginAudioProcessorEditor (AudioPluginAud
         };
     addAndMakeVisible(comboboxTalkSpeakerChoice.get());
 
+    toggleStreaming = std::make_unique<juce::ToggleButton>();
+    toggleStreaming->setButtonText("Streaming");
+    toggleStreaming->getToggleStateValue().referTo(processorRef.getEditorState().getPropertyAsValue("VoicevoxEngine_IsStreamingEnabled", nullptr));
+    addAndMakeVisible(toggleStreaming.get());
+
+    toggleEmbedRenderedAudio = std::make_unique<juce::ToggleButton>();
+    toggleEmbedRenderedAudio->setButtonText("Embed audio");
+    toggleEmbedRenderedAudio->getToggleStateValue().referTo(processorRef.getEditorState().getPropertyAsValue("State_EmbedRenderedAudio", nullptr));
+    addAndMakeVisible(toggleEmbedRenderedAudio.get());
+
+    labelRenderLatency = std::make_unique<juce::Label>();
+    labelRenderLatency->setFont(juce::FontOptions(juce::Font::getDefaultMonospacedFontName(), 13.0f, juce::Font::plain));
+    addAndMakeVisible(labelRenderLatency.get());
+
     buttonInvokeTalk = std::make_unique<juce::TextButton>();
     buttonInvokeTalk->setButtonText(
         juce::CharPointer_UTF8 ("\xe3\x81\x97\xe3\x82\x83\xe3\x81\xb9\xe3\x82\x8b\xe3\x82\x88")
@@ -84,6 +108,14 @@ AudioPluginAudioProcessorEditor::AudioPluginAudioProcessorEditor (AudioPluginAud
 
         const auto speaker_id = (int)safe_this->valueSpeakerId.getValue();
         const auto text = safe_this->textEditor->getText();
+
+        // An AudioQuery pasted from elsewhere keeps its tuned prosody.
+        if (AudioQueryJson::isAudioQuery(text))
+        {
+            safe_this->processorRef.requestSynthesis(speaker_id, text);
+            return;
+        }
+
         safe_this->processorRef.requestTextToSpeech(speaker_id, text);
         };
     addAndMakeVisible(buttonInvokeTalk.get());
@@ -157,6 +189,15 @@ AudioPluginAudioProcessorEditor::AudioPluginAudioProcessorEditor (AudioPluginAud
     valueIsVoicevoxEngineHasSpeakerListUpdated.referTo(processorRef.getEditorState(), "VoicevoxEngine_HasSpeakerListUpdated", nullptr);
     valueIsVoicevoxEngineHasSpeakerListUpdated.forceUpdateOfCachedValue();
 
+    valueIsVoicevoxEngineReady.referTo(processorRef.getEditorState(), "VoicevoxEngine_IsReady", nullptr);
+    valueIsVoicevoxEngineReady.forceUpdateOfCachedValue();
+
+    valueLastTimeToFirstAudioMs.referTo(processorRef.getEditorState(), "VoicevoxEngine_LastTimeToFirstAudioMs", nullptr);
+    valueLastTimeToFirstAudioMs.forceUpdateOfCachedValue();
+
+    valueLastTotalLatencyMs.referTo(processorRef.getEditorState(), "VoicevoxEngine_LastTotalLatencyMs", nullptr);
+    valueLastTotalLatencyMs.forceUpdateOfCachedValue();
+
     // Initial update
     updateView(true);
 
@@ -195,7 +236,13 @@ void AudioPluginAudioProcessorEditor::resized()
             auto action_talk_pane = action_select_pane;
             {
                 buttonInvokeTalk->setBounds(action_talk_pane.removeFromBottom(80).reduced(8));
-                comboboxTalkSpeakerChoice->setBounds(action_talk_pane.removeFromBottom(80).reduced(8));
+
+                auto option_pane = action_talk_pane.removeFromBottom(80);
+                auto toggle_pane = option_pane.removeFromRight(160);
+                toggleStreaming->setBounds(toggle_pane.removeFromTop(40).reduced(8, 4));
+                toggleEmbedRenderedAudio->setBounds(toggle_pane.reduced(8, 4));
+                comboboxTalkSpeakerChoice->setBounds(option_pane.removeFromTop(40).reduced(8, 4));
+                labelRenderLatency->setBounds(option_pane.reduced(8, 0));
             }
         }
 
@@ -222,6 +269,28 @@ void AudioPluginAudioProcessorEditor::valueTreePropertyChanged(juce::ValueTree&
             should_update_view = true;
         }
 
+        if (propertyId.toString() == "VoicevoxEngine_TalkText")
+        {
+            const auto restored_text = processorRef.getEditorState().getProperty(propertyId).toString();
+            if (textEditor->getText() != restored_text)
+            {
+                textEditor->setText(restored_text, false);
+            }
+        }
+
+        if (propertyId == valueLastTimeToFirstAudioMs.getPropertyID() || propertyId == valueLastTotalLatencyMs.getPropertyID())
+        {
+            valueLastTimeToFirstAudioMs.forceUpdateOfCachedValue();
+            valueLastTotalLatencyMs.forceUpdateOfCachedValue();
+            updateRenderLatencyDisplay();
+        }
+
+        if (propertyId == valueIsVoicevoxEngineReady.getPropertyID())
+        {
+            valueIsVoicevoxEngineReady.forceUpdateOfCachedValue();
+            should_update_view = true;
+        }
+
         if (propertyId == valueIsVoicevoxEngineHasSpeakerListUpdated.getPropertyID())
         {
             valueIsVoicevoxEngineHasSpeakerListUpdated.forceUpdateOfCachedValue();
@@ -271,6 +340,11 @@ void AudioPluginAudioProcessorEditor::updateView(bool isInitial)
 {
     progressPanel->setVisible(valueIsVoicevoxEngineTaskRunning);
 
+    // Requests are accepted before the engine is ready, but would wait for it to start.
+    buttonInvokeTalk->setEnabled(valueIsVoicevoxEngineReady);
+    buttonInvokeHumming->setEnabled(valueIsVoicevoxEngineReady);
+    updateRenderLatencyDisplay();
+
     if (isInitial)
     {
         {
@@ -291,6 +365,19 @@ void AudioPluginAudioProcessorEditor::updateView(bool isInitial)
     }
 }
 
+void AudioPluginAudioProcessorEditor::updateRenderLatencyDisplay()
+{
+    if (!valueIsVoicevoxEngineReady.get())
+    {
+        labelRenderLatency->setText("Starting engine...", juce::dontSendNotification);
+        return;
+    }
+
+    labelRenderLatency->setText("TTFA " + juce::String(valueLastTimeToFirstAudioMs.get(), 0) + " ms / "
+                                + juce::String(valueLastTotalLatencyMs.get(), 0) + " ms",
+                                juce::dontSendNotification);
+}
+
  //==============================================================================
 // quick-and-dirty function to format a timecode string
 juce::String timeToTimecodeString (double seconds)
@@ -35,6 +35,7 @@ private:
 
     //==============================================================================
     void updateView(bool isInitial);
+    void updateRenderLatencyDisplay();
     void updateTimecodeDisplay (const juce::AudioPlayHead::PositionInfo& positionInfo);
 
     //==============================================================================
@@ -53,6 +54,9 @@ private:
     std::unique_ptr<juce::TextButton> buttonInvokeHumming;
 
     std::unique_ptr<juce::ComboBox> comboboxTalkSpeakerChoice;
+    std::unique_ptr<juce::ToggleButton> toggleStreaming;
+    std::unique_ptr<juce::ToggleButton> toggleEmbedRenderedAudio;
+    std::unique_ptr<juce::Label> labelRenderLatency;
     std::unique_ptr<juce::ComboBox> comboboxHummingSpeakerChoice;
 
     std::unique_ptr<MusicView> musicView;
@@ -62,6 +66,9 @@ private:
     std::unique_ptr<ProgressPanel> progressPanel;
     juce::CachedValue<bool> valueIsVoicevoxEngineTaskRunning;
     juce::CachedValue<bool> valueIsVoicevoxEngineHasSpeakerListUpdated;
+    juce::CachedValue<bool> valueIsVoicevoxEngineReady;
+    juce::CachedValue<double> valueLastTimeToFirstAudioMs;
+    juce::CachedValue<double> valueLastTotalLatencyMs;
 
     // SongEditor
     std::unique_ptr<juce::TextButton> buttonTransportMenu;
@@ -1,5 +1,19 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "State/PluginStateArchive.h"
+#include "Audio/WavAudioCodec.h"
+#include "Engine/AudioQueryJson.h"
+#include "Engine/SynthesisThreadPriority.h"
+#include "Text/SentenceSegmenter.h"
+
+namespace
+{
+    // Sentences longer than this are split at clause punctuation to shorten time-to-first-audio.
+    constexpr int kStreamingMaxCharactersPerSegment = 40;
+
+    // Between the sentences of one utterance, in place of the padding trimmed on either side.
+    constexpr double kSentencePauseInSeconds = 0.25;
+}
 
 //==============================================================================
 AudioPluginAudioProcessor::AudioPluginAudioProcessor()
@@ -15,6 +29,9 @@ AudioPluginAudioProcessor::AudioPluginAudioProcessor()
     , applicationState("application_state")
     , isSyncToHostTransport(false)
 {
+    // Created here on the message thread, so the rendering threads only ever copy it.
+    juce::WeakReference<AudioPluginAudioProcessor> weak_reference(this);
+
     // Application state related.
     applicationState.setProperty("Player_CanPlay", juce::var(false), nullptr);
     applicationState.setProperty("Player_IsPlaying", juce::var(false), nullptr);
@@ -24,9 +41,15 @@ AudioPluginAudioProcessor::AudioPluginAudioProcessor()
     applicationState.addListener(this);
 
     editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(false), nullptr);
+    editorState.setProperty("VoicevoxEngine_IsReady", juce::var(false), nullptr);
     editorState.setProperty("VoicevoxEngine_SelectedTalkSpeakerIdentifier", juce::var(""), nullptr);
     editorState.setProperty("VoicevoxEngine_SelectedHummingSpeakerIdentifier", juce::var(""), nullptr);
     editorState.setProperty("VoicevoxEngine_HasSpeakerListUpdated", juce::var(false), nullptr);
+    editorState.setProperty("State_EmbedRenderedAudio", juce::var(false), nullptr);
+    editorState.setProperty("VoicevoxEngine_TalkText", juce::var(""), nullptr);
+    editorState.setProperty("VoicevoxEngine_IsStreamingEnabled", juce::var(true), nullptr);
+    editorState.setProperty("VoicevoxEngine_LastTimeToFirstAudioMs", juce::var(0.0), nullptr);
+    editorState.setProperty("VoicevoxEngine_LastTotalLatencyMs", juce::var(0.0), nullptr);
 
     voicevoxMapSpeakerIdentifierToSpeakerId.clear();
     voicevoxTalkSpeakerIdentifierList.clear();
@@ -36,8 +59,7 @@ AudioPluginAudioProcessor::AudioPluginAudioProcessor()
     audioFormatManager = std::make_unique<juce::AudioFormatManager>();
     audioFormatManager->registerBasicFormats();
 
-    audioBufferingThread = std::make_unique<juce::TimeSliceThread>("AudioBufferingThread");
-    audioBufferingThread->startThread();
+    sentenceDecodeThreadPool = std::make_unique<juce::ThreadPool>(1, 0, juce::Thread::Priority::low);
 
     audioTransportSource = std::make_unique<juce::AudioTransportSource>();
 
@@ -47,16 +69,63 @@ AudioPluginAudioProcessor::AudioPluginAudioProcessor()
     audioDataForAudioThumbnail = std::make_unique<AudioDataForAudioThumbnail>();
     audioDataForAudioThumbnail->audioBuffer.clear();
    
-    voicevoxEngine = std::make_unique<cctn::VoicevoxEngine>();
+    // The engine comes up in the background, independently of prepareToPlay and releaseResources.
+    if (const auto daemon_port = SynthesisDaemonClient::getPortFromEnvironment())
+    {
+        synthesisDaemonClient = std::make_unique<SynthesisDaemonClient>();
+        if (synthesisDaemonClient->connect(daemon_port.value()))
+        {
+            synthesisDaemonClient->requestMetadataAsync(
+                [this] {
+                    voicevoxEnginePoolReady();
+                });
+        }
+        else
+        {
+            juce::Logger::outputDebugString("[SynthesisDaemonClient] no daemon on port " + juce::String(daemon_port.value()) + ", rendering in process");
+            synthesisDaemonClient.reset();
+        }
+    }
+
+    voicevoxEnginePool->addListener(this);
+    if (synthesisDaemonClient == nullptr)
+    {
+        // An instance joining a pool that is already warm is ready right away. Metadata the pool
+        // reads from the cache within warmUpAsync() is notified by the pool, only metadata it
+        // already had is not.
+        const bool had_metadata = voicevoxEnginePool->hasMetadata();
+        voicevoxEnginePool->warmUpAsync();
+        if (voicevoxEnginePool->isReady())
+        {
+            voicevoxEnginePoolReady();
+        }
+        else if (had_metadata)
+        {
+            voicevoxEnginePoolMetadataAvailable();
+        }
+    }
+
+    voicevoxRequestQueue = std::make_unique<VoicevoxRequestQueue>(voicevoxEnginePool.getScheduler(), *synthesisCache, *audioQueryCache);
+    synthesisRequestRouter = std::make_unique<SynthesisRequestRouter>(*voicevoxRequestQueue, *synthesisCache, *audioQueryCache, synthesisDaemonClient.get());
 
     songTransportEmulator = std::make_unique<cctn::song::TransportEmulator>();
 
     audioTransportSource->addChangeListener(this);
+
+    renderedAudioRecall = std::make_unique<RenderedAudioRecall>();
 }
 
 AudioPluginAudioProcessor::~AudioPluginAudioProcessor()
 {
-    voicevoxEngine->shutdown();
+    renderedAudioRecall.reset();
+
+    voicevoxEnginePool->removeListener(this);
+    synthesisRequestRouter.reset();
+    synthesisDaemonClient.reset();
+    voicevoxRequestQueue.reset();
+
+    // No rendered sentence can arrive any more; waits for the ones being decoded.
+    sentenceDecodeThreadPool.reset();
 
     audioTransportSource->removeChangeListener(this);
 
@@ -137,24 +206,11 @@ void AudioPluginAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
 
     audioTransportSource->prepareToPlay(samplesPerBlock, sampleRate);
 
-    voicevoxEngine->start();
-    voicevoxMapSpeakerIdentifierToSpeakerId = voicevoxEngine->getSpeakerIdentifierToSpeakerIdMap();
-    voicevoxTalkSpeakerIdentifierList = voicevoxEngine->getTalkSpeakerIdentifierList();
-    voicevoxHummingSpeakerIdentifierList = voicevoxEngine->getHummingSpeakerIdentifierList();
-
-    editorState.setProperty("VoicevoxEngine_HasSpeakerIdUpdated", juce::var(true), nullptr);
-    
-    juce::Logger::outputDebugString(this->getMetaJsonStringify());
-
     hostSyncAudioSourcePlayer->prepareToPlay(samplesPerBlock, sampleRate);
 }
 
 void AudioPluginAudioProcessor::releaseResources()
 {
-    voicevoxEngine->stop();
-    voicevoxTalkSpeakerIdentifierList.clear();
-    voicevoxHummingSpeakerIdentifierList.clear();
-    voicevoxMapSpeakerIdentifierToSpeakerId.clear();
 
     hostSyncAudioSourcePlayer->releaseResources();
 }
@@ -254,26 +310,70 @@ juce::AudioProcessorEditor* AudioPluginAudioProcessor::createEditor()
 //==============================================================================
 void AudioPluginAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
-    juce::ignoreUnused (destData);
+    PluginStateArchive::Contents contents;
+    contents.talkText = editorState.getProperty("VoicevoxEngine_TalkText").toString();
+    contents.selectedTalkSpeakerIdentifier = editorState.getProperty("VoicevoxEngine_SelectedTalkSpeakerIdentifier").toString();
+    contents.selectedHummingSpeakerIdentifier = editorState.getProperty("VoicevoxEngine_SelectedHummingSpeakerIdentifier").toString();
+
+    // Embedding the rendered audio is opt-in, it makes the host session considerably larger.
+    contents.embedsRenderedAudio = (bool)editorState.getProperty("State_EmbedRenderedAudio");
+    if (contents.embedsRenderedAudio)
+    {
+        // Copied under the lock, compressed outside it so a render landing meanwhile is not held up.
+        juce::AudioBuffer<float> audio_buffer;
+        double sample_rate = 0.0;
+        {
+            const juce::ScopedLock lock(audioDataForAudioThumbnailLock);
+            audio_buffer.makeCopyOf(audioDataForAudioThumbnail->audioBuffer);
+            sample_rate = audioDataForAudioThumbnail->sampleRate;
+        }
+
+        contents.compressedAudio = PluginStateArchive::compressAudio(audio_buffer, sample_rate);
+    }
+
+    PluginStateArchive::write(contents, destData);
 }
 
 void AudioPluginAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
-    juce::ignoreUnused (data, sizeInBytes);
+    const auto contents = PluginStateArchive::read(data, sizeInBytes);
+    if (!contents.has_value())
+    {
+        return;
+    }
+
+    auto restore_editor_state =
+        [this, restored = contents.value()] {
+            editorState.setProperty("VoicevoxEngine_TalkText", restored.talkText, nullptr);
+            editorState.setProperty("VoicevoxEngine_SelectedTalkSpeakerIdentifier", restored.selectedTalkSpeakerIdentifier, nullptr);
+            editorState.setProperty("VoicevoxEngine_SelectedHummingSpeakerIdentifier", restored.selectedHummingSpeakerIdentifier, nullptr);
+            editorState.setProperty("State_EmbedRenderedAudio", restored.embedsRenderedAudio, nullptr);
+        };
+
+    if (juce::MessageManager::existsAndIsCurrentThread())
+    {
+        restore_editor_state();
+    }
+    else
+    {
+        callAsyncWhileAlive(restore_editor_state);
+    }
+
+    // Decoded lazily off the calling thread, the engine is not involved at all.
+    if (contents->compressedAudio.getSize() > 0)
+    {
+        renderedAudioRecall->decodeAsync(contents->compressedAudio,
+            [this](const cctn::AudioBufferInfo& audioBufferInfo) {
+                this->loadVoicevoxEngineAudioBufferInfo(audioBufferInfo);
+            });
+    }
 }
 
 //==============================================================================
 void AudioPluginAudioProcessor::loadAudioFile(const juce::File& fileToLoad)
 {
     // Unload the previous file source and delete it..
-    audioTransportSource->stop();
-    audioTransportSource->setSource(nullptr);
-    audioFormatReaderSource.reset();
+    unloadTransportSource();
 
     juce::AudioFormatReader* reader = audioFormatManager->createReaderFor(fileToLoad);
 
@@ -283,17 +383,20 @@ void AudioPluginAudioProcessor::loadAudioFile(const juce::File& fileToLoad)
 
         audioTransportSource->setSource(audioFormatReaderSource.get(),
             32768,
-            audioBufferingThread.get(),
+            &audioBufferingThread.getObject(),
             reader->sampleRate,
             2);
 
         // Update audio thumbnail
-        audioDataForAudioThumbnail->sampleRate = reader->sampleRate;
-        audioDataForAudioThumbnail->audioBuffer.clear();
-        audioDataForAudioThumbnail->audioBuffer.setSize(2, reader->lengthInSamples);
-        reader->read(&audioDataForAudioThumbnail->audioBuffer, 0, reader->lengthInSamples, 0, true, true);
+        {
+            const juce::ScopedLock lock(audioDataForAudioThumbnailLock);
+            audioDataForAudioThumbnail->sampleRate = reader->sampleRate;
+            audioDataForAudioThumbnail->audioBuffer.clear();
+            audioDataForAudioThumbnail->audioBuffer.setSize(2, reader->lengthInSamples);
+            reader->read(&audioDataForAudioThumbnail->audioBuffer, 0, reader->lengthInSamples, 0, true, true);
+        }
         
-        juce::MessageManager::callAsync(
+        callAsyncWhileAlive(
             [this] {
                 this->resetAudioThumbnail();
             });
@@ -310,45 +413,10 @@ void AudioPluginAudioProcessor::loadAudioFile(const juce::File& fileToLoad)
     }
 }
 
-void AudioPluginAudioProcessor::loadAudioFileStream(std::unique_ptr<juce::InputStream> audioFileStream)
-{
-    // Unload the previous file source and delete it..
-    audioTransportSource->stop();
-    audioTransportSource->setSource(nullptr);
-    audioFormatReaderSource.reset();
-
-    juce::AudioFormatReader* reader = audioFormatManager->createReaderFor(std::move(audioFileStream));
-
-    if (reader != nullptr)
-    {
-        audioFormatReaderSource = std::make_unique<juce::AudioFormatReaderSource>(reader, true);
-
-        audioTransportSource->setSource(audioFormatReaderSource.get(),
-            32768,
-            audioBufferingThread.get(),
-            reader->sampleRate,
-            2);
-
-        // Update audio thumbnail
-        audioDataForAudioThumbnail->sampleRate = reader->sampleRate;
-        audioDataForAudioThumbnail->audioBuffer.clear();
-        audioDataForAudioThumbnail->audioBuffer.setSize(2, reader->lengthInSamples);
-        reader->read(&audioDataForAudioThumbnail->audioBuffer, 0, reader->lengthInSamples, 0, true, true);
-
-        juce::MessageManager::callAsync(
-            [this] {
-                this->resetAudioThumbnail();
-                this->updatePlayerState();
-            });
-    }
-}
-
 void AudioPluginAudioProcessor::loadVoicevoxEngineAudioBufferInfo(const cctn::AudioBufferInfo& audioBufferInfo)
 {
     // Unload the previous file source and delete it..
-    audioTransportSource->stop();
-    audioTransportSource->setSource(nullptr);
-    memoryAudioSource.reset();
+    unloadTransportSource();
 
     juce::AudioBuffer<float> stereonized_buffer;
     stereonized_buffer.setSize(2, audioBufferInfo.audioBuffer.getNumSamples());
@@ -361,16 +429,19 @@ void AudioPluginAudioProcessor::loadVoicevoxEngineAudioBufferInfo(const cctn::Au
 
     audioTransportSource->setSource(memoryAudioSource.get(),
         32768,
-        audioBufferingThread.get(),
+        &audioBufferingThread.getObject(),
         audioBufferInfo.sampleRate,
         2);
 
     // Update audio thumbnail
-    audioDataForAudioThumbnail->sampleRate = audioBufferInfo.sampleRate;
-    audioDataForAudioThumbnail->audioBuffer.clear();
-    audioDataForAudioThumbnail->audioBuffer.makeCopyOf(stereonized_buffer, false);
+    {
+        const juce::ScopedLock lock(audioDataForAudioThumbnailLock);
+        audioDataForAudioThumbnail->sampleRate = audioBufferInfo.sampleRate;
+        audioDataForAudioThumbnail->audioBuffer.clear();
+        audioDataForAudioThumbnail->audioBuffer.makeCopyOf(stereonized_buffer, false);
+    }
 
-    juce::MessageManager::callAsync(
+    callAsyncWhileAlive(
         [this] {
             this->resetAudioThumbnail();
             this->updatePlayerState();
@@ -380,28 +451,48 @@ void AudioPluginAudioProcessor::loadVoicevoxEngineAudioBufferInfo(const cctn::Au
 void AudioPluginAudioProcessor::clearAudioFileHandle()
 {
     // Unload the previous file source and delete it..
-    audioTransportSource->stop();
-    audioTransportSource->setSource(nullptr);
-    audioFormatReaderSource.reset();
+    unloadTransportSource();
 
     hostSyncAudioSourcePlayer->clearAudioBufferToPlay();
 
     // Update audio thumbnail
-    audioDataForAudioThumbnail->sampleRate = 0.0;
-    audioDataForAudioThumbnail->audioBuffer.clear();
+    {
+        const juce::ScopedLock lock(audioDataForAudioThumbnailLock);
+        audioDataForAudioThumbnail->sampleRate = 0.0;
+        audioDataForAudioThumbnail->audioBuffer.clear();
+    }
 
-    juce::MessageManager::callAsync(
+    callAsyncWhileAlive(
         [this] {
             this->resetAudioThumbnail();
             this->updatePlayerState();
         });
 }
 
+void AudioPluginAudioProcessor::unloadTransportSource()
+{
+    {
+        // From here on no segment attaches the progressive source, so it can be detached and deleted below.
+        const juce::ScopedLock lock(streamingSessionLock);
+        currentStreamingSession.reset();
+    }
+
+    audioTransportSource->stop();
+    audioTransportSource->setSource(nullptr);
+    audioFormatReaderSource.reset();
+    memoryAudioSource.reset();
+    {
+        const juce::ScopedLock lock(streamingSessionLock);
+        progressiveAudioSource.reset();
+    }
+}
+
 void AudioPluginAudioProcessor::resetAudioThumbnail()
 {
     audioThumbnail->clear();
 
     juce::Uuid uuid;
+    const juce::ScopedLock lock(audioDataForAudioThumbnailLock);
     audioThumbnail->setSource(&audioDataForAudioThumbnail->audioBuffer, audioDataForAudioThumbnail->sampleRate, uuid.hash());
 }
 
@@ -419,62 +510,214 @@ void AudioPluginAudioProcessor::updatePlayerState()
 }
 
 //==============================================================================
-void AudioPluginAudioProcessor::requestSynthesis(juce::int64 speakerId, const juce::String& audio_query_json)
+void AudioPluginAudioProcessor::requestSynthesis(juce::int64 /*speakerId*/, const juce::String& audio_query_json)
 {
-    //const auto result = voicevoxClient->loadModel(speakerId);
-    //if (result.failed())
-    //{
-    //    juce::Logger::outputDebugString(result.getErrorMessage());
-    //}
-
-    //juce::var json_parsed = juce::JSON::parse(audio_query_json);
-    //const auto audio_query_json_conv = juce::JSON::toString(json_parsed, true);
+    const auto normalized_audio_query = AudioQueryJson::normalize(audio_query_json);
+    if (!normalized_audio_query.has_value())
+    {
+        juce::Logger::outputDebugString("[AudioPluginAudioProcessor] not an AudioQuery, nothing to synthesize");
+        return;
+    }
 
-    //auto memory_wav = voicevoxClient->synthesis(speakerId, audio_query_json_conv);
+    // The query already holds the prosody, so only the waveform is synthesized.
+    TalkScriptLine line;
+    line.speakerId = voicevoxMapSpeakerIdentifierToSpeakerId[editorState.getProperty("VoicevoxEngine_SelectedTalkSpeakerIdentifier").toString()];
+    line.audioQueryJson = normalized_audio_query.value();
 
-    //if (memory_wav.has_value())
-    //{
-    //    loadAudioFileStream(std::make_unique<juce::MemoryInputStream>(memory_wav.value(), true));
-    //}
+    renderTalkLines({ line }, nullptr, nullptr);
 }
 
 void AudioPluginAudioProcessor::requestTextToSpeech(juce::int64 speakerId, const juce::String& text)
 {
-    cctn::VoicevoxEngineRequest request;
-    request.requestId = juce::Uuid();
-    request.speakerId = voicevoxMapSpeakerIdentifierToSpeakerId[editorState.getProperty("VoicevoxEngine_SelectedTalkSpeakerIdentifier").toString()];
-    request.text = text;
-    request.processType = cctn::VoicevoxEngineProcessType::kTalk;
+    if ((bool)editorState.getProperty("VoicevoxEngine_IsStreamingEnabled"))
+    {
+        requestTextToSpeechStreaming(speakerId, text);
+        return;
+    }
 
-    voicevoxEngine->requestAsync(request,
-        [this](const cctn::VoicevoxEngineArtefact& artefact) {
-            juce::Logger::outputDebugString(artefact.requestId.toString());
+    if (text.trim().isEmpty())
+    {
+        return;
+    }
 
-            if (artefact.wavBinary.has_value())
-            {
-                this->loadAudioFileStream(std::make_unique<juce::MemoryInputStream>(artefact.wavBinary.value(), true));
+    const auto speaker_id = voicevoxMapSpeakerIdentifierToSpeakerId[editorState.getProperty("VoicevoxEngine_SelectedTalkSpeakerIdentifier").toString()];
 
-                juce::MessageManager::callAsync(
-                    [this] {
-                        editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(false), nullptr);
+    // The daemon only takes engine requests, which cannot trim the padding, so the utterance stays whole there.
+    const auto sentences = synthesisRequestRouter->isUsingDaemon() ? juce::StringArray(text) : SentenceSegmenter().split(text);
+
+    // Sentences are pipelined through the two stages and joined in order. Their padding silence
+    // is trimmed where they meet, and a fixed pause separates them instead.
+    std::vector<TalkScriptLine> lines;
+    for (int sentence_idx = 0; sentence_idx < sentences.size(); sentence_idx++)
+    {
+        const bool is_last_sentence = sentence_idx == sentences.size() - 1;
+
+        TalkScriptLine line;
+        line.speakerId = speaker_id;
+        line.text = sentences[sentence_idx];
+        line.trimsLeadingPadding = sentence_idx > 0;
+        line.trimsTrailingPadding = !is_last_sentence;
+        line.gapInSeconds = is_last_sentence ? 0.0 : kSentencePauseInSeconds;
+        lines.push_back(line);
+    }
+
+    renderTalkLines(std::move(lines), nullptr, nullptr);
+}
+
+void AudioPluginAudioProcessor::requestTalkScript(const std::vector<TalkScriptLine>& lines, TalkScript::ProgressCallback onProgress, TalkScriptFinishedCallback onFinished)
+{
+    renderTalkLines(lines, std::move(onProgress), std::move(onFinished));
+}
+
+void AudioPluginAudioProcessor::renderTalkLines(std::vector<TalkScriptLine> lines, TalkScript::ProgressCallback onProgress, TalkScriptFinishedCallback onFinished)
+{
+    if (lines.empty())
+    {
+        return;
+    }
+
+    {
+        // Supersede a streaming session that may still be running.
+        const juce::ScopedLock lock(streamingSessionLock);
+        currentStreamingSession.reset();
+    }
+
+    // Latest wins: whatever this processor requested before is no longer needed.
+    const auto cancellation_token = voicevoxRequestQueue->supersedePreviousRequests();
+
+    auto session = std::make_shared<SentenceTalkSession>();
+    session->lines = std::move(lines);
+    session->lineAudio.resize(session->lines.size());
+    session->lineTimings.resize(session->lines.size());
+    session->numSentencesPending = (int)session->lines.size();
+    session->requestedTimeMs = juce::Time::getMillisecondCounterHiRes();
+    session->onProgress = std::move(onProgress);
+    session->onFinished = std::move(onFinished);
+
+    {
+        const juce::ScopedLock lock(sentenceSessionLock);
+        currentSentenceSession = session;
+    }
+
+    editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(true), nullptr);
+
+    // All lines are queued at once and spread over every engine; unchanged lines,
+    // and lines already voiced by their speaker, are cache hits and call back right away.
+    // Locally each line runs in two stages, audio_query then synthesis. Synthesis is interactive
+    // and only the first line's query is, so a finished query is synthesized before the next
+    // query starts, and the frontend of line N+1 runs on a free worker while line N is synthesized.
+    for (int sentence_idx = 0; sentence_idx < (int)session->lines.size(); sentence_idx++)
+    {
+        const auto& line = session->lines[(size_t)sentence_idx];
+
+        cctn::VoicevoxEngineRequest request;
+        request.requestId = juce::Uuid();
+        request.speakerId = line.speakerId;
+        request.text = line.text;
+        request.processType = cctn::VoicevoxEngineProcessType::kTalk;
+
+        auto on_rendered =
+            [this, session, sentence_idx](const cctn::VoicevoxEngineArtefact& artefact) {
+                this->decodeSentenceAsync(artefact,
+                    [this, session, sentence_idx](std::optional<cctn::AudioBufferInfo> sentence_audio) {
+                        this->receiveSentence(session, sentence_idx, std::move(sentence_audio));
                     });
-            }
-            else
-            {
-                this->clearAudioFileHandle();
+            };
 
-                juce::MessageManager::callAsync(
-                    [this] {
-                        editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(false), nullptr);
+        if (line.audioQueryJson.isEmpty() && synthesisRequestRouter->isUsingDaemon())
+        {
+            requestEngineAsync(request, std::move(on_rendered), cancellation_token);
+            continue;
+        }
+
+        auto synthesize =
+            [this, request, trims_leading_padding = line.trimsLeadingPadding, trims_trailing_padding = line.trimsTrailingPadding,
+             on_rendered = std::move(on_rendered), cancellation_token](const std::optional<juce::String>& audio_query_json) {
+                if (!audio_query_json.has_value())
+                {
+                    cctn::VoicevoxEngineArtefact empty_artefact;
+                    empty_artefact.requestId = request.requestId;
+                    on_rendered(empty_artefact);
+                    return;
+                }
+
+                const auto audio_query_to_synthesize = AudioQueryJson::trimPadding(audio_query_json.value(), trims_leading_padding, trims_trailing_padding);
+                this->synthesisRequestRouter->submitSynthesis(request, audio_query_to_synthesize, on_rendered, cancellation_token);
+            };
+
+        if (line.audioQueryJson.isNotEmpty())
+        {
+            synthesize(line.audioQueryJson);
+            continue;
+        }
+
+        // Through the AudioQueryCache, so a render evicted from the SynthesisCache only pays for the waveform again.
+        synthesisRequestRouter->submitAudioQuery(request, std::move(synthesize), cancellation_token,
+                                                 sentence_idx == 0 ? RequestPriority::kInteractive : RequestPriority::kBackground);
+    }
+}
+
+void AudioPluginAudioProcessor::requestTextToSpeechStreaming(juce::int64 /*speakerId*/, const juce::String& text)
+{
+    const auto segments = SentenceSegmenter(kStreamingMaxCharactersPerSegment).split(text);
+    if (segments.isEmpty())
+    {
+        return;
+    }
+
+    {
+        // Supersede a sentence session that may still be running.
+        const juce::ScopedLock lock(sentenceSessionLock);
+        currentSentenceSession.reset();
+    }
+
+    // Latest wins: whatever this processor requested before is no longer needed.
+    const auto cancellation_token = voicevoxRequestQueue->supersedePreviousRequests();
+
+    auto session = std::make_shared<StreamingTalkSession>();
+    session->numSegments = segments.size();
+    session->requestedTimeMs = juce::Time::getMillisecondCounterHiRes();
+
+    {
+        const juce::ScopedLock lock(streamingSessionLock);
+        currentStreamingSession = session;
+
+        // Unload the previous source, the new one is attached when the first segment lands.
+        audioTransportSource->stop();
+        audioTransportSource->setSource(nullptr);
+        audioFormatReaderSource.reset();
+        memoryAudioSource.reset();
+        progressiveAudioSource = std::make_unique<ProgressiveAudioSource>(2);
+    }
+
+    const auto speaker_id = voicevoxMapSpeakerIdentifierToSpeakerId[editorState.getProperty("VoicevoxEngine_SelectedTalkSpeakerIdentifier").toString()];
+
+    for (int segment_idx = 0; segment_idx < segments.size(); segment_idx++)
+    {
+        cctn::VoicevoxEngineRequest request;
+        request.requestId = juce::Uuid();
+        request.speakerId = speaker_id;
+        request.text = segments[segment_idx];
+        request.processType = cctn::VoicevoxEngineProcessType::kTalk;
+
+        requestEngineAsync(request,
+            [this, session, segment_idx](const cctn::VoicevoxEngineArtefact& artefact) {
+                this->decodeSentenceAsync(artefact,
+                    [this, session, segment_idx](std::optional<cctn::AudioBufferInfo> segment_audio) {
+                        this->receiveStreamingSegment(session, segment_idx, std::move(segment_audio));
                     });
-            }
-        });
+            },
+            cancellation_token);
+    }
 
     editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(true), nullptr);
 }
 
 void AudioPluginAudioProcessor::requestHumming(juce::int64 speakerId, const juce::String& text)
 {
+    // Latest wins: whatever this processor requested before is no longer needed.
+    const auto cancellation_token = voicevoxRequestQueue->supersedePreviousRequests();
+
     cctn::VoicevoxEngineRequest request;
     request.requestId = juce::Uuid();
     request.speakerId = voicevoxMapSpeakerIdentifierToSpeakerId[editorState.getProperty("VoicevoxEngine_SelectedHummingSpeakerIdentifier").toString()];
@@ -483,15 +726,17 @@ void AudioPluginAudioProcessor::requestHumming(juce::int64 speakerId, const juce
     request.sampleRate = 24000;
     request.processType = cctn::VoicevoxEngineProcessType::kHumming;
 
-    voicevoxEngine->requestAsync(request,
+    requestEngineAsync(request,
         [this](const cctn::VoicevoxEngineArtefact& artefact) {
             juce::Logger::outputDebugString(artefact.requestId.toString());
+            // A single request is the whole session here.
+            this->synthesisRequestRouter->logStatistics();
 
             if (artefact.audioBufferInfo.has_value())
             {
                 this->loadVoicevoxEngineAudioBufferInfo(artefact.audioBufferInfo.value());
 
-                juce::MessageManager::callAsync(
+                callAsyncWhileAlive(
                     [this] {
                         editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(false), nullptr);
                     });
@@ -500,19 +745,335 @@ void AudioPluginAudioProcessor::requestHumming(juce::int64 speakerId, const juce
             {
                 this->clearAudioFileHandle();
                 
-                juce::MessageManager::callAsync(
+                callAsyncWhileAlive(
                     [this] {
                         editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(false), nullptr);
                     });
             }
-        });
+        },
+        cancellation_token);
 
     editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(true), nullptr);
 }
 
+void AudioPluginAudioProcessor::decodeSentenceAsync(const cctn::VoicevoxEngineArtefact& artefact, std::function<void(std::optional<cctn::AudioBufferInfo>)> onDecoded)
+{
+    // Float audio, as the daemon sends it, needs no decoding and is passed on right away.
+    if (artefact.audioBufferInfo.has_value() || !artefact.wavBinary.has_value())
+    {
+        onDecoded(artefact.audioBufferInfo);
+        return;
+    }
+
+    // The wav is copied, the artefact does not outlive the engine callback.
+    sentenceDecodeThreadPool->addJob(
+        [artefact, on_decoded = std::move(onDecoded)] {
+            SynthesisThreadPriority::applyToCurrentThread();
+
+            // Straight into float samples, once; the timeline and the thumbnail copy from that buffer.
+            on_decoded(WavAudioCodec::decodeArtefact(artefact));
+        });
+}
+
+void AudioPluginAudioProcessor::receiveStreamingSegment(const std::shared_ptr<StreamingTalkSession>& session, int segmentIndex, std::optional<cctn::AudioBufferInfo> segmentAudio)
+{
+    const juce::ScopedLock lock(streamingSessionLock);
+
+    // Drop segments of a session that has been superseded by a newer request.
+    if (session != currentStreamingSession || progressiveAudioSource == nullptr)
+    {
+        return;
+    }
+
+    // Segments are appended strictly in text order, even if the engine finishes them out of order.
+    session->receivedSegments[segmentIndex] = std::move(segmentAudio);
+
+    while (session->receivedSegments.count(session->nextSegmentIndexToAppend) > 0)
+    {
+        const auto& received_segment = session->receivedSegments[session->nextSegmentIndexToAppend];
+        if (received_segment.has_value())
+        {
+            appendStreamingAudio(session, received_segment.value());
+        }
+
+        session->receivedSegments.erase(session->nextSegmentIndexToAppend);
+        session->nextSegmentIndexToAppend++;
+    }
+
+    if (session->nextSegmentIndexToAppend < session->numSegments)
+    {
+        return;
+    }
+
+    progressiveAudioSource->markComplete();
+    if (session->numSamplesPublished < progressiveAudioSource->getNumSamplesWritten())
+    {
+        publishStreamingAudio(*session);
+    }
+
+    const auto total_latency_ms = juce::Time::getMillisecondCounterHiRes() - session->requestedTimeMs;
+    const auto time_to_first_audio_ms = session->firstAudioTimeMs > 0.0 ? session->firstAudioTimeMs - session->requestedTimeMs : total_latency_ms;
+    updateRenderLatency(time_to_first_audio_ms, total_latency_ms);
+
+    if (progressiveAudioSource->getNumSamplesWritten() == 0)
+    {
+        clearAudioFileHandle();
+    }
+
+    callAsyncWhileAlive(
+        [this] {
+            editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(false), nullptr);
+        });
+}
+
+void AudioPluginAudioProcessor::receiveSentence(const std::shared_ptr<SentenceTalkSession>& session, int sentenceIndex, std::optional<cctn::AudioBufferInfo> sentenceAudio)
+{
+    TalkScriptProgress progress;
+    {
+        const juce::ScopedLock lock(sentenceSessionLock);
+
+        // Drop sentences of a session that has been superseded by a newer request.
+        if (session != currentSentenceSession)
+        {
+            return;
+        }
+
+        const bool is_received = sentenceAudio.has_value();
+        session->lineAudio[(size_t)sentenceIndex] = std::move(sentenceAudio);
+        session->lineTimings[(size_t)sentenceIndex].renderTimeMs = juce::Time::getMillisecondCounterHiRes() - session->requestedTimeMs;
+
+        progress.lineIndex = sentenceIndex;
+        progress.numLines = (int)session->lines.size();
+        progress.numLinesFinished = progress.numLines - --session->numSentencesPending;
+        progress.succeeded = is_received;
+        progress.renderTimeMs = session->lineTimings[(size_t)sentenceIndex].renderTimeMs;
+
+        if (session->numSentencesPending == 0)
+        {
+            currentSentenceSession.reset();
+        }
+    }
+
+    // Outside the lock, the callbacks may start another request.
+    if (session->onProgress != nullptr)
+    {
+        session->onProgress(progress);
+    }
+
+    if (progress.numLinesFinished < progress.numLines)
+    {
+        return;
+    }
+
+    // Lines are joined in text order, each followed by its gap.
+    TalkScriptRenderResult result;
+    result.lineTimings = std::move(session->lineTimings);
+    result.timeline = TalkScript::assembleTimeline(session->lines, session->lineAudio, result.lineTimings);
+    result.wallTimeMs = juce::Time::getMillisecondCounterHiRes() - session->requestedTimeMs;
+
+    if (result.timeline.has_value())
+    {
+        loadVoicevoxEngineAudioBufferInfo(result.timeline.value());
+
+        // The utterance is played once complete, so the first audio is the total latency.
+        updateRenderLatency(result.wallTimeMs, result.wallTimeMs);
+    }
+    else
+    {
+        clearAudioFileHandle();
+    }
+
+    if (session->onFinished != nullptr)
+    {
+        session->onFinished(result);
+    }
+
+    callAsyncWhileAlive(
+        [this] {
+            editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(false), nullptr);
+        });
+}
+
+void AudioPluginAudioProcessor::appendStreamingAudio(const std::shared_ptr<StreamingTalkSession>& session, const cctn::AudioBufferInfo& segmentAudio)
+{
+    if (segmentAudio.audioBuffer.getNumSamples() == 0)
+    {
+        return;
+    }
+
+    const bool is_first_audio = progressiveAudioSource->getNumSamplesWritten() == 0;
+    if (is_first_audio)
+    {
+        session->sampleRate = segmentAudio.sampleRate;
+    }
+
+    // All segments come from the same speaker, so they share one sample rate.
+    jassert(session->sampleRate == segmentAudio.sampleRate);
+
+    // Only the new segment is copied; the transport reads the source as it grows.
+    progressiveAudioSource->appendSamples(segmentAudio.audioBuffer);
+
+    // Host-synced playback and the thumbnail take a copy of everything written so far, so they are
+    // only refreshed once it has doubled and when the session completes, which keeps the copying
+    // linear in the length of the utterance.
+    if (progressiveAudioSource->getNumSamplesWritten() >= session->numSamplesPublished * 2)
+    {
+        publishStreamingAudio(*session);
+    }
+
+    if (!is_first_audio)
+    {
+        return;
+    }
+
+    session->firstAudioTimeMs = juce::Time::getMillisecondCounterHiRes();
+    juce::Logger::outputDebugString("[Streaming] Time to first audio: " + juce::String(session->firstAudioTimeMs - session->requestedTimeMs, 1) + " ms");
+
+    // The transport is only ever changed on the message thread; by then the session may have been superseded.
+    callAsyncWhileAlive(
+        [this, session] {
+            {
+                const juce::ScopedLock lock(streamingSessionLock);
+                if (session != currentStreamingSession || progressiveAudioSource == nullptr)
+                {
+                    return;
+                }
+
+                // No read-ahead buffering, the source holds its position while later segments are rendered.
+                audioTransportSource->setSource(progressiveAudioSource.get(),
+                    0,
+                    nullptr,
+                    session->sampleRate,
+                    2);
+            }
+
+            this->updatePlayerState();
+
+            // Start as soon as the first segment is playable.
+            editorState.setProperty("VoicevoxEngine_IsTaskRunning", juce::var(false), nullptr);
+            applicationState.setProperty("Player_IsPlaying", juce::var(true), nullptr);
+        });
+}
+
+void AudioPluginAudioProcessor::publishStreamingAudio(StreamingTalkSession& session)
+{
+    auto written_buffer = progressiveAudioSource->createSnapshot();
+    session.numSamplesPublished = written_buffer.getNumSamples();
+
+    hostSyncAudioSourcePlayer->setAudioBufferToPlay(written_buffer, session.sampleRate);
+
+    // Update audio thumbnail
+    {
+        const juce::ScopedLock lock(audioDataForAudioThumbnailLock);
+        audioDataForAudioThumbnail->sampleRate = session.sampleRate;
+        audioDataForAudioThumbnail->audioBuffer = std::move(written_buffer);
+    }
+
+    callAsyncWhileAlive(
+        [this] {
+            this->resetAudioThumbnail();
+        });
+}
+
+void AudioPluginAudioProcessor::updateRenderLatency(double timeToFirstAudioMs, double totalLatencyMs)
+{
+    juce::Logger::outputDebugString("[Latency] Time to first audio: " + juce::String(timeToFirstAudioMs, 1) + " ms, total: " + juce::String(totalLatencyMs, 1) + " ms");
+
+    // Called once per completed talk session, which is when the synthesis statistics are worth a look.
+    synthesisRequestRouter->logStatistics();
+
+    callAsyncWhileAlive(
+        [this, timeToFirstAudioMs, totalLatencyMs] {
+            editorState.setProperty("VoicevoxEngine_LastTimeToFirstAudioMs", juce::var(timeToFirstAudioMs), nullptr);
+            editorState.setProperty("VoicevoxEngine_LastTotalLatencyMs", juce::var(totalLatencyMs), nullptr);
+        });
+}
+
+void AudioPluginAudioProcessor::requestEngineAsync(const cctn::VoicevoxEngineRequest& request, std::function<void(const cctn::VoicevoxEngineArtefact&)> callback, CancellationTokenPtr cancellationToken,
+                                                   RequestPriority priority, std::optional<double> timelinePositionInSeconds)
+{
+    synthesisRequestRouter->submit(request, std::move(callback), std::move(cancellationToken), priority, timelinePositionInSeconds);
+}
+
+void AudioPluginAudioProcessor::callAsyncWhileAlive(std::function<void()> function)
+{
+    juce::MessageManager::callAsync(
+        [weak_reference = juce::WeakReference<AudioPluginAudioProcessor>(this), function = std::move(function)] {
+            if (weak_reference != nullptr)
+            {
+                function();
+            }
+        });
+}
+
+void AudioPluginAudioProcessor::voicevoxEnginePoolMetadataAvailable()
+{
+    callAsyncWhileAlive(
+        [this] {
+            this->handleVoicevoxEngineMetadataAvailable();
+        });
+}
+
+void AudioPluginAudioProcessor::voicevoxEnginePoolReady()
+{
+    callAsyncWhileAlive(
+        [this] {
+            this->handleVoicevoxEngineReady();
+        });
+}
+
+void AudioPluginAudioProcessor::handleVoicevoxEngineMetadataAvailable()
+{
+    if (synthesisDaemonClient != nullptr)
+    {
+        const auto daemon_metadata = synthesisDaemonClient->getMetadata().value_or(SynthesisDaemonProtocol::Metadata());
+        voicevoxMapSpeakerIdentifierToSpeakerId = daemon_metadata.speakerIdentifierToSpeakerId;
+        voicevoxTalkSpeakerIdentifierList = daemon_metadata.talkSpeakerIdentifierList;
+        voicevoxHummingSpeakerIdentifierList = daemon_metadata.hummingSpeakerIdentifierList;
+    }
+    else
+    {
+        voicevoxMapSpeakerIdentifierToSpeakerId = voicevoxEnginePool->getSpeakerIdentifierToSpeakerIdMap();
+        voicevoxTalkSpeakerIdentifierList = voicevoxEnginePool->getTalkSpeakerIdentifierList();
+        voicevoxHummingSpeakerIdentifierList = voicevoxEnginePool->getHummingSpeakerIdentifierList();
+    }
+
+    // Rendered audio on disk is only valid for the models, their variant and the dictionary it was rendered with.
+    const auto model_variant = VoicevoxModelVariants::toString(voicevoxEnginePool->getSettings().modelVariant);
+    const auto model_version = juce::String::toHexString((getMetaJsonStringify() + model_variant).hashCode64());
+    synthesisCache->setModelVersion(model_version);
+    audioQueryCache->setModelVersion(model_version);
+
+    juce::Logger::outputDebugString(this->getMetaJsonStringify());
+
+    editorState.setProperty("VoicevoxEngine_HasSpeakerListUpdated", juce::var(true), nullptr);
+}
+
+void AudioPluginAudioProcessor::handleVoicevoxEngineReady()
+{
+    if (voicevoxTalkSpeakerIdentifierList.isEmpty() && voicevoxHummingSpeakerIdentifierList.isEmpty())
+    {
+        handleVoicevoxEngineMetadataAvailable();
+    }
+
+    editorState.setProperty("VoicevoxEngine_IsReady", juce::var(true), nullptr);
+}
+
 juce::String AudioPluginAudioProcessor::getMetaJsonStringify()
 {
-    return juce::JSON::toString(voicevoxEngine->getMetaJson());
+    if (synthesisDaemonClient != nullptr)
+    {
+        const auto daemon_metadata = synthesisDaemonClient->getMetadata();
+        return daemon_metadata.has_value() ? juce::JSON::toString(daemon_metadata->metaJson) : juce::String("{}");
+    }
+
+    // Reading the metadata before it is available would block until an engine has started.
+    if (!voicevoxEnginePool->hasMetadata())
+    {
+        return "{}";
+    }
+
+    return juce::JSON::toString(voicevoxEnginePool->getMetaJson());
 }
 
 //==============================================================================
@@ -5,12 +5,23 @@
 #include <voicevox_juce_extra/voicevox_juce_extra.h>
 #include <cocotone_song_editor_basics/cocotone_song_editor_basics.h>
 #include "SpinLockedPositionInfo.h"
+#include "Batch/TalkScript.h"
+#include "Cache/AudioQueryCache.h"
+#include "Cache/SynthesisCache.h"
+#include "Engine/SharedVoicevoxEnginePool.h"
+#include "Engine/VoicevoxRequestQueue.h"
+#include "Engine/SynthesisRequestRouter.h"
+#include "Daemon/SynthesisDaemonClient.h"
+#include "State/RenderedAudioRecall.h"
+#include "Playback/ProgressiveAudioSource.h"
+#include "Playback/SharedAudioBufferingThread.h"
 
 //==============================================================================
 class AudioPluginAudioProcessor final
     : public juce::AudioProcessor
     , private juce::ValueTree::Listener
     , private juce::ChangeListener
+    , private VoicevoxEnginePool::Listener
 {
 public:
     //==============================================================================
@@ -51,7 +62,6 @@ public:
 
     //==============================================================================
     void loadAudioFile(const juce::File& fileToLoad);
-    void loadAudioFileStream(std::unique_ptr<juce::InputStream> audioFileStream);
     void loadVoicevoxEngineAudioBufferInfo(const cctn::AudioBufferInfo& audioBufferInfo);
     void clearAudioFileHandle();
 
@@ -62,8 +72,15 @@ public:
     //==============================================================================
     void requestSynthesis(juce::int64 speakerId, const juce::String& text);
     void requestTextToSpeech(juce::int64 speakerId, const juce::String& text);
+    void requestTextToSpeechStreaming(juce::int64 speakerId, const juce::String& text);
+
+    // Renders every line with its own speaker and loads the assembled timeline for playback.
+    // Callbacks come from a render thread; a script superseded by a newer request never finishes.
+    using TalkScriptFinishedCallback = std::function<void(const TalkScriptRenderResult& result)>;
+    void requestTalkScript(const std::vector<TalkScriptLine>& lines, TalkScript::ProgressCallback onProgress = nullptr, TalkScriptFinishedCallback onFinished = nullptr);
     void requestHumming(juce::int64 speakerId, const juce::String& text);
     juce::String getMetaJsonStringify();
+    SynthesisCache::Statistics getSynthesisCacheStatistics() const { return synthesisCache->getStatistics(); }
 
     //==============================================================================
     juce::AudioFormatManager& getAudioFormatManager() const { return *audioFormatManager.get(); }
@@ -92,15 +109,48 @@ private:
     // juce::ValueTree::Listener
     void valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged, const juce::Identifier& propertyId) override;
 
+    // VoicevoxEnginePool::Listener
+    void voicevoxEnginePoolMetadataAvailable() override;
+    void voicevoxEnginePoolReady() override;
+
     //==============================================================================
     void updateCurrentTimeInfoFromHost(const juce::AudioPlayHead::PositionInfo& newPositionInfo);
 
+    // Called on the message thread once the speaker lists are known, possibly before an engine has started.
+    void handleVoicevoxEngineMetadataAvailable();
+    // Called on the message thread once the engine warm-up has finished.
+    void handleVoicevoxEngineReady();
+    // Runs the function on the message thread, unless the processor has been deleted by then,
+    // as when a host scanning plugins deletes it right after creating it.
+    void callAsyncWhileAlive(std::function<void()> function);
+
+    //==============================================================================
+    // Serves the request from the process-wide cache, or queues it for the engine on a miss.
+    void requestEngineAsync(const cctn::VoicevoxEngineRequest& request, std::function<void(const cctn::VoicevoxEngineArtefact&)> callback, CancellationTokenPtr cancellationToken,
+                            RequestPriority priority = RequestPriority::kInteractive, std::optional<double> timelinePositionInSeconds = std::nullopt);
+
+    //==============================================================================
+    struct StreamingTalkSession;
+    void decodeSentenceAsync(const cctn::VoicevoxEngineArtefact& artefact, std::function<void(std::optional<cctn::AudioBufferInfo>)> onDecoded);
+    void receiveStreamingSegment(const std::shared_ptr<StreamingTalkSession>& session, int segmentIndex, std::optional<cctn::AudioBufferInfo> segmentAudio);
+    void appendStreamingAudio(const std::shared_ptr<StreamingTalkSession>& session, const cctn::AudioBufferInfo& segmentAudio);
+    void publishStreamingAudio(StreamingTalkSession& session);
+    // Stops playback and drops every source, superseding a streaming session so none of its segments attaches its source again.
+    void unloadTransportSource();
+    void updateRenderLatency(double timeToFirstAudioMs, double totalLatencyMs);
+
+    struct SentenceTalkSession;
+    void renderTalkLines(std::vector<TalkScriptLine> lines, TalkScript::ProgressCallback onProgress, TalkScriptFinishedCallback onFinished);
+    void receiveSentence(const std::shared_ptr<SentenceTalkSession>& session, int sentenceIndex, std::optional<cctn::AudioBufferInfo> sentenceAudio);
+
     //==============================================================================
     // Audio
     std::unique_ptr<juce::AudioFormatManager> audioFormatManager;
-    std::unique_ptr<juce::TimeSliceThread> audioBufferingThread;
+    // Shared with the other instances of the plugin.
+    juce::SharedResourcePointer<SharedAudioBufferingThread> audioBufferingThread;
     std::unique_ptr<juce::AudioFormatReaderSource> audioFormatReaderSource;
     std::unique_ptr<juce::MemoryAudioSource> memoryAudioSource;
+    std::unique_ptr<ProgressiveAudioSource> progressiveAudioSource;
     std::unique_ptr<juce::AudioTransportSource> audioTransportSource;
     
     // Host sync audio source player
@@ -117,13 +167,65 @@ private:
         JUCE_LEAK_DETECTOR(AudioDataForAudioThumbnail)
     };
     std::unique_ptr<AudioDataForAudioThumbnail> audioDataForAudioThumbnail;
+    // Written from the message thread and the engine callbacks, read by the host in getStateInformation.
+    juce::CriticalSection audioDataForAudioThumbnailLock;
 
     // Position info
     SpinLockedPositionInfo spinLockedLastPositionInfo;
     juce::AudioPlayHead::PositionInfo playTriggeredPositionInfo;
 
     // Voicevox Engine
-    std::unique_ptr<cctn::VoicevoxEngine> voicevoxEngine;
+    // Shared with the other instances of the plugin; the request queue stays per instance.
+    SharedVoicevoxEnginePool::Reference voicevoxEnginePool;
+    juce::SharedResourcePointer<SynthesisCache> synthesisCache;
+    juce::SharedResourcePointer<AudioQueryCache> audioQueryCache;
+    std::unique_ptr<VoicevoxRequestQueue> voicevoxRequestQueue;
+    // Set when rendering through VoicevoxSynthesisDaemon; the local engines then stay stopped.
+    std::unique_ptr<SynthesisDaemonClient> synthesisDaemonClient;
+    // Created after the queue and the daemon client, destroyed before them.
+    std::unique_ptr<SynthesisRequestRouter> synthesisRequestRouter;
+
+    // Session recall
+    std::unique_ptr<RenderedAudioRecall> renderedAudioRecall;
+
+    // Streaming talk synthesis
+    struct StreamingTalkSession
+    {
+        int numSegments{ 0 };
+        int nextSegmentIndexToAppend{ 0 };
+        std::map<int, std::optional<cctn::AudioBufferInfo>> receivedSegments;
+        double sampleRate{ 0.0 };
+        double requestedTimeMs{ 0.0 };
+        double firstAudioTimeMs{ 0.0 };
+        // Samples handed to host-synced playback and the thumbnail so far.
+        juce::int64 numSamplesPublished{ 0 };
+
+        JUCE_LEAK_DETECTOR(StreamingTalkSession)
+    };
+    juce::CriticalSection streamingSessionLock;
+    std::shared_ptr<StreamingTalkSession> currentStreamingSession;
+
+    // Last stage of sentence rendering, after audio_query and synthesis on the queue:
+    // while a sentence is decoded here, the queue worker that synthesized it already
+    // leases an engine for the next one.
+    std::unique_ptr<juce::ThreadPool> sentenceDecodeThreadPool;
+
+    // Lines rendered independently and laid out on one timeline: a talk script
+    // with one request per line, or the sentences of an utterance.
+    struct SentenceTalkSession
+    {
+        std::vector<TalkScriptLine> lines;
+        std::vector<std::optional<cctn::AudioBufferInfo>> lineAudio;
+        std::vector<TalkScriptLineTiming> lineTimings;
+        int numSentencesPending{ 0 };
+        double requestedTimeMs{ 0.0 };
+        TalkScript::ProgressCallback onProgress;
+        TalkScriptFinishedCallback onFinished;
+
+        JUCE_LEAK_DETECTOR(SentenceTalkSession)
+    };
+    juce::CriticalSection sentenceSessionLock;
+    std::shared_ptr<SentenceTalkSession> currentSentenceSession;
 
     // SongEditor for Voicevox
     std::unique_ptr<cctn::song::TransportEmulator> songTransportEmulator;
@@ -138,5 +240,6 @@ private:
 
     std::atomic<bool> isSyncToHostTransport;
 
+    JUCE_DECLARE_WEAK_REFERENCEABLE (AudioPluginAudioProcessor)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioPluginAudioProcessor)
 };
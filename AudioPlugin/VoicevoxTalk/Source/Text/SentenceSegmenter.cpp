@@ -0,0 +1,99 @@
+#include "SentenceSegmenter.h"
+
+//==============================================================================
+SentenceSegmenter::SentenceSegmenter(int maxCharactersPerSegmentToUse)
+    : maxCharactersPerSegment(maxCharactersPerSegmentToUse)
+{
+}
+
+SentenceSegmenter::~SentenceSegmenter()
+{
+}
+
+//==============================================================================
+juce::StringArray SentenceSegmenter::split(const juce::String& text) const
+{
+    juce::StringArray segments;
+    juce::String current_sentence;
+
+    for (auto char_ptr = text.getCharPointer(); !char_ptr.isEmpty(); ++char_ptr)
+    {
+        const auto character = *char_ptr;
+
+        if (character == '\n' || character == '\r')
+        {
+            appendSegment(segments, current_sentence);
+            current_sentence.clear();
+            continue;
+        }
+
+        current_sentence += character;
+
+        if (isSentenceTerminator(character))
+        {
+            // Keep trailing closing brackets and repeated terminators with the sentence.
+            auto next_ptr = char_ptr + 1;
+            while (!next_ptr.isEmpty() && (isSentenceTerminator(*next_ptr) || juce::String(juce::CharPointer_UTF8("\xe3\x80\x8d\xe3\x80\x8f)")).containsChar(*next_ptr)))
+            {
+                current_sentence += *next_ptr;
+                char_ptr = next_ptr;
+                ++next_ptr;
+            }
+
+            appendSegment(segments, current_sentence);
+            current_sentence.clear();
+        }
+    }
+
+    appendSegment(segments, current_sentence);
+
+    return segments;
+}
+
+//==============================================================================
+bool SentenceSegmenter::isSentenceTerminator(juce::juce_wchar character)
+{
+    // "。", "．", "！", "？"
+    static const juce::String terminators = juce::String(juce::CharPointer_UTF8("\xe3\x80\x82\xef\xbc\x8e\xef\xbc\x81\xef\xbc\x9f")) + "!?";
+    return terminators.containsChar(character);
+}
+
+bool SentenceSegmenter::isClauseSeparator(juce::juce_wchar character)
+{
+    // "、", "，"
+    static const juce::String separators = juce::String(juce::CharPointer_UTF8("\xe3\x80\x81\xef\xbc\x8c")) + ",";
+    return separators.containsChar(character);
+}
+
+void SentenceSegmenter::appendSegment(juce::StringArray& segments, const juce::String& sentence) const
+{
+    const auto trimmed_sentence = sentence.trim();
+    if (trimmed_sentence.isEmpty())
+    {
+        return;
+    }
+
+    if (maxCharactersPerSegment <= 0 || trimmed_sentence.length() <= maxCharactersPerSegment)
+    {
+        segments.add(trimmed_sentence);
+        return;
+    }
+
+    // Split an overlong sentence at clause separators, merging clauses up to the limit.
+    juce::String current_segment;
+    for (auto char_ptr = trimmed_sentence.getCharPointer(); !char_ptr.isEmpty(); ++char_ptr)
+    {
+        current_segment += *char_ptr;
+
+        if (isClauseSeparator(*char_ptr) && current_segment.length() >= maxCharactersPerSegment / 2)
+        {
+            segments.add(current_segment.trim());
+            current_segment.clear();
+        }
+    }
+
+    if (current_segment.trim().isNotEmpty())
+    {
+        segments.add(current_segment.trim());
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+// SentenceSegmenter
+//
+// Splits talk text into sentences at Japanese and ASCII sentence punctuation
+// and line breaks. Sentences longer than maxCharactersPerSegment are further
+// split at clause punctuation so that the first chunk of a long paragraph
+// stays short.
+//==============================================================================
+class SentenceSegmenter final
+{
+public:
+    //==============================================================================
+    explicit SentenceSegmenter(int maxCharactersPerSegment = 0);
+    ~SentenceSegmenter();
+
+    //==============================================================================
+    juce::StringArray split(const juce::String& text) const;
+
+private:
+    //==============================================================================
+    static bool isSentenceTerminator(juce::juce_wchar character);
+    static bool isClauseSeparator(juce::juce_wchar character);
+
+    void appendSegment(juce::StringArray& segments, const juce::String& sentence) const;
+
+    //==============================================================================
+    const int maxCharactersPerSegment;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SentenceSegmenter)
+};
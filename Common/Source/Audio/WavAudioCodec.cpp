@@ -0,0 +1,71 @@
+#include "WavAudioCodec.h"
+
+//==============================================================================
+std::optional<cctn::AudioBufferInfo> WavAudioCodec::decodeArtefact(const cctn::VoicevoxEngineArtefact& artefact)
+{
+    if (artefact.audioBufferInfo.has_value())
+    {
+        return artefact.audioBufferInfo;
+    }
+
+    if (!artefact.wavBinary.has_value())
+    {
+        return std::nullopt;
+    }
+
+    return readWav(new juce::MemoryInputStream(artefact.wavBinary.value(), false));
+}
+
+std::optional<cctn::AudioBufferInfo> WavAudioCodec::readWavFile(const juce::File& fileToRead)
+{
+    auto input_stream = std::make_unique<juce::FileInputStream>(fileToRead);
+    if (input_stream->failedToOpen())
+    {
+        return std::nullopt;
+    }
+
+    return readWav(input_stream.release());
+}
+
+std::optional<cctn::AudioBufferInfo> WavAudioCodec::readWav(juce::InputStream* inputStream)
+{
+    juce::WavAudioFormat wav_format;
+    std::unique_ptr<juce::AudioFormatReader> reader(wav_format.createReaderFor(inputStream, true));
+    if (reader == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    cctn::AudioBufferInfo audio_buffer_info;
+    audio_buffer_info.sampleRate = reader->sampleRate;
+    audio_buffer_info.audioBuffer.setSize((int)reader->numChannels, (int)reader->lengthInSamples);
+    reader->read(&audio_buffer_info.audioBuffer, 0, (int)reader->lengthInSamples, 0, true, true);
+
+    return audio_buffer_info;
+}
+
+bool WavAudioCodec::writeWavFile(const juce::File& fileToWrite, const cctn::AudioBufferInfo& audioBufferInfo, int bitsPerSample)
+{
+    fileToWrite.deleteFile();
+
+    std::unique_ptr<juce::OutputStream> output_stream = std::make_unique<juce::FileOutputStream>(fileToWrite);
+    if (static_cast<juce::FileOutputStream*>(output_stream.get())->failedToOpen())
+    {
+        return false;
+    }
+
+    juce::WavAudioFormat wav_format;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wav_format.createWriterFor(output_stream.get(),
+                                                                               audioBufferInfo.sampleRate,
+                                                                               (unsigned int)audioBufferInfo.audioBuffer.getNumChannels(),
+                                                                               bitsPerSample, {}, 0));
+    if (writer == nullptr)
+    {
+        return false;
+    }
+
+    // The writer owns the stream from here on.
+    output_stream.release();
+
+    return writer->writeFromAudioSampleBuffer(audioBufferInfo.audioBuffer, 0, audioBufferInfo.audioBuffer.getNumSamples());
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <voicevox_juce_extra/voicevox_juce_extra.h>
+
+//==============================================================================
+// WavAudioCodec
+//
+// Converts between the WAV the engine and the render files carry and the
+// float samples playback, the caches and the tools work on.
+//==============================================================================
+class WavAudioCodec final
+{
+public:
+    // The artefact's float audio when it has some, otherwise its WAV binary decoded.
+    static std::optional<cctn::AudioBufferInfo> decodeArtefact(const cctn::VoicevoxEngineArtefact& artefact);
+
+    static std::optional<cctn::AudioBufferInfo> readWavFile(const juce::File& fileToRead);
+    // 32 bits writes float samples, for renders kept as a reference to compare against.
+    static bool writeWavFile(const juce::File& fileToWrite, const cctn::AudioBufferInfo& audioBufferInfo, int bitsPerSample = 16);
+
+private:
+    // Takes ownership of the stream.
+    static std::optional<cctn::AudioBufferInfo> readWav(juce::InputStream* inputStream);
+
+    WavAudioCodec() = delete;
+};
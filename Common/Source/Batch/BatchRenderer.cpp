@@ -0,0 +1,183 @@
+#include "BatchRenderer.h"
+#include "Audio/WavAudioCodec.h"
+
+//==============================================================================
+double BatchRenderResult::getRealTimeFactor() const
+{
+    if (audioLengthInSeconds <= 0.0)
+    {
+        return 0.0;
+    }
+
+    return (wallTimeMs / 1000.0) / audioLengthInSeconds;
+}
+
+//==============================================================================
+BatchRenderer::BatchRenderer(VoicevoxEnginePool& enginePool)
+    : enginePoolRef(enginePool)
+{
+}
+
+BatchRenderer::~BatchRenderer()
+{
+}
+
+//==============================================================================
+std::vector<BatchRenderResult> BatchRenderer::render(const std::vector<BatchRenderItem>& items, ItemFinishedCallback onItemFinished)
+{
+    std::vector<BatchRenderResult> results(items.size());
+
+    const int num_threads = juce::jmin(enginePoolRef.getNumEngines(), (int)items.size());
+    if (num_threads <= 0)
+    {
+        return results;
+    }
+
+    std::atomic<int> next_item_index{ 0 };
+    std::atomic<int> num_threads_running{ num_threads };
+    juce::WaitableEvent all_finished_event;
+
+    juce::ThreadPool thread_pool(num_threads);
+
+    for (int thread_idx = 0; thread_idx < num_threads; thread_idx++)
+    {
+        thread_pool.addJob(
+            [&] {
+                // Each thread takes the next item as soon as it is free, so long items do not hold up the rest.
+                for (int item_idx = next_item_index++; item_idx < (int)items.size(); item_idx = next_item_index++)
+                {
+                    auto& result = results[(size_t)item_idx];
+                    result.name = items[(size_t)item_idx].name;
+
+                    // Waiting for an engine, or starting one, is not part of the render time.
+                    auto engine_lease = enginePoolRef.acquire(items[(size_t)item_idx].request.speakerId);
+
+                    const auto start_time_ms = juce::Time::getMillisecondCounterHiRes();
+                    const auto artefact = VoicevoxEnginePool::renderAndWait(std::move(engine_lease), items[(size_t)item_idx].request);
+                    result.wallTimeMs = juce::Time::getMillisecondCounterHiRes() - start_time_ms;
+
+                    if (artefact.has_value())
+                    {
+                        result.audioBufferInfo = WavAudioCodec::decodeArtefact(artefact.value());
+                    }
+
+                    if (result.audioBufferInfo.has_value() && result.audioBufferInfo->sampleRate > 0.0)
+                    {
+                        result.succeeded = true;
+                        result.audioLengthInSeconds = result.audioBufferInfo->audioBuffer.getNumSamples() / result.audioBufferInfo->sampleRate;
+                    }
+
+                    if (onItemFinished != nullptr)
+                    {
+                        onItemFinished(item_idx, result);
+                    }
+                }
+
+                if (--num_threads_running == 0)
+                {
+                    all_finished_event.signal();
+                }
+            });
+    }
+
+    all_finished_event.wait();
+
+    return results;
+}
+
+TalkScriptRenderResult BatchRenderer::renderTalkScript(const std::vector<TalkScriptLine>& lines, TalkScript::ProgressCallback onProgress)
+{
+    std::vector<BatchRenderItem> items;
+    for (size_t line_idx = 0; line_idx < lines.size(); line_idx++)
+    {
+        BatchRenderItem item;
+        item.name = "line_" + juce::String((int)line_idx + 1).paddedLeft('0', 4);
+        item.request.requestId = juce::Uuid();
+        item.request.speakerId = lines[line_idx].speakerId;
+        item.request.text = lines[line_idx].text;
+        item.request.processType = cctn::VoicevoxEngineProcessType::kTalk;
+        items.push_back(std::move(item));
+    }
+
+    std::atomic<int> num_lines_finished{ 0 };
+
+    const auto start_time_ms = juce::Time::getMillisecondCounterHiRes();
+
+    auto results = render(items,
+        [&](int itemIndex, const BatchRenderResult& result) {
+            TalkScriptProgress progress;
+            progress.lineIndex = itemIndex;
+            progress.numLinesFinished = ++num_lines_finished;
+            progress.numLines = (int)lines.size();
+            progress.succeeded = result.succeeded;
+            progress.renderTimeMs = result.wallTimeMs;
+
+            if (onProgress != nullptr)
+            {
+                onProgress(progress);
+            }
+        });
+
+    TalkScriptRenderResult script_result;
+    script_result.lineTimings.resize(lines.size());
+
+    std::vector<std::optional<cctn::AudioBufferInfo>> line_audio(lines.size());
+    for (size_t line_idx = 0; line_idx < lines.size(); line_idx++)
+    {
+        line_audio[line_idx] = std::move(results[line_idx].audioBufferInfo);
+        script_result.lineTimings[line_idx].renderTimeMs = results[line_idx].wallTimeMs;
+    }
+
+    script_result.timeline = TalkScript::assembleTimeline(lines, line_audio, script_result.lineTimings);
+    script_result.wallTimeMs = juce::Time::getMillisecondCounterHiRes() - start_time_ms;
+
+    return script_result;
+}
+
+//==============================================================================
+std::vector<BatchRenderItem> BatchRenderer::loadScoreItems(const juce::File& scoreDirectory, juce::int64 speakerId, double sampleRate)
+{
+    auto score_files = scoreDirectory.findChildFiles(juce::File::findFiles, false, "*.json");
+    score_files.sort();
+
+    std::vector<BatchRenderItem> items;
+    for (const auto& score_file : score_files)
+    {
+        BatchRenderItem item;
+        item.name = score_file.getFileNameWithoutExtension();
+        item.request.requestId = juce::Uuid();
+        item.request.speakerId = speakerId;
+        item.request.scoreJson = score_file.loadFileAsString();
+        item.request.sampleRate = sampleRate;
+        item.request.processType = cctn::VoicevoxEngineProcessType::kHumming;
+        items.push_back(std::move(item));
+    }
+
+    return items;
+}
+
+std::vector<BatchRenderItem> BatchRenderer::loadTalkItems(const juce::File& textFile, juce::int64 speakerId)
+{
+    juce::StringArray lines;
+    textFile.readLines(lines);
+
+    std::vector<BatchRenderItem> items;
+    for (int line_idx = 0; line_idx < lines.size(); line_idx++)
+    {
+        const auto text = lines[line_idx].trim();
+        if (text.isEmpty())
+        {
+            continue;
+        }
+
+        BatchRenderItem item;
+        item.name = textFile.getFileNameWithoutExtension() + "_" + juce::String(line_idx + 1).paddedLeft('0', 4);
+        item.request.requestId = juce::Uuid();
+        item.request.speakerId = speakerId;
+        item.request.text = text;
+        item.request.processType = cctn::VoicevoxEngineProcessType::kTalk;
+        items.push_back(std::move(item));
+    }
+
+    return items;
+}
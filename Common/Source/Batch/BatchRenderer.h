@@ -0,0 +1,62 @@
+#pragma once
+
+#include <voicevox_juce_extra/voicevox_juce_extra.h>
+#include "Engine/VoicevoxEnginePool.h"
+#include "Batch/TalkScript.h"
+
+//==============================================================================
+struct BatchRenderItem
+{
+    juce::String name;
+    cctn::VoicevoxEngineRequest request;
+};
+
+struct BatchRenderResult
+{
+    juce::String name;
+    bool succeeded{ false };
+    double wallTimeMs{ 0.0 };
+    double audioLengthInSeconds{ 0.0 };
+    std::optional<cctn::AudioBufferInfo> audioBufferInfo;
+
+    // Wall time over audio length; below 1.0 renders faster than real time.
+    double getRealTimeFactor() const;
+};
+
+//==============================================================================
+// BatchRenderer
+//
+// Renders a list of requests without a host, spreading them over the engines
+// of a VoicevoxEnginePool with one thread per engine.
+//==============================================================================
+class BatchRenderer final
+{
+public:
+    //==============================================================================
+    // Called on a render thread as soon as each item has finished.
+    using ItemFinishedCallback = std::function<void(int itemIndex, const BatchRenderResult& result)>;
+
+    //==============================================================================
+    explicit BatchRenderer(VoicevoxEnginePool& enginePool);
+    ~BatchRenderer();
+
+    //==============================================================================
+    // Blocks until every item has been rendered. Results keep the order of the items.
+    std::vector<BatchRenderResult> render(const std::vector<BatchRenderItem>& items, ItemFinishedCallback onItemFinished = nullptr);
+
+    // Renders the lines over every engine and assembles them into one timeline. Blocks until done.
+    TalkScriptRenderResult renderTalkScript(const std::vector<TalkScriptLine>& lines, TalkScript::ProgressCallback onProgress = nullptr);
+
+    //==============================================================================
+    // Every *.json in the directory, as a humming request for the given speaker.
+    static std::vector<BatchRenderItem> loadScoreItems(const juce::File& scoreDirectory, juce::int64 speakerId, double sampleRate = 24000);
+
+    // Every non-empty line of the text file, as a talk request for the given speaker.
+    static std::vector<BatchRenderItem> loadTalkItems(const juce::File& textFile, juce::int64 speakerId);
+
+private:
+    //==============================================================================
+    VoicevoxEnginePool& enginePoolRef;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BatchRenderer)
+};
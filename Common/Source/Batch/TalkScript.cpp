@@ -0,0 +1,132 @@
+#include "TalkScript.h"
+
+namespace
+{
+    const juce::juce_wchar kFieldSeparator = '\t';
+    const juce::juce_wchar kCommentPrefix = '#';
+}
+
+//==============================================================================
+int TalkScriptRenderResult::getNumFailedLines() const
+{
+    return (int)std::count_if(lineTimings.begin(), lineTimings.end(),
+        [](const TalkScriptLineTiming& line_timing) {
+            return !line_timing.succeeded;
+        });
+}
+
+//==============================================================================
+std::optional<std::vector<TalkScriptLine>> TalkScript::parse(const juce::String& scriptText, const SpeakerResolver& resolveSpeaker,
+                                                             double defaultGapInSeconds, juce::String& errorMessage)
+{
+    juce::StringArray rows;
+    rows.addLines(scriptText);
+
+    std::vector<TalkScriptLine> lines;
+    for (int row_idx = 0; row_idx < rows.size(); row_idx++)
+    {
+        const auto row = rows[row_idx].trimEnd();
+        if (row.trim().isEmpty() || row.trimStart()[0] == kCommentPrefix)
+        {
+            continue;
+        }
+
+        const auto fields = juce::StringArray::fromTokens(row, juce::String::charToString(kFieldSeparator), {});
+        const auto row_label = "Line " + juce::String(row_idx + 1) + ": ";
+
+        if (fields.size() < 2 || fields[1].trim().isEmpty())
+        {
+            errorMessage = row_label + "expected \"speaker<TAB>text[<TAB>gap in seconds]\"";
+            return std::nullopt;
+        }
+
+        const auto speaker_id = resolveSpeaker(fields[0].trim());
+        if (!speaker_id.has_value())
+        {
+            errorMessage = row_label + "unknown speaker \"" + fields[0].trim() + "\"";
+            return std::nullopt;
+        }
+
+        TalkScriptLine line;
+        line.speakerId = speaker_id.value();
+        line.text = fields[1].trim();
+        line.gapInSeconds = fields.size() > 2 && fields[2].trim().isNotEmpty() ? juce::jmax(0.0, fields[2].trim().getDoubleValue())
+                                                                              : defaultGapInSeconds;
+        lines.push_back(std::move(line));
+    }
+
+    return lines;
+}
+
+std::optional<cctn::AudioBufferInfo> TalkScript::assembleTimeline(const std::vector<TalkScriptLine>& lines,
+                                                                  const std::vector<std::optional<cctn::AudioBufferInfo>>& lineAudio,
+                                                                  std::vector<TalkScriptLineTiming>& lineTimings)
+{
+    jassert(lineAudio.size() == lines.size());
+    lineTimings.resize(lines.size());
+
+    // Speakers may differ from line to line, but the timeline takes the sample rate of the first line that rendered.
+    double sample_rate = 0.0;
+    int num_channels = 0;
+    for (const auto& audio : lineAudio)
+    {
+        if (audio.has_value() && audio->sampleRate > 0.0 && audio->audioBuffer.getNumSamples() > 0)
+        {
+            sample_rate = sample_rate > 0.0 ? sample_rate : audio->sampleRate;
+            num_channels = juce::jmax(num_channels, audio->audioBuffer.getNumChannels());
+        }
+    }
+
+    // First pass places the lines, second pass copies them.
+    int num_samples = 0;
+    int last_line_end_sample = 0;
+    std::vector<int> start_samples(lines.size(), -1);
+    for (size_t line_idx = 0; line_idx < lines.size(); line_idx++)
+    {
+        auto& line_timing = lineTimings[line_idx];
+        const auto& audio = lineAudio[line_idx];
+
+        line_timing.succeeded = audio.has_value() && sample_rate > 0.0 && audio->sampleRate == sample_rate;
+        if (!line_timing.succeeded)
+        {
+            line_timing.startTimeInSeconds = 0.0;
+            line_timing.lengthInSeconds = 0.0;
+            continue;
+        }
+
+        start_samples[line_idx] = num_samples;
+        line_timing.startTimeInSeconds = num_samples / sample_rate;
+        line_timing.lengthInSeconds = audio->audioBuffer.getNumSamples() / sample_rate;
+
+        last_line_end_sample = num_samples + audio->audioBuffer.getNumSamples();
+        num_samples = last_line_end_sample + juce::roundToInt(lines[line_idx].gapInSeconds * sample_rate);
+    }
+
+    // No silence is left after the last line.
+    if (last_line_end_sample == 0)
+    {
+        return std::nullopt;
+    }
+
+    cctn::AudioBufferInfo timeline;
+    timeline.sampleRate = sample_rate;
+    timeline.audioBuffer.setSize(num_channels, last_line_end_sample);
+    timeline.audioBuffer.clear();
+
+    for (size_t line_idx = 0; line_idx < lines.size(); line_idx++)
+    {
+        if (start_samples[line_idx] < 0)
+        {
+            continue;
+        }
+
+        const auto& line_buffer = lineAudio[line_idx]->audioBuffer;
+        for (int channel_idx = 0; channel_idx < num_channels; channel_idx++)
+        {
+            timeline.audioBuffer.copyFrom(channel_idx, start_samples[line_idx], line_buffer,
+                                          juce::jmin(channel_idx, line_buffer.getNumChannels() - 1), 0, line_buffer.getNumSamples());
+        }
+    }
+
+    return timeline;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <voicevox_juce_extra/voicevox_juce_extra.h>
+
+//==============================================================================
+struct TalkScriptLine
+{
+    juce::int64 speakerId{ 0 };
+    juce::String text;
+    // When set, synthesized as is instead of the text, skipping the frontend.
+    juce::String audioQueryJson;
+    // Set on the sentences of a split utterance where they meet another one; only applies to AudioQuery synthesis.
+    bool trimsLeadingPadding{ false };
+    bool trimsTrailingPadding{ false };
+    // Silence after the line, before the next one starts.
+    double gapInSeconds{ 0.0 };
+};
+
+struct TalkScriptLineTiming
+{
+    bool succeeded{ false };
+    // From the request to the line's audio being available; near zero for cache hits.
+    double renderTimeMs{ 0.0 };
+    double startTimeInSeconds{ 0.0 };
+    double lengthInSeconds{ 0.0 };
+};
+
+struct TalkScriptProgress
+{
+    int lineIndex{ 0 };
+    int numLinesFinished{ 0 };
+    int numLines{ 0 };
+    bool succeeded{ false };
+    double renderTimeMs{ 0.0 };
+};
+
+struct TalkScriptRenderResult
+{
+    // Every line that rendered, in script order with its gap after it.
+    std::optional<cctn::AudioBufferInfo> timeline;
+    std::vector<TalkScriptLineTiming> lineTimings;
+    double wallTimeMs{ 0.0 };
+
+    int getNumFailedLines() const;
+};
+
+//==============================================================================
+// TalkScript
+//
+// A script of lines, each with its own speaker, rendered into one timeline.
+// - In a script file every row is "speaker<TAB>text", optionally followed by
+//   "<TAB>gap in seconds". Empty rows and rows starting with '#' are skipped.
+// - Lines render independently, so they can be spread over every engine and
+//   finish in any order; the timeline is assembled once all of them are in.
+//==============================================================================
+class TalkScript final
+{
+public:
+    //==============================================================================
+    // Called as each line finishes, on whichever thread rendered it.
+    using ProgressCallback = std::function<void(const TalkScriptProgress& progress)>;
+    // Speaker id or identifier to speaker id; std::nullopt for an unknown speaker.
+    using SpeakerResolver = std::function<std::optional<juce::int64>(const juce::String& speaker)>;
+
+    //==============================================================================
+    // Fails on the first row whose speaker cannot be resolved or which has no text, reporting it in errorMessage.
+    static std::optional<std::vector<TalkScriptLine>> parse(const juce::String& scriptText, const SpeakerResolver& resolveSpeaker,
+                                                            double defaultGapInSeconds, juce::String& errorMessage);
+
+    // Lays the lines out end to end. A line without audio, or at another sample
+    // rate than the first line, is left out of the timeline and marked as failed.
+    static std::optional<cctn::AudioBufferInfo> assembleTimeline(const std::vector<TalkScriptLine>& lines,
+                                                                 const std::vector<std::optional<cctn::AudioBufferInfo>>& lineAudio,
+                                                                 std::vector<TalkScriptLineTiming>& lineTimings);
+
+private:
+    TalkScript() = delete;
+};
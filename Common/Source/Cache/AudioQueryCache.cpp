@@ -0,0 +1,152 @@
+#include "AudioQueryCache.h"
+
+namespace
+{
+    constexpr size_t kDefaultByteBudget = 16 * 1024 * 1024;
+}
+
+//==============================================================================
+double AudioQueryCache::Statistics::getHitRate() const
+{
+    const auto num_lookups = numHits + numMisses;
+    return num_lookups > 0 ? (double)numHits / (double)num_lookups : 0.0;
+}
+
+//==============================================================================
+AudioQueryCache::AudioQueryCache()
+{
+    statistics.byteBudget = kDefaultByteBudget;
+}
+
+AudioQueryCache::~AudioQueryCache()
+{
+}
+
+//==============================================================================
+AudioQueryCache::Key AudioQueryCache::makeKey(juce::int64 speakerId, const juce::String& text)
+{
+    juce::String normalized_request;
+    normalized_request << "audio_query"
+                       << "|speaker=" << speakerId
+                       << "|text=" << text.trim();
+
+    Key key;
+    key.hash = juce::String::toHexString(normalized_request.hashCode64());
+    key.normalizedRequest = normalized_request;
+
+    return key;
+}
+
+//==============================================================================
+std::optional<AudioQueryCache::Entry> AudioQueryCache::lookup(const Key& key)
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    const auto it = slots.find(key.hash);
+
+    // The full normalized request is compared as well, so a hash collision is only a miss.
+    if (it != slots.end() && it->second.normalizedRequest == key.normalizedRequest)
+    {
+        recencyList.splice(recencyList.begin(), recencyList, it->second.recencyPosition);
+        statistics.numHits++;
+        statistics.savedFrontendTimeMs += it->second.entry.frontendTimeMs;
+
+        return it->second.entry;
+    }
+
+    statistics.numMisses++;
+
+    return std::nullopt;
+}
+
+void AudioQueryCache::store(const Key& key, const Entry& entry)
+{
+    const auto num_bytes = (size_t)entry.audioQueryJson.getNumBytesAsUTF8();
+
+    const juce::ScopedLock scoped_lock(lock);
+
+    if (num_bytes == 0 || num_bytes > statistics.byteBudget)
+    {
+        return;
+    }
+
+    const auto it = slots.find(key.hash);
+    if (it != slots.end())
+    {
+        statistics.numBytesUsed -= it->second.numBytes;
+        recencyList.erase(it->second.recencyPosition);
+        slots.erase(it);
+    }
+
+    recencyList.push_front(key.hash);
+
+    Slot slot;
+    slot.normalizedRequest = key.normalizedRequest;
+    slot.entry = entry;
+    slot.numBytes = num_bytes;
+    slot.recencyPosition = recencyList.begin();
+    slots[key.hash] = std::move(slot);
+
+    statistics.numBytesUsed += num_bytes;
+
+    evictToBudget();
+}
+
+void AudioQueryCache::clear()
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    slots.clear();
+    recencyList.clear();
+    statistics.numBytesUsed = 0;
+}
+
+void AudioQueryCache::setByteBudget(size_t newByteBudget)
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    statistics.byteBudget = newByteBudget;
+    evictToBudget();
+}
+
+void AudioQueryCache::setModelVersion(const juce::String& modelVersion)
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    if (modelVersion == currentModelVersion)
+    {
+        return;
+    }
+
+    currentModelVersion = modelVersion;
+    slots.clear();
+    recencyList.clear();
+    statistics.numBytesUsed = 0;
+}
+
+AudioQueryCache::Statistics AudioQueryCache::getStatistics() const
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    auto current_statistics = statistics;
+    current_statistics.numEntries = (int)slots.size();
+
+    return current_statistics;
+}
+
+//==============================================================================
+void AudioQueryCache::evictToBudget()
+{
+    while (statistics.numBytesUsed > statistics.byteBudget && !recencyList.empty())
+    {
+        const auto it = slots.find(recencyList.back());
+        recencyList.pop_back();
+
+        if (it != slots.end())
+        {
+            statistics.numBytesUsed -= it->second.numBytes;
+            slots.erase(it);
+            statistics.numEvictions++;
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Cache/SynthesisCache.h"
+
+//==============================================================================
+// AudioQueryCache
+//
+// LRU cache of the AudioQuery of a sentence for a speaker: the output of the
+// core's text frontend and prosody prediction, which synthesis then turns
+// into audio. A few kilobytes each, so it holds far more sentences than the
+// SynthesisCache holds renders, and a render evicted from there only pays
+// for the waveform again.
+// - Keyed per (sentence, speaker): the core predicts pitch and lengths
+//   inside audio_query, so the accent phrases are not split out per sentence.
+// - Cleared when the model or dictionary version changes, since either
+//   changes the queries. Memory only; queries are cheap next to renders.
+//==============================================================================
+class AudioQueryCache final
+{
+public:
+    //==============================================================================
+    // Same shape as the render keys, so the request queue coalesces both alike.
+    using Key = SynthesisCache::Key;
+
+    struct Entry
+    {
+        juce::String audioQueryJson;
+        // Time audio_query took, which every hit saves.
+        double frontendTimeMs{ 0.0 };
+    };
+
+    struct Statistics
+    {
+        juce::int64 numHits{ 0 };
+        juce::int64 numMisses{ 0 };
+        juce::int64 numEvictions{ 0 };
+        int numEntries{ 0 };
+        size_t numBytesUsed{ 0 };
+        size_t byteBudget{ 0 };
+        double savedFrontendTimeMs{ 0.0 };
+
+        double getHitRate() const;
+    };
+
+    //==============================================================================
+    AudioQueryCache();
+    ~AudioQueryCache();
+
+    //==============================================================================
+    static Key makeKey(juce::int64 speakerId, const juce::String& text);
+
+    //==============================================================================
+    std::optional<Entry> lookup(const Key& key);
+    void store(const Key& key, const Entry& entry);
+    void clear();
+
+    void setByteBudget(size_t newByteBudget);
+
+    // Drops every query once the model or dictionary version differs from the one they were made with.
+    void setModelVersion(const juce::String& modelVersion);
+    Statistics getStatistics() const;
+
+private:
+    //==============================================================================
+    struct Slot
+    {
+        juce::String normalizedRequest;
+        Entry entry;
+        size_t numBytes{ 0 };
+        std::list<juce::String>::iterator recencyPosition;
+    };
+
+    void evictToBudget();
+
+    //==============================================================================
+    mutable juce::CriticalSection lock;
+    std::map<juce::String, Slot> slots;
+    std::list<juce::String> recencyList; // Most recently used first.
+    Statistics statistics;
+    juce::String currentModelVersion;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioQueryCache)
+};
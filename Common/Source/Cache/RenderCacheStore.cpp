@@ -0,0 +1,329 @@
+#include "RenderCacheStore.h"
+
+namespace
+{
+    constexpr juce::int64 kDefaultSizeCapInBytes = (juce::int64)2 * 1024 * 1024 * 1024;
+    constexpr int kFileFormatVersion = 2;
+    const char* const kFileMagic = "VVRC";
+    const char* const kFileExtension = ".vvcache";
+    const char* const kTemporaryFileExtension = ".vvtemp";
+    // Long enough that no write still running in another process is mistaken for a leftover.
+    constexpr juce::int64 kStaleTemporaryFileAgeMs = (juce::int64)60 * 60 * 1000;
+
+    enum PayloadFlags
+    {
+        kHasWavBinary = 1 << 0,
+        kHasAudioBuffer = 1 << 1
+    };
+}
+
+//==============================================================================
+RenderCacheStore::RenderCacheStore(const juce::File& rootDirectoryToUse)
+    : rootDirectory(rootDirectoryToUse)
+    , temporaryFileTag(juce::String::toHexString(juce::Random().nextInt64()))
+    , sizeCapInBytes(kDefaultSizeCapInBytes)
+    , numBytesOnDisk(0)
+{
+}
+
+RenderCacheStore::~RenderCacheStore()
+{
+    writerThreadPool.removeAllJobs(false, 10000);
+}
+
+//==============================================================================
+juce::File RenderCacheStore::getDefaultRootDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("COCOTONE")
+        .getChildFile("VoicevoxJuceDemo")
+        .getChildFile("RenderCache");
+}
+
+//==============================================================================
+void RenderCacheStore::setModelVersion(const juce::String& newModelVersion)
+{
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        if (modelVersion == newModelVersion)
+        {
+            return;
+        }
+
+        modelVersion = newModelVersion;
+    }
+
+    writerThreadPool.addJob([this] { scanAndEvict(); });
+}
+
+void RenderCacheStore::setSizeCapInBytes(juce::int64 newSizeCapInBytes)
+{
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        sizeCapInBytes = newSizeCapInBytes;
+    }
+
+    writerThreadPool.addJob([this] { scanAndEvict(); });
+}
+
+std::optional<SynthesisCache::Entry> RenderCacheStore::read(const SynthesisCache::Key& key)
+{
+    const auto file = getFileForKey(key);
+    if (file == juce::File() || !file.existsAsFile())
+    {
+        return std::nullopt;
+    }
+
+    juce::FileInputStream input_stream(file);
+    if (!input_stream.openedOk())
+    {
+        return std::nullopt;
+    }
+
+    char magic[4] = {};
+    if (input_stream.read(magic, 4) != 4 || std::memcmp(magic, kFileMagic, 4) != 0
+        || input_stream.readInt() != kFileFormatVersion
+        || input_stream.readString() != key.normalizedRequest)
+    {
+        return std::nullopt;
+    }
+
+    // The sizes come from the file, so they are checked against what is left of it before
+    // anything is allocated; a truncated or corrupted file is a miss.
+    auto get_num_bytes_remaining = [&input_stream] {
+        return input_stream.getTotalLength() - input_stream.getPosition();
+    };
+
+    SynthesisCache::Entry entry;
+    const auto flags = input_stream.readInt();
+    entry.renderTimeMs = input_stream.readDouble();
+
+    if ((flags & kHasWavBinary) != 0)
+    {
+        const auto num_bytes = input_stream.readInt64();
+        if (num_bytes < 0 || num_bytes > get_num_bytes_remaining() || num_bytes > (juce::int64)std::numeric_limits<int>::max())
+        {
+            return std::nullopt;
+        }
+
+        juce::MemoryBlock wav_binary((size_t)num_bytes);
+        if ((juce::int64)input_stream.read(wav_binary.getData(), (int)num_bytes) != num_bytes)
+        {
+            return std::nullopt;
+        }
+
+        entry.wavBinary = std::move(wav_binary);
+    }
+
+    if ((flags & kHasAudioBuffer) != 0)
+    {
+        cctn::AudioBufferInfo audio_buffer_info;
+        audio_buffer_info.sampleRate = input_stream.readDouble();
+        const auto num_channels = input_stream.readInt();
+        const auto num_samples = input_stream.readInt();
+        if (num_channels <= 0 || num_samples < 0
+            || (juce::int64)num_channels * num_samples * (juce::int64)sizeof(float) > get_num_bytes_remaining())
+        {
+            return std::nullopt;
+        }
+
+        audio_buffer_info.audioBuffer.setSize(num_channels, num_samples);
+        for (int channel_idx = 0; channel_idx < num_channels; channel_idx++)
+        {
+            const auto num_bytes = (int)(num_samples * sizeof(float));
+            if (input_stream.read(audio_buffer_info.audioBuffer.getWritePointer(channel_idx), num_bytes) != num_bytes)
+            {
+                return std::nullopt;
+            }
+        }
+
+        entry.audioBufferInfo = std::move(audio_buffer_info);
+    }
+
+    // Written by versions which also stored failed renders; such an entry is never a hit.
+    if (entry.getSizeInBytes() == 0)
+    {
+        file.deleteFile();
+        return std::nullopt;
+    }
+
+    // Recently read files are evicted last.
+    file.setLastAccessTime(juce::Time::getCurrentTime());
+
+    return entry;
+}
+
+void RenderCacheStore::writeAsync(const SynthesisCache::Key& key, const SynthesisCache::Entry& entry)
+{
+    const auto file = getFileForKey(key);
+    if (file == juce::File())
+    {
+        return;
+    }
+
+    writerThreadPool.addJob(
+        [this, file, key, entry] {
+            if (!write(file, key, entry))
+            {
+                juce::Logger::outputDebugString("[RenderCacheStore] Failed to write " + file.getFullPathName());
+                return;
+            }
+
+            bool should_evict = false;
+            {
+                const juce::ScopedLock scoped_lock(lock);
+                numBytesOnDisk += file.getSize();
+                should_evict = numBytesOnDisk > sizeCapInBytes;
+            }
+
+            if (should_evict)
+            {
+                scanAndEvict();
+            }
+        });
+}
+
+//==============================================================================
+juce::File RenderCacheStore::getFileForKey(const SynthesisCache::Key& key) const
+{
+    juce::String model_version;
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        model_version = modelVersion;
+    }
+
+    if (model_version.isEmpty())
+    {
+        return juce::File();
+    }
+
+    return rootDirectory.getChildFile(model_version).getChildFile(key.hash + kFileExtension);
+}
+
+bool RenderCacheStore::write(const juce::File& targetFile, const SynthesisCache::Key& key, const SynthesisCache::Entry& entry)
+{
+    if (!targetFile.getParentDirectory().createDirectory())
+    {
+        return false;
+    }
+
+    // Written next to the target and renamed into place, so a crash never leaves a truncated entry behind.
+    juce::TemporaryFile temporary_file(targetFile,
+                                       targetFile.getSiblingFile(key.hash + "_" + temporaryFileTag + kTemporaryFileExtension));
+    {
+        juce::FileOutputStream output_stream(temporary_file.getFile());
+        if (!output_stream.openedOk())
+        {
+            return false;
+        }
+
+        int flags = 0;
+        flags |= entry.wavBinary.has_value() ? kHasWavBinary : 0;
+        flags |= entry.audioBufferInfo.has_value() ? kHasAudioBuffer : 0;
+
+        output_stream.write(kFileMagic, 4);
+        output_stream.writeInt(kFileFormatVersion);
+        output_stream.writeString(key.normalizedRequest);
+        output_stream.writeInt(flags);
+        output_stream.writeDouble(entry.renderTimeMs);
+
+        if (entry.wavBinary.has_value())
+        {
+            output_stream.writeInt64((juce::int64)entry.wavBinary->getSize());
+            output_stream.write(entry.wavBinary->getData(), entry.wavBinary->getSize());
+        }
+
+        if (entry.audioBufferInfo.has_value())
+        {
+            const auto& audio_buffer = entry.audioBufferInfo->audioBuffer;
+            output_stream.writeDouble(entry.audioBufferInfo->sampleRate);
+            output_stream.writeInt(audio_buffer.getNumChannels());
+            output_stream.writeInt(audio_buffer.getNumSamples());
+
+            for (int channel_idx = 0; channel_idx < audio_buffer.getNumChannels(); channel_idx++)
+            {
+                output_stream.write(audio_buffer.getReadPointer(channel_idx), (size_t)audio_buffer.getNumSamples() * sizeof(float));
+            }
+        }
+
+        output_stream.flush();
+        if (output_stream.getStatus().failed())
+        {
+            return false;
+        }
+    }
+
+    return temporary_file.overwriteTargetFileWithTemporary();
+}
+
+void RenderCacheStore::scanAndEvict()
+{
+    juce::int64 size_cap_in_bytes = 0;
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        size_cap_in_bytes = sizeCapInBytes;
+    }
+
+    struct CachedFile
+    {
+        juce::File file;
+        juce::Time lastAccessTime;
+        juce::int64 size;
+    };
+
+    std::vector<CachedFile> cached_files;
+    juce::int64 total_bytes = 0;
+
+    const auto now = juce::Time::getCurrentTime();
+
+    for (const auto& entry : juce::RangedDirectoryIterator(rootDirectory, true, "*", juce::File::findFiles))
+    {
+        const auto file = entry.getFile();
+
+        // Leftovers of interrupted writes. This store writes on the thread scanning, so its own are
+        // never in use; those of other processes may be, until they are old enough to be stale.
+        // Older versions left juce::TemporaryFile's default "_temp" names behind.
+        const bool is_temporary_file = file.hasFileExtension(kTemporaryFileExtension)
+                                       || (file.hasFileExtension(kFileExtension) && file.getFileNameWithoutExtension().contains("_temp"));
+        if (is_temporary_file)
+        {
+            const bool is_own_file = file.getFileNameWithoutExtension().endsWith("_" + temporaryFileTag);
+            const bool is_stale = (now - file.getLastModificationTime()).inMilliseconds() > kStaleTemporaryFileAgeMs;
+            if (is_own_file || is_stale)
+            {
+                file.deleteFile();
+            }
+
+            continue;
+        }
+
+        if (!file.hasFileExtension(kFileExtension))
+        {
+            continue;
+        }
+
+        cached_files.push_back({ file, file.getLastAccessTime(), file.getSize() });
+        total_bytes += file.getSize();
+    }
+
+    std::sort(cached_files.begin(), cached_files.end(),
+        [](const CachedFile& lhs, const CachedFile& rhs) {
+            return lhs.lastAccessTime < rhs.lastAccessTime;
+        });
+
+    for (const auto& cached_file : cached_files)
+    {
+        if (total_bytes <= size_cap_in_bytes)
+        {
+            break;
+        }
+
+        if (cached_file.file.deleteFile())
+        {
+            total_bytes -= cached_file.size;
+        }
+    }
+
+    const juce::ScopedLock scoped_lock(lock);
+    numBytesOnDisk = total_bytes;
+}
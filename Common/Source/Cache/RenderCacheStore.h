@@ -0,0 +1,56 @@
+#pragma once
+
+#include "SynthesisCache.h"
+
+//==============================================================================
+// RenderCacheStore
+//
+// Disk-backed second level of the SynthesisCache. Entries live in one file
+// per request hash below a directory named after the model version, so a
+// model or dictionary update never serves stale audio. Files are written to a
+// temporary file first and renamed into place, and the least recently used
+// files are deleted once the directory grows past its size cap.
+// - The root directory is shared by every process using the cache, so a
+//   store only deletes its own temporary files and those of other writers
+//   once they are old enough to have been left behind by a crash.
+//==============================================================================
+class RenderCacheStore final
+{
+public:
+    //==============================================================================
+    explicit RenderCacheStore(const juce::File& rootDirectory);
+    ~RenderCacheStore();
+
+    //==============================================================================
+    static juce::File getDefaultRootDirectory();
+
+    //==============================================================================
+    // Entries are only read and written once a model version has been set.
+    void setModelVersion(const juce::String& newModelVersion);
+    void setSizeCapInBytes(juce::int64 newSizeCapInBytes);
+
+    std::optional<SynthesisCache::Entry> read(const SynthesisCache::Key& key);
+
+    // Writes on a background thread.
+    void writeAsync(const SynthesisCache::Key& key, const SynthesisCache::Entry& entry);
+
+private:
+    //==============================================================================
+    juce::File getFileForKey(const SynthesisCache::Key& key) const;
+    bool write(const juce::File& targetFile, const SynthesisCache::Key& key, const SynthesisCache::Entry& entry);
+    void scanAndEvict();
+
+    //==============================================================================
+    const juce::File rootDirectory;
+    // Names the temporary files of this store apart from those of other processes.
+    const juce::String temporaryFileTag;
+
+    mutable juce::CriticalSection lock;
+    juce::String modelVersion;
+    juce::int64 sizeCapInBytes;
+    juce::int64 numBytesOnDisk;
+
+    juce::ThreadPool writerThreadPool{ 1 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RenderCacheStore)
+};
@@ -0,0 +1,243 @@
+#include "SynthesisCache.h"
+#include "RenderCacheStore.h"
+
+namespace
+{
+    constexpr size_t kDefaultByteBudget = 256 * 1024 * 1024;
+}
+
+//==============================================================================
+size_t SynthesisCache::Entry::getSizeInBytes() const
+{
+    size_t num_bytes = 0;
+
+    if (wavBinary.has_value())
+    {
+        num_bytes += wavBinary->getSize();
+    }
+
+    if (audioBufferInfo.has_value())
+    {
+        num_bytes += (size_t)audioBufferInfo->audioBuffer.getNumChannels() * (size_t)audioBufferInfo->audioBuffer.getNumSamples() * sizeof(float);
+    }
+
+    return num_bytes;
+}
+
+double SynthesisCache::Statistics::getHitRate() const
+{
+    const auto num_lookups = numHits + numMisses;
+    return num_lookups > 0 ? (double)numHits / (double)num_lookups : 0.0;
+}
+
+//==============================================================================
+SynthesisCache::SynthesisCache()
+{
+    statistics.byteBudget = kDefaultByteBudget;
+}
+
+SynthesisCache::~SynthesisCache()
+{
+}
+
+//==============================================================================
+SynthesisCache::Key SynthesisCache::makeKey(const cctn::VoicevoxEngineRequest& request)
+{
+    return makeKey(request, {});
+}
+
+SynthesisCache::Key SynthesisCache::makeKey(const cctn::VoicevoxEngineRequest& request, const juce::String& audioQueryJson)
+{
+    // Re-serialize the score so that formatting differences do not produce different keys.
+    juce::String normalized_score;
+    if (request.scoreJson.isNotEmpty())
+    {
+        normalized_score = juce::JSON::toString(juce::JSON::parse(request.scoreJson), true);
+    }
+
+    juce::String normalized_request;
+    normalized_request << "type=" << (int)request.processType
+                       << "|speaker=" << (juce::int64)request.speakerId
+                       << "|rate=" << juce::String(request.sampleRate)
+                       << "|text=" << request.text.trim()
+                       << "|score=" << normalized_score;
+
+    // Left out for engine requests, so their keys, and the renders stored on disk under them, stay the same.
+    if (audioQueryJson.isNotEmpty())
+    {
+        normalized_request << "|query=" << juce::JSON::toString(juce::JSON::parse(audioQueryJson), true);
+    }
+
+    Key key;
+    key.hash = juce::String::toHexString(normalized_request.hashCode64());
+    key.normalizedRequest = normalized_request;
+
+    return key;
+}
+
+SynthesisCache::Entry SynthesisCache::makeEntry(const cctn::VoicevoxEngineArtefact& artefact, double renderTimeMs)
+{
+    Entry entry;
+    entry.wavBinary = artefact.wavBinary;
+    entry.audioBufferInfo = artefact.audioBufferInfo;
+    entry.renderTimeMs = renderTimeMs;
+
+    return entry;
+}
+
+cctn::VoicevoxEngineArtefact SynthesisCache::makeArtefact(const juce::Uuid& requestId, const Entry& entry)
+{
+    cctn::VoicevoxEngineArtefact artefact;
+    artefact.requestId = requestId;
+    artefact.wavBinary = entry.wavBinary;
+    artefact.audioBufferInfo = entry.audioBufferInfo;
+
+    return artefact;
+}
+
+//==============================================================================
+std::optional<SynthesisCache::Entry> SynthesisCache::lookup(const Key& key)
+{
+    RenderCacheStore* render_cache_store = nullptr;
+    {
+        const juce::ScopedLock scoped_lock(lock);
+
+        const auto it = slots.find(key.hash);
+
+        // The full normalized request is compared as well, so a hash collision is only a miss.
+        if (it != slots.end() && it->second.normalizedRequest == key.normalizedRequest)
+        {
+            recencyList.splice(recencyList.begin(), recencyList, it->second.recencyPosition);
+            statistics.numHits++;
+            statistics.savedRenderTimeMs += it->second.entry.renderTimeMs;
+
+            return it->second.entry;
+        }
+
+        render_cache_store = renderCacheStore.get();
+    }
+
+    // The disk is read outside of the lock, other processors keep hitting memory meanwhile.
+    if (render_cache_store != nullptr)
+    {
+        if (auto disk_entry = render_cache_store->read(key))
+        {
+            const juce::ScopedLock scoped_lock(lock);
+            insert(key, disk_entry.value());
+            statistics.numHits++;
+            statistics.numDiskHits++;
+            statistics.savedRenderTimeMs += disk_entry->renderTimeMs;
+
+            return disk_entry;
+        }
+    }
+
+    const juce::ScopedLock scoped_lock(lock);
+    statistics.numMisses++;
+
+    return std::nullopt;
+}
+
+void SynthesisCache::store(const Key& key, const Entry& entry)
+{
+    // A failed render carries no audio; keeping it would serve the failure on every later lookup.
+    if (entry.getSizeInBytes() == 0)
+    {
+        return;
+    }
+
+    const juce::ScopedLock scoped_lock(lock);
+
+    insert(key, entry);
+
+    if (renderCacheStore != nullptr)
+    {
+        renderCacheStore->writeAsync(key, entry);
+    }
+}
+
+void SynthesisCache::clear()
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    slots.clear();
+    recencyList.clear();
+    statistics.numBytesUsed = 0;
+}
+
+void SynthesisCache::setByteBudget(size_t newByteBudget)
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    statistics.byteBudget = newByteBudget;
+    evictToBudget();
+}
+
+void SynthesisCache::setModelVersion(const juce::String& modelVersion)
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    if (renderCacheStore == nullptr)
+    {
+        renderCacheStore = std::make_unique<RenderCacheStore>(RenderCacheStore::getDefaultRootDirectory());
+    }
+
+    renderCacheStore->setModelVersion(modelVersion);
+}
+
+SynthesisCache::Statistics SynthesisCache::getStatistics() const
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    auto current_statistics = statistics;
+    current_statistics.numEntries = (int)slots.size();
+
+    return current_statistics;
+}
+
+//==============================================================================
+void SynthesisCache::insert(const Key& key, const Entry& entry)
+{
+    const auto num_bytes = entry.getSizeInBytes();
+    if (num_bytes == 0 || num_bytes > statistics.byteBudget)
+    {
+        return;
+    }
+
+    const auto it = slots.find(key.hash);
+    if (it != slots.end())
+    {
+        statistics.numBytesUsed -= it->second.numBytes;
+        recencyList.erase(it->second.recencyPosition);
+        slots.erase(it);
+    }
+
+    recencyList.push_front(key.hash);
+
+    Slot slot;
+    slot.normalizedRequest = key.normalizedRequest;
+    slot.entry = entry;
+    slot.numBytes = num_bytes;
+    slot.recencyPosition = recencyList.begin();
+    slots[key.hash] = std::move(slot);
+
+    statistics.numBytesUsed += num_bytes;
+
+    evictToBudget();
+}
+
+void SynthesisCache::evictToBudget()
+{
+    while (statistics.numBytesUsed > statistics.byteBudget && !recencyList.empty())
+    {
+        const auto it = slots.find(recencyList.back());
+        recencyList.pop_back();
+
+        if (it != slots.end())
+        {
+            statistics.numBytesUsed -= it->second.numBytes;
+            slots.erase(it);
+            statistics.numEvictions++;
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <voicevox_juce_extra/voicevox_juce_extra.h>
+
+class RenderCacheStore;
+
+//==============================================================================
+// SynthesisCache
+//
+// Content-addressed LRU cache of engine results, keyed by a hash of the
+// normalized request. Share it with juce::SharedResourcePointer so that every
+// processor in the process hits the same cache. Once the model version is
+// known, misses fall through to a RenderCacheStore on disk.
+//==============================================================================
+class SynthesisCache final
+{
+public:
+    //==============================================================================
+    struct Key
+    {
+        juce::String hash;
+        juce::String normalizedRequest;
+    };
+
+    struct Entry
+    {
+        std::optional<juce::MemoryBlock> wavBinary;
+        std::optional<cctn::AudioBufferInfo> audioBufferInfo;
+        // Time the engine took to render it, which every hit saves.
+        double renderTimeMs{ 0.0 };
+
+        size_t getSizeInBytes() const;
+    };
+
+    struct Statistics
+    {
+        juce::int64 numHits{ 0 };
+        juce::int64 numMisses{ 0 };
+        juce::int64 numDiskHits{ 0 };
+        juce::int64 numEvictions{ 0 };
+        int numEntries{ 0 };
+        size_t numBytesUsed{ 0 };
+        size_t byteBudget{ 0 };
+        double savedRenderTimeMs{ 0.0 };
+
+        double getHitRate() const;
+    };
+
+    //==============================================================================
+    SynthesisCache();
+    ~SynthesisCache();
+
+    //==============================================================================
+    static Key makeKey(const cctn::VoicevoxEngineRequest& request);
+    // For an AudioQuery synthesized with the request's speaker and sample rate.
+    static Key makeKey(const cctn::VoicevoxEngineRequest& request, const juce::String& audioQueryJson);
+    static Entry makeEntry(const cctn::VoicevoxEngineArtefact& artefact, double renderTimeMs = 0.0);
+    static cctn::VoicevoxEngineArtefact makeArtefact(const juce::Uuid& requestId, const Entry& entry);
+
+    //==============================================================================
+    std::optional<Entry> lookup(const Key& key);
+    void store(const Key& key, const Entry& entry);
+    void clear();
+
+    void setByteBudget(size_t newByteBudget);
+
+    // Enables the disk cache for results of the given model and dictionary version.
+    void setModelVersion(const juce::String& modelVersion);
+    Statistics getStatistics() const;
+
+private:
+    //==============================================================================
+    struct Slot
+    {
+        juce::String normalizedRequest;
+        Entry entry;
+        size_t numBytes{ 0 };
+        std::list<juce::String>::iterator recencyPosition;
+    };
+
+    void insert(const Key& key, const Entry& entry);
+    void evictToBudget();
+
+    //==============================================================================
+    mutable juce::CriticalSection lock;
+    std::map<juce::String, Slot> slots;
+    std::list<juce::String> recencyList; // Most recently used first.
+    Statistics statistics;
+
+    std::unique_ptr<RenderCacheStore> renderCacheStore;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SynthesisCache)
+};
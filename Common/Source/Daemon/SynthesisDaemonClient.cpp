@@ -0,0 +1,150 @@
+#include "SynthesisDaemonClient.h"
+
+//==============================================================================
+SynthesisDaemonClient::SynthesisDaemonClient()
+    : juce::InterprocessConnection(false)
+{
+}
+
+SynthesisDaemonClient::~SynthesisDaemonClient()
+{
+    disconnect();
+}
+
+//==============================================================================
+std::optional<int> SynthesisDaemonClient::getPortFromEnvironment()
+{
+    const auto port = juce::SystemStats::getEnvironmentVariable(SynthesisDaemonProtocol::kPortEnvironmentVariableName, {});
+    if (port.isEmpty())
+    {
+        return std::nullopt;
+    }
+
+    return port.containsOnly("0123456789") ? port.getIntValue() : SynthesisDaemonProtocol::kDefaultPort;
+}
+
+bool SynthesisDaemonClient::connect(int port)
+{
+    return connectToSocket("127.0.0.1", port, SynthesisDaemonProtocol::kConnectionTimeoutMs);
+}
+
+//==============================================================================
+void SynthesisDaemonClient::requestMetadataAsync(std::function<void()> onMetadataReceived)
+{
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        onMetadataReceivedCallback = std::move(onMetadataReceived);
+    }
+
+    sendMessage(SynthesisDaemonProtocol::makeMetadataRequestMessage());
+}
+
+std::optional<SynthesisDaemonProtocol::Metadata> SynthesisDaemonClient::getMetadata() const
+{
+    const juce::ScopedLock scoped_lock(lock);
+    return metadata;
+}
+
+void SynthesisDaemonClient::submit(const cctn::VoicevoxEngineRequest& request, Callback callback, CancellationTokenPtr cancellationToken,
+                                   RequestPriority priority, std::optional<double> timelinePositionInSeconds)
+{
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        pendingRequests[request.requestId.toString()] = PendingRequest{ std::move(callback), std::move(cancellationToken) };
+    }
+
+    if (!sendMessage(SynthesisDaemonProtocol::makeRenderMessage(request, priority, timelinePositionInSeconds)))
+    {
+        PendingRequest pending_request;
+        {
+            const juce::ScopedLock scoped_lock(lock);
+            const auto it = pendingRequests.find(request.requestId.toString());
+            if (it == pendingRequests.end())
+            {
+                return;
+            }
+
+            pending_request = std::move(it->second);
+            pendingRequests.erase(it);
+        }
+
+        cctn::VoicevoxEngineArtefact artefact;
+        artefact.requestId = request.requestId;
+        pending_request.callback(artefact);
+    }
+}
+
+//==============================================================================
+void SynthesisDaemonClient::connectionMade()
+{
+    juce::Logger::outputDebugString("[SynthesisDaemonClient] connected to " + getConnectedHostName());
+}
+
+void SynthesisDaemonClient::connectionLost()
+{
+    juce::Logger::outputDebugString("[SynthesisDaemonClient] connection lost");
+
+    std::map<juce::String, PendingRequest> lost_requests;
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        std::swap(lost_requests, pendingRequests);
+    }
+
+    for (auto& [request_id, pending_request] : lost_requests)
+    {
+        if (pending_request.cancellationToken != nullptr && pending_request.cancellationToken->isCancelled())
+        {
+            continue;
+        }
+
+        cctn::VoicevoxEngineArtefact artefact;
+        artefact.requestId = juce::Uuid(request_id);
+        pending_request.callback(artefact);
+    }
+}
+
+void SynthesisDaemonClient::messageReceived(const juce::MemoryBlock& message)
+{
+    const auto parsed_message = SynthesisDaemonProtocol::parseMessage(message);
+    const auto message_type = SynthesisDaemonProtocol::getMessageType(parsed_message);
+
+    if (message_type == "metadata")
+    {
+        std::function<void()> on_metadata_received;
+        {
+            const juce::ScopedLock scoped_lock(lock);
+            metadata = SynthesisDaemonProtocol::parseMetadata(parsed_message);
+            on_metadata_received = std::move(onMetadataReceivedCallback);
+        }
+
+        if (on_metadata_received != nullptr)
+        {
+            on_metadata_received();
+        }
+    }
+    else if (message_type == "rendered")
+    {
+        // Parsed even when cancelled, so that the shared memory file is removed.
+        const auto artefact = SynthesisDaemonProtocol::parseRenderedMessage(parsed_message);
+
+        PendingRequest pending_request;
+        {
+            const juce::ScopedLock scoped_lock(lock);
+            const auto it = pendingRequests.find(artefact.requestId.toString());
+            if (it == pendingRequests.end())
+            {
+                return;
+            }
+
+            pending_request = std::move(it->second);
+            pendingRequests.erase(it);
+        }
+
+        if (pending_request.cancellationToken != nullptr && pending_request.cancellationToken->isCancelled())
+        {
+            return;
+        }
+
+        pending_request.callback(artefact);
+    }
+}
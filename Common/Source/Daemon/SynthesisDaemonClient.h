@@ -0,0 +1,65 @@
+#pragma once
+
+#include <juce_events/juce_events.h>
+#include "Daemon/SynthesisDaemonProtocol.h"
+
+//==============================================================================
+// SynthesisDaemonClient
+//
+// Renders through a VoicevoxSynthesisDaemon running on the same machine, in
+// place of the engines in the plugin's own process. Requests go out over a
+// local socket and the rendered samples come back through shared memory.
+// Callbacks run on the connection's thread, like those of the request queue
+// run on its workers.
+//==============================================================================
+class SynthesisDaemonClient final
+    : private juce::InterprocessConnection
+{
+public:
+    //==============================================================================
+    using Callback = VoicevoxRequestQueue::Callback;
+
+    //==============================================================================
+    SynthesisDaemonClient();
+    ~SynthesisDaemonClient() override;
+
+    //==============================================================================
+    // The daemon's port, when the environment asks the plugins to render through it.
+    static std::optional<int> getPortFromEnvironment();
+
+    bool connect(int port);
+    using juce::InterprocessConnection::isConnected;
+
+    //==============================================================================
+    // onMetadataReceived runs on the connection's thread; the metadata is available from then on.
+    void requestMetadataAsync(std::function<void()> onMetadataReceived);
+    std::optional<SynthesisDaemonProtocol::Metadata> getMetadata() const;
+
+    // Same contract as VoicevoxRequestQueue::submit(). A cancelled request still renders in the daemon, but its callback is skipped.
+    // Requests pending when the connection is lost are called back without audio.
+    void submit(const cctn::VoicevoxEngineRequest& request, Callback callback, CancellationTokenPtr cancellationToken,
+                RequestPriority priority = RequestPriority::kInteractive,
+                std::optional<double> timelinePositionInSeconds = std::nullopt);
+
+private:
+    //==============================================================================
+    // juce::InterprocessConnection
+    void connectionMade() override;
+    void connectionLost() override;
+    void messageReceived(const juce::MemoryBlock& message) override;
+
+    //==============================================================================
+    struct PendingRequest
+    {
+        Callback callback;
+        CancellationTokenPtr cancellationToken;
+    };
+
+    //==============================================================================
+    mutable juce::CriticalSection lock;
+    std::map<juce::String, PendingRequest> pendingRequests;
+    std::optional<SynthesisDaemonProtocol::Metadata> metadata;
+    std::function<void()> onMetadataReceivedCallback;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SynthesisDaemonClient)
+};
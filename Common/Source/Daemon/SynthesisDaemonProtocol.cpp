@@ -0,0 +1,255 @@
+#include "SynthesisDaemonProtocol.h"
+
+namespace
+{
+    const juce::Identifier kType("type");
+    const juce::Identifier kRequestId("request_id");
+    const juce::Identifier kSpeakerId("speaker_id");
+    const juce::Identifier kProcessType("process_type");
+    const juce::Identifier kText("text");
+    const juce::Identifier kScoreJson("score_json");
+    const juce::Identifier kSampleRate("sample_rate");
+    const juce::Identifier kPriority("priority");
+    const juce::Identifier kTimelinePosition("timeline_position_sec");
+    const juce::Identifier kSharedMemoryFileName("shared_memory_file");
+    const juce::Identifier kNumChannels("num_channels");
+    const juce::Identifier kNumSamples("num_samples");
+    const juce::Identifier kMetaJson("meta_json");
+    const juce::Identifier kSpeakers("speakers");
+    const juce::Identifier kTalkSpeakers("talk_speakers");
+    const juce::Identifier kHummingSpeakers("humming_speakers");
+
+    const char* const kSharedMemoryFileExtension = ".pcm";
+
+    juce::String getSharedMemoryFileName(const juce::Uuid& requestId)
+    {
+        return requestId.toString() + kSharedMemoryFileExtension;
+    }
+
+    juce::MemoryBlock toMemoryBlock(juce::DynamicObject::Ptr message)
+    {
+        const auto message_json = juce::JSON::toString(juce::var(message.get()), true);
+        return juce::MemoryBlock(message_json.toRawUTF8(), message_json.getNumBytesAsUTF8());
+    }
+
+    juce::var toVar(const juce::StringArray& strings)
+    {
+        juce::Array<juce::var> values;
+        for (const auto& string : strings)
+        {
+            values.add(string);
+        }
+
+        return values;
+    }
+
+    juce::StringArray toStringArray(const juce::var& values)
+    {
+        juce::StringArray strings;
+        if (const auto* array = values.getArray())
+        {
+            for (const auto& value : *array)
+            {
+                strings.add(value.toString());
+            }
+        }
+
+        return strings;
+    }
+}
+
+//==============================================================================
+juce::MemoryBlock SynthesisDaemonProtocol::makeMetadataRequestMessage()
+{
+    juce::DynamicObject::Ptr message = new juce::DynamicObject();
+    message->setProperty(kType, "get_metadata");
+    return toMemoryBlock(message);
+}
+
+juce::MemoryBlock SynthesisDaemonProtocol::makeMetadataMessage(const Metadata& metadata)
+{
+    juce::DynamicObject::Ptr speakers = new juce::DynamicObject();
+    for (const auto& [speaker_identifier, speaker_id] : metadata.speakerIdentifierToSpeakerId)
+    {
+        speakers->setProperty(speaker_identifier, (juce::int64)speaker_id);
+    }
+
+    juce::DynamicObject::Ptr message = new juce::DynamicObject();
+    message->setProperty(kType, "metadata");
+    message->setProperty(kMetaJson, metadata.metaJson);
+    message->setProperty(kSpeakers, juce::var(speakers.get()));
+    message->setProperty(kTalkSpeakers, toVar(metadata.talkSpeakerIdentifierList));
+    message->setProperty(kHummingSpeakers, toVar(metadata.hummingSpeakerIdentifierList));
+    return toMemoryBlock(message);
+}
+
+SynthesisDaemonProtocol::Metadata SynthesisDaemonProtocol::parseMetadata(const juce::var& message)
+{
+    Metadata metadata;
+    metadata.metaJson = message.getProperty(kMetaJson, juce::var());
+    metadata.talkSpeakerIdentifierList = toStringArray(message.getProperty(kTalkSpeakers, juce::var()));
+    metadata.hummingSpeakerIdentifierList = toStringArray(message.getProperty(kHummingSpeakers, juce::var()));
+
+    if (const auto* speakers = message.getProperty(kSpeakers, juce::var()).getDynamicObject())
+    {
+        for (const auto& property : speakers->getProperties())
+        {
+            metadata.speakerIdentifierToSpeakerId[property.name.toString()] = (juce::uint32)(juce::int64)property.value;
+        }
+    }
+
+    return metadata;
+}
+
+//==============================================================================
+juce::MemoryBlock SynthesisDaemonProtocol::makeRenderMessage(const cctn::VoicevoxEngineRequest& request, RequestPriority priority, std::optional<double> timelinePositionInSeconds)
+{
+    juce::DynamicObject::Ptr message = new juce::DynamicObject();
+    message->setProperty(kType, "render");
+    message->setProperty(kRequestId, request.requestId.toString());
+    message->setProperty(kSpeakerId, (juce::int64)request.speakerId);
+    message->setProperty(kProcessType, request.processType == cctn::VoicevoxEngineProcessType::kHumming ? "humming" : "talk");
+    message->setProperty(kText, request.text);
+    message->setProperty(kScoreJson, request.scoreJson);
+    message->setProperty(kSampleRate, (double)request.sampleRate);
+    message->setProperty(kPriority, priority == RequestPriority::kBackground ? "background" : "interactive");
+
+    if (timelinePositionInSeconds.has_value())
+    {
+        message->setProperty(kTimelinePosition, timelinePositionInSeconds.value());
+    }
+
+    return toMemoryBlock(message);
+}
+
+cctn::VoicevoxEngineRequest SynthesisDaemonProtocol::parseRequest(const juce::var& message)
+{
+    cctn::VoicevoxEngineRequest request;
+    request.requestId = juce::Uuid(message.getProperty(kRequestId, juce::var()).toString());
+    request.speakerId = (juce::int64)message.getProperty(kSpeakerId, juce::var(0));
+    request.processType = message.getProperty(kProcessType, juce::var()).toString() == "humming" ? cctn::VoicevoxEngineProcessType::kHumming
+                                                                                                  : cctn::VoicevoxEngineProcessType::kTalk;
+    request.text = message.getProperty(kText, juce::var()).toString();
+    request.scoreJson = message.getProperty(kScoreJson, juce::var()).toString();
+    request.sampleRate = static_cast<decltype(request.sampleRate)>((double)message.getProperty(kSampleRate, juce::var(0.0)));
+
+    return request;
+}
+
+RequestPriority SynthesisDaemonProtocol::parsePriority(const juce::var& message)
+{
+    return message.getProperty(kPriority, juce::var()).toString() == "background" ? RequestPriority::kBackground
+                                                                                   : RequestPriority::kInteractive;
+}
+
+std::optional<double> SynthesisDaemonProtocol::parseTimelinePosition(const juce::var& message)
+{
+    const auto timeline_position = message.getProperty(kTimelinePosition, juce::var());
+    if (timeline_position.isVoid())
+    {
+        return std::nullopt;
+    }
+
+    return (double)timeline_position;
+}
+
+//==============================================================================
+juce::MemoryBlock SynthesisDaemonProtocol::makeRenderedMessage(const juce::Uuid& requestId, const std::optional<cctn::AudioBufferInfo>& audioBufferInfo)
+{
+    juce::DynamicObject::Ptr message = new juce::DynamicObject();
+    message->setProperty(kType, "rendered");
+    message->setProperty(kRequestId, requestId.toString());
+
+    if (!audioBufferInfo.has_value())
+    {
+        return toMemoryBlock(message);
+    }
+
+    const auto& audio_buffer = audioBufferInfo->audioBuffer;
+    const auto shared_memory_file = getSharedMemoryDirectory().getChildFile(getSharedMemoryFileName(requestId));
+
+    {
+        juce::FileOutputStream output_stream(shared_memory_file);
+        if (!output_stream.openedOk())
+        {
+            return toMemoryBlock(message);
+        }
+
+        // Planar, so the client takes each channel with a single copy.
+        for (int channel_idx = 0; channel_idx < audio_buffer.getNumChannels(); channel_idx++)
+        {
+            output_stream.write(audio_buffer.getReadPointer(channel_idx), (size_t)audio_buffer.getNumSamples() * sizeof(float));
+        }
+    }
+
+    message->setProperty(kSharedMemoryFileName, shared_memory_file.getFileName());
+    message->setProperty(kSampleRate, audioBufferInfo->sampleRate);
+    message->setProperty(kNumChannels, audio_buffer.getNumChannels());
+    message->setProperty(kNumSamples, audio_buffer.getNumSamples());
+    return toMemoryBlock(message);
+}
+
+cctn::VoicevoxEngineArtefact SynthesisDaemonProtocol::parseRenderedMessage(const juce::var& message)
+{
+    cctn::VoicevoxEngineArtefact artefact;
+    artefact.requestId = juce::Uuid(message.getProperty(kRequestId, juce::var()).toString());
+
+    // Only the file the daemon writes for this request, so the message cannot name any other file to read or delete.
+    const auto shared_memory_file_name = message.getProperty(kSharedMemoryFileName, juce::var()).toString();
+    if (artefact.requestId.isNull() || shared_memory_file_name != getSharedMemoryFileName(artefact.requestId))
+    {
+        return artefact;
+    }
+
+    const auto shared_memory_file = getSharedMemoryDirectory().getChildFile(shared_memory_file_name);
+    const auto num_channels = (int)message.getProperty(kNumChannels, juce::var(0));
+    const auto num_samples = (int)message.getProperty(kNumSamples, juce::var(0));
+    const auto num_bytes_per_channel = (size_t)num_samples * sizeof(float);
+
+    if (num_channels > 0 && num_samples >= 0)
+    {
+        const juce::MemoryMappedFile mapped_file(shared_memory_file, juce::MemoryMappedFile::readOnly);
+        if (mapped_file.getData() != nullptr && mapped_file.getSize() >= num_bytes_per_channel * (size_t)num_channels)
+        {
+            cctn::AudioBufferInfo audio_buffer_info;
+            audio_buffer_info.sampleRate = (double)message.getProperty(kSampleRate, juce::var(0.0));
+            audio_buffer_info.audioBuffer.setSize(num_channels, num_samples);
+
+            const auto* source = static_cast<const char*>(mapped_file.getData());
+            for (int channel_idx = 0; channel_idx < num_channels; channel_idx++)
+            {
+                std::memcpy(audio_buffer_info.audioBuffer.getWritePointer(channel_idx), source + num_bytes_per_channel * (size_t)channel_idx, num_bytes_per_channel);
+            }
+
+            artefact.audioBufferInfo = std::move(audio_buffer_info);
+        }
+    }
+
+    shared_memory_file.deleteFile();
+
+    return artefact;
+}
+
+//==============================================================================
+juce::var SynthesisDaemonProtocol::parseMessage(const juce::MemoryBlock& message)
+{
+    return juce::JSON::parse(message.toString());
+}
+
+juce::String SynthesisDaemonProtocol::getMessageType(const juce::var& message)
+{
+    return message.getProperty(kType, juce::var()).toString();
+}
+
+//==============================================================================
+juce::File SynthesisDaemonProtocol::getSharedMemoryDirectory()
+{
+    // tmpfs, so the samples never touch the disk; elsewhere the temp directory is usually kept in the page cache.
+    const juce::File dev_shm_directory("/dev/shm");
+    const auto base_directory = dev_shm_directory.isDirectory() ? dev_shm_directory : juce::File::getSpecialLocation(juce::File::tempDirectory);
+
+    auto shared_memory_directory = base_directory.getChildFile("VoicevoxSynthesisDaemon");
+    shared_memory_directory.createDirectory();
+
+    return shared_memory_directory;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <voicevox_juce_extra/voicevox_juce_extra.h>
+#include "Engine/EngineMetadataCache.h"
+#include "Engine/VoicevoxRequestQueue.h"
+
+//==============================================================================
+// SynthesisDaemonProtocol
+//
+// Messages exchanged between the plugins and VoicevoxSynthesisDaemon over a
+// local socket. Every message is a json object with a "type":
+// - "get_metadata" -> "metadata": the speaker lists and the engine meta json.
+// - "render" -> "rendered": one request. The rendered samples do not travel
+//   over the socket; the daemon writes them, planar float, to a file in the
+//   shared memory directory (tmpfs on Linux) and the reply carries its name
+//   and layout. The client maps the file, takes the samples and deletes it.
+//   The name must be the request id's, and the client only looks for it in
+//   its own shared memory directory, so a reply can never make it read or
+//   delete any other file.
+//==============================================================================
+namespace SynthesisDaemonProtocol
+{
+    //==============================================================================
+    constexpr int kDefaultPort = 50521;
+    constexpr int kConnectionTimeoutMs = 1000;
+
+    // Set to the daemon's port to make the plugins render through it.
+    const char* const kPortEnvironmentVariableName = "VOICEVOX_SYNTHESIS_DAEMON_PORT";
+
+    //==============================================================================
+    using Metadata = EngineMetadata;
+
+    //==============================================================================
+    juce::MemoryBlock makeMetadataRequestMessage();
+    juce::MemoryBlock makeMetadataMessage(const Metadata& metadata);
+    Metadata parseMetadata(const juce::var& message);
+
+    juce::MemoryBlock makeRenderMessage(const cctn::VoicevoxEngineRequest& request, RequestPriority priority, std::optional<double> timelinePositionInSeconds);
+    cctn::VoicevoxEngineRequest parseRequest(const juce::var& message);
+    RequestPriority parsePriority(const juce::var& message);
+    std::optional<double> parseTimelinePosition(const juce::var& message);
+
+    // Writes the audio to the shared memory directory; no file name in the message means the render failed.
+    juce::MemoryBlock makeRenderedMessage(const juce::Uuid& requestId, const std::optional<cctn::AudioBufferInfo>& audioBufferInfo);
+    // Takes the audio out of the shared memory file named in the message, and deletes the file.
+    // A file name other than the request's or an invalid layout carries no audio.
+    cctn::VoicevoxEngineArtefact parseRenderedMessage(const juce::var& message);
+
+    juce::var parseMessage(const juce::MemoryBlock& message);
+    juce::String getMessageType(const juce::var& message);
+
+    //==============================================================================
+    juce::File getSharedMemoryDirectory();
+}
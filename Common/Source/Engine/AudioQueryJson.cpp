@@ -0,0 +1,57 @@
+#include "AudioQueryJson.h"
+
+namespace
+{
+    const juce::Identifier kAccentPhrases("accent_phrases");
+    const juce::Identifier kPrePhonemeLength("prePhonemeLength");
+    const juce::Identifier kPostPhonemeLength("postPhonemeLength");
+}
+
+//==============================================================================
+std::optional<juce::String> AudioQueryJson::normalize(const juce::String& audioQueryJson)
+{
+    if (!audioQueryJson.trimStart().startsWithChar('{'))
+    {
+        return std::nullopt;
+    }
+
+    const auto audio_query = juce::JSON::parse(audioQueryJson);
+    if (audio_query.getDynamicObject() == nullptr || !audio_query.getProperty(kAccentPhrases, juce::var()).isArray())
+    {
+        return std::nullopt;
+    }
+
+    return juce::JSON::toString(audio_query, true);
+}
+
+bool AudioQueryJson::isAudioQuery(const juce::String& text)
+{
+    return normalize(text).has_value();
+}
+
+juce::String AudioQueryJson::trimPadding(const juce::String& audioQueryJson, bool trimsLeading, bool trimsTrailing)
+{
+    if (!trimsLeading && !trimsTrailing)
+    {
+        return audioQueryJson;
+    }
+
+    auto audio_query = juce::JSON::parse(audioQueryJson);
+    auto* audio_query_object = audio_query.getDynamicObject();
+    if (audio_query_object == nullptr)
+    {
+        return audioQueryJson;
+    }
+
+    if (trimsLeading)
+    {
+        audio_query_object->setProperty(kPrePhonemeLength, 0.0);
+    }
+
+    if (trimsTrailing)
+    {
+        audio_query_object->setProperty(kPostPhonemeLength, 0.0);
+    }
+
+    return juce::JSON::toString(audio_query, true);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+// AudioQueryJson
+//
+// The AudioQuery the core's audio_query returns and its synthesis takes: the
+// accent phrases and moras of the text, with the speaker's predicted pitch
+// and lengths, plus the global speed, pitch, intonation and volume scales.
+// - Only checked for its accent phrases; the core validates the rest.
+// - Normalized by re-serializing, so that formatting does not change cache keys.
+// - Sentences of one utterance are synthesized with their padding trimmed
+//   where they meet, so that they join without doubled silence.
+//==============================================================================
+class AudioQueryJson final
+{
+public:
+    //==============================================================================
+    // The normalized query, or nullopt when the text is not an AudioQuery.
+    static std::optional<juce::String> normalize(const juce::String& audioQueryJson);
+    static bool isAudioQuery(const juce::String& text);
+
+    // Zeroes the silence the core pads the start or end with; the query is returned as is when neither is trimmed.
+    static juce::String trimPadding(const juce::String& audioQueryJson, bool trimsLeading, bool trimsTrailing);
+
+private:
+    AudioQueryJson() = delete;
+};
@@ -0,0 +1,174 @@
+#include "EngineMetadataCache.h"
+
+namespace
+{
+    constexpr int kFileFormatVersion = 1;
+    const char* const kFileExtension = ".json";
+
+    const juce::Identifier kVersion("version");
+    const juce::Identifier kMetaJson("meta_json");
+    const juce::Identifier kSpeakers("speakers");
+    const juce::Identifier kTalkSpeakers("talk_speakers");
+    const juce::Identifier kHummingSpeakers("humming_speakers");
+
+    void appendFileFingerprint(juce::String& fingerprint, const juce::File& file, const juce::File& relativeTo)
+    {
+        fingerprint << file.getRelativePathFrom(relativeTo)
+                    << ":" << file.getSize()
+                    << ":" << file.getLastModificationTime().toMilliseconds() << "\n";
+    }
+
+    juce::var toVar(const juce::StringArray& strings)
+    {
+        juce::Array<juce::var> values;
+        for (const auto& string : strings)
+        {
+            values.add(string);
+        }
+
+        return values;
+    }
+
+    juce::StringArray toStringArray(const juce::var& values)
+    {
+        juce::StringArray strings;
+        if (const auto* array = values.getArray())
+        {
+            for (const auto& value : *array)
+            {
+                strings.add(value.toString());
+            }
+        }
+
+        return strings;
+    }
+}
+
+//==============================================================================
+EngineMetadataCache::EngineMetadataCache(const juce::File& engineDirectory)
+    : key(makeKey(engineDirectory))
+{
+}
+
+EngineMetadataCache::~EngineMetadataCache()
+{
+}
+
+//==============================================================================
+juce::File EngineMetadataCache::getDefaultEngineDirectory()
+{
+    // Inside a plugin this is the plugin binary, not the host.
+    return juce::File::getSpecialLocation(juce::File::currentExecutableFile).getParentDirectory();
+}
+
+juce::File EngineMetadataCache::getDefaultCacheDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("COCOTONE")
+        .getChildFile("VoicevoxJuceDemo")
+        .getChildFile("EngineCache");
+}
+
+//==============================================================================
+std::optional<EngineMetadata> EngineMetadataCache::load() const
+{
+    const auto cache_file = getCacheFile();
+    if (!cache_file.existsAsFile())
+    {
+        return std::nullopt;
+    }
+
+    const auto cached = juce::JSON::parse(cache_file);
+    if ((int)cached.getProperty(kVersion, juce::var(0)) != kFileFormatVersion)
+    {
+        return std::nullopt;
+    }
+
+    EngineMetadata metadata;
+    metadata.metaJson = cached.getProperty(kMetaJson, juce::var());
+    metadata.talkSpeakerIdentifierList = toStringArray(cached.getProperty(kTalkSpeakers, juce::var()));
+    metadata.hummingSpeakerIdentifierList = toStringArray(cached.getProperty(kHummingSpeakers, juce::var()));
+
+    const auto* speakers = cached.getProperty(kSpeakers, juce::var()).getDynamicObject();
+    if (speakers == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    for (const auto& property : speakers->getProperties())
+    {
+        metadata.speakerIdentifierToSpeakerId[property.name.toString()] = (juce::uint32)(juce::int64)property.value;
+    }
+
+    return metadata;
+}
+
+bool EngineMetadataCache::store(const EngineMetadata& metadata) const
+{
+    juce::DynamicObject::Ptr speakers = new juce::DynamicObject();
+    for (const auto& [speaker_identifier, speaker_id] : metadata.speakerIdentifierToSpeakerId)
+    {
+        speakers->setProperty(speaker_identifier, (juce::int64)speaker_id);
+    }
+
+    juce::DynamicObject::Ptr cached = new juce::DynamicObject();
+    cached->setProperty(kVersion, kFileFormatVersion);
+    cached->setProperty(kMetaJson, metadata.metaJson);
+    cached->setProperty(kSpeakers, juce::var(speakers.get()));
+    cached->setProperty(kTalkSpeakers, toVar(metadata.talkSpeakerIdentifierList));
+    cached->setProperty(kHummingSpeakers, toVar(metadata.hummingSpeakerIdentifierList));
+
+    const auto cache_file = getCacheFile();
+    if (!cache_file.getParentDirectory().createDirectory())
+    {
+        return false;
+    }
+
+    // Written aside and moved into place, so that another process never reads half a file.
+    juce::TemporaryFile temporary_file(cache_file);
+    if (!temporary_file.getFile().replaceWithText(juce::JSON::toString(juce::var(cached.get()))))
+    {
+        return false;
+    }
+
+    return temporary_file.overwriteTargetFileWithTemporary();
+}
+
+//==============================================================================
+juce::String EngineMetadataCache::makeKey(const juce::File& engineDirectory)
+{
+    juce::String fingerprint;
+
+    for (const auto& directory_name : { "model", "open_jtalk_dic_utf_8" })
+    {
+        auto files = engineDirectory.getChildFile(directory_name).findChildFiles(juce::File::findFiles, true);
+        files.sort();
+        for (const auto& file : files)
+        {
+            appendFileFingerprint(fingerprint, file, engineDirectory);
+        }
+    }
+
+    auto library_files = engineDirectory.findChildFiles(juce::File::findFiles, false);
+    library_files.sort();
+    for (const auto& file : library_files)
+    {
+        if (file.getFileName().containsIgnoreCase("voicevox_core") || file.getFileName().containsIgnoreCase("onnxruntime"))
+        {
+            appendFileFingerprint(fingerprint, file, engineDirectory);
+        }
+    }
+
+    fingerprint << juce::SystemStats::getCpuModel()
+                << ":avx=" << (int)juce::SystemStats::hasAVX()
+                << ":avx2=" << (int)juce::SystemStats::hasAVX2()
+                << ":avx512f=" << (int)juce::SystemStats::hasAVX512F()
+                << ":neon=" << (int)juce::SystemStats::hasNeon();
+
+    return juce::String::toHexString(fingerprint.hashCode64());
+}
+
+juce::File EngineMetadataCache::getCacheFile() const
+{
+    return getDefaultCacheDirectory().getChildFile(key + kFileExtension);
+}
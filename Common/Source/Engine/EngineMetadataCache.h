@@ -0,0 +1,56 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+// What a started engine reports about its voices.
+struct EngineMetadata
+{
+    juce::var metaJson;
+    std::map<juce::String, juce::uint32> speakerIdentifierToSpeakerId;
+    juce::StringArray talkSpeakerIdentifierList;
+    juce::StringArray hummingSpeakerIdentifierList;
+};
+
+//==============================================================================
+// EngineMetadataCache
+//
+// Keeps the metadata of the last engine start on disk, so that a later start
+// of the plugin (a host scanning plugins, or opening a project) has its
+// speaker lists without starting an engine and building its sessions.
+// Entries are keyed by a fingerprint of what the sessions are built from:
+// - the voice model and dictionary files,
+// - the voicevox_core and onnxruntime libraries, which stand in for the
+//   runtime version,
+// - the CPU model and the instruction sets it supports.
+// Any change to these produces a new key, so a stale entry is never read.
+//==============================================================================
+class EngineMetadataCache final
+{
+public:
+    //==============================================================================
+    // Fingerprints the files installed next to the given binary directory.
+    explicit EngineMetadataCache(const juce::File& engineDirectory);
+    ~EngineMetadataCache();
+
+    //==============================================================================
+    // The directory holding the plugin or executable, with the engine libraries and resources.
+    static juce::File getDefaultEngineDirectory();
+    static juce::File getDefaultCacheDirectory();
+
+    //==============================================================================
+    const juce::String& getKey() const noexcept { return key; }
+
+    std::optional<EngineMetadata> load() const;
+    bool store(const EngineMetadata& metadata) const;
+
+private:
+    //==============================================================================
+    static juce::String makeKey(const juce::File& engineDirectory);
+    juce::File getCacheFile() const;
+
+    //==============================================================================
+    const juce::String key;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EngineMetadataCache)
+};
@@ -0,0 +1,219 @@
+#include "InferenceScheduler.h"
+#include "VoicevoxRequestQueue.h"
+#include "Engine/SynthesisThreadPriority.h"
+
+namespace
+{
+    constexpr int kIdleWaitMs = 100;
+}
+
+//==============================================================================
+int InferenceScheduler::getDefaultCoreBudget(int numEngines)
+{
+    const auto core_budget = juce::SystemStats::getEnvironmentVariable(kCoreBudgetEnvironmentVariableName, {}).trim();
+    if (core_budget.isNotEmpty() && core_budget.containsOnly("0123456789"))
+    {
+        return juce::jmax(1, core_budget.getIntValue());
+    }
+
+    return juce::jmax(1, numEngines);
+}
+
+//==============================================================================
+InferenceScheduler::InferenceScheduler(VoicevoxEnginePool& enginePool, int coreBudgetToUse)
+    : enginePoolRef(enginePool)
+    , coreBudget(juce::jmax(1, coreBudgetToUse))
+    , totalRenderTimeMs(0.0)
+{
+    const int num_workers = juce::jmax(coreBudget.load(), enginePool.getNumEngines());
+    busyQueues.resize((size_t)num_workers, nullptr);
+
+    for (int worker_idx = 0; worker_idx < num_workers; worker_idx++)
+    {
+        workers.push_back(std::make_unique<Worker>(*this, worker_idx));
+    }
+
+    for (auto& worker : workers)
+    {
+        SynthesisThreadPriority::startThread(*worker);
+    }
+}
+
+InferenceScheduler::~InferenceScheduler()
+{
+    // Every queue unregisters itself before it is destroyed.
+    jassert(queues.empty());
+
+    for (auto& worker : workers)
+    {
+        worker->signalThreadShouldExit();
+        worker->notifyJobAvailable();
+    }
+
+    workers.clear();
+}
+
+//==============================================================================
+void InferenceScheduler::setCoreBudget(int newCoreBudget)
+{
+    coreBudget.store(juce::jlimit(1, (int)workers.size(), newCoreBudget));
+    notifyJobAvailable();
+}
+
+InferenceScheduler::Statistics InferenceScheduler::getStatistics() const
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    Statistics statistics;
+    statistics.coreBudget = coreBudget.load();
+    statistics.numQueues = (int)queues.size();
+    statistics.totalRenderTimeMs = totalRenderTimeMs;
+
+    return statistics;
+}
+
+double InferenceScheduler::getRenderTimeShare(const VoicevoxRequestQueue& queue) const
+{
+    double total_render_time_ms = 0.0;
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        total_render_time_ms = totalRenderTimeMs;
+    }
+
+    if (total_render_time_ms <= 0.0)
+    {
+        return 0.0;
+    }
+
+    return queue.getRenderTimeMs() / total_render_time_ms;
+}
+
+//==============================================================================
+void InferenceScheduler::addQueue(VoicevoxRequestQueue* queue)
+{
+    const juce::ScopedLock scoped_lock(lock);
+    queues.push_back(queue);
+}
+
+void InferenceScheduler::removeQueue(VoicevoxRequestQueue* queue)
+{
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        queues.erase(std::remove(queues.begin(), queues.end(), queue), queues.end());
+    }
+
+    while (true)
+    {
+        {
+            const juce::ScopedLock scoped_lock(lock);
+            if (std::find(busyQueues.begin(), busyQueues.end(), queue) == busyQueues.end())
+            {
+                return;
+            }
+        }
+
+        workFinishedEvent.wait(kIdleWaitMs);
+    }
+}
+
+void InferenceScheduler::notifyJobAvailable()
+{
+    // Wakes every idle worker; those finding nothing to do go back to waiting.
+    for (auto& worker : workers)
+    {
+        worker->notifyJobAvailable();
+    }
+}
+
+void InferenceScheduler::addRenderTime(double renderTimeMs)
+{
+    const juce::ScopedLock scoped_lock(lock);
+    totalRenderTimeMs += renderTimeMs;
+}
+
+//==============================================================================
+VoicevoxRequestQueue* InferenceScheduler::chooseQueue(int workerIndex)
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    VoicevoxRequestQueue* chosen_queue = nullptr;
+    RequestPriority chosen_priority = RequestPriority::kBackground;
+    double chosen_render_time_ms = 0.0;
+
+    for (auto* queue : queues)
+    {
+        const auto next_priority = queue->peekNextJobPriority();
+        if (!next_priority.has_value())
+        {
+            continue;
+        }
+
+        const auto render_time_ms = queue->getRenderTimeMs();
+        const bool is_better = chosen_queue == nullptr
+                               || next_priority.value() < chosen_priority
+                               || (next_priority.value() == chosen_priority && render_time_ms < chosen_render_time_ms);
+        if (is_better)
+        {
+            chosen_queue = queue;
+            chosen_priority = next_priority.value();
+            chosen_render_time_ms = render_time_ms;
+        }
+    }
+
+    busyQueues[(size_t)workerIndex] = chosen_queue;
+
+    return chosen_queue;
+}
+
+void InferenceScheduler::finishWork(int workerIndex)
+{
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        busyQueues[(size_t)workerIndex] = nullptr;
+    }
+
+    workFinishedEvent.signal();
+}
+
+//==============================================================================
+InferenceScheduler::Worker::Worker(InferenceScheduler& owner, int workerIndexToUse)
+    : juce::Thread("InferenceScheduler_" + juce::String(workerIndexToUse))
+    , ownerRef(owner)
+    , workerIndex(workerIndexToUse)
+{
+}
+
+InferenceScheduler::Worker::~Worker()
+{
+    // Rendering and waiting for an engine both give up once the thread is told to exit.
+    stopThread(-1);
+}
+
+void InferenceScheduler::Worker::notifyJobAvailable()
+{
+    jobAvailableEvent.signal();
+}
+
+void InferenceScheduler::Worker::run()
+{
+    SynthesisThreadPriority::applyToCurrentThread();
+
+    auto should_abort = [this] {
+        return threadShouldExit();
+    };
+
+    while (!threadShouldExit())
+    {
+        // Workers beyond the budget stay parked until it is raised again.
+        auto* queue = workerIndex < ownerRef.coreBudget.load() ? ownerRef.chooseQueue(workerIndex) : nullptr;
+        if (queue == nullptr)
+        {
+            jobAvailableEvent.wait(kIdleWaitMs);
+            continue;
+        }
+
+        const auto render_time_ms = queue->runNextJob(should_abort);
+        ownerRef.addRenderTime(render_time_ms);
+        ownerRef.finishWork(workerIndex);
+    }
+}
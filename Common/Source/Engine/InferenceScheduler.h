@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Engine/VoicevoxEnginePool.h"
+
+class VoicevoxRequestQueue;
+
+//==============================================================================
+// InferenceScheduler
+//
+// One fixed set of worker threads rendering the jobs of every
+// VoicevoxRequestQueue registered with it, so that the number of inferences
+// running at once stays within a single core budget however many plugin
+// instances there are.
+// - An idle worker takes the most urgent job over all queues: interactive
+//   before background and, within a class, from the queue that has used the
+//   least render time so far, so one instance rendering a long song does not
+//   starve the others.
+// - Workers beyond the core budget stay parked; the budget can be changed
+//   while running. It is independent of the number of engines: workers
+//   beyond the engines wait for one to be leased, and the
+//   VOICEVOX_SYNTHESIS_CORE_BUDGET environment variable sets it for the
+//   plugins.
+// - Render time is accounted per queue, which gives each instance its share
+//   of the inference CPU. The inference itself runs on the engine's threads,
+//   so the time an engine is leased for a queue is what gets measured.
+//==============================================================================
+class InferenceScheduler final
+{
+public:
+    //==============================================================================
+    struct Statistics
+    {
+        int coreBudget{ 0 };
+        int numQueues{ 0 };
+        double totalRenderTimeMs{ 0.0 };
+    };
+
+    //==============================================================================
+    static constexpr const char* kCoreBudgetEnvironmentVariableName = "VOICEVOX_SYNTHESIS_CORE_BUDGET";
+
+    // The budget set in the environment, or one per engine when it is not set.
+    static int getDefaultCoreBudget(int numEngines);
+
+    //==============================================================================
+    // Starts a worker for every core of the budget and at least one per engine,
+    // so that the budget can be raised to the engine count while running.
+    InferenceScheduler(VoicevoxEnginePool& enginePool, int coreBudget);
+    ~InferenceScheduler();
+
+    //==============================================================================
+    void setCoreBudget(int newCoreBudget);
+    int getCoreBudget() const noexcept { return coreBudget.load(); }
+
+    Statistics getStatistics() const;
+    // The queue's render time over that of every queue registered since the scheduler was created.
+    double getRenderTimeShare(const VoicevoxRequestQueue& queue) const;
+
+    VoicevoxEnginePool& getEnginePool() const noexcept { return enginePoolRef; }
+
+private:
+    //==============================================================================
+    friend class VoicevoxRequestQueue;
+
+    void addQueue(VoicevoxRequestQueue* queue);
+    // Waits until no worker renders a job of the queue any more.
+    void removeQueue(VoicevoxRequestQueue* queue);
+    void notifyJobAvailable();
+    void addRenderTime(double renderTimeMs);
+
+    //==============================================================================
+    class Worker final
+        : public juce::Thread
+    {
+    public:
+        Worker(InferenceScheduler& owner, int workerIndex);
+        ~Worker() override;
+
+        void run() override;
+
+        // Wakes the worker if it is waiting for a job.
+        void notifyJobAvailable();
+
+    private:
+        InferenceScheduler& ownerRef;
+        const int workerIndex;
+        // One per worker: a WaitableEvent wakes a single waiter per signal.
+        juce::WaitableEvent jobAvailableEvent;
+    };
+
+    //==============================================================================
+    // Picks the queue to serve next and marks the worker busy with it.
+    VoicevoxRequestQueue* chooseQueue(int workerIndex);
+    void finishWork(int workerIndex);
+
+    //==============================================================================
+    VoicevoxEnginePool& enginePoolRef;
+    std::atomic<int> coreBudget;
+
+    mutable juce::CriticalSection lock;
+    std::vector<VoicevoxRequestQueue*> queues;
+    // The queue each worker is rendering for, if any.
+    std::vector<VoicevoxRequestQueue*> busyQueues;
+    double totalRenderTimeMs;
+
+    juce::WaitableEvent workFinishedEvent;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(InferenceScheduler)
+};
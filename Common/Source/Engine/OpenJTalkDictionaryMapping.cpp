@@ -0,0 +1,56 @@
+#include "OpenJTalkDictionaryMapping.h"
+
+namespace
+{
+    const char* const kDictionaryDirectoryName = "open_jtalk_dic_utf_8";
+
+    // Smallest page size of the supported platforms; touching more often is harmless.
+    constexpr size_t kPageSizeInBytes = 4096;
+}
+
+//==============================================================================
+OpenJTalkDictionaryMapping::OpenJTalkDictionaryMapping(const juce::File& dictionaryDirectory)
+{
+    const auto map_start_time_ms = juce::Time::getMillisecondCounterHiRes();
+
+    for (const auto& dictionary_file : dictionaryDirectory.findChildFiles(juce::File::findFiles, false))
+    {
+        auto mapped_file = std::make_unique<juce::MemoryMappedFile>(dictionary_file, juce::MemoryMappedFile::readOnly);
+        if (mapped_file->getData() == nullptr)
+        {
+            continue;
+        }
+
+        loadInfo.numFiles++;
+        loadInfo.numBytes += mapped_file->getSize();
+        mappedFiles.push_back(std::move(mapped_file));
+    }
+
+    const auto touch_start_time_ms = juce::Time::getMillisecondCounterHiRes();
+    loadInfo.mapTimeMs = touch_start_time_ms - map_start_time_ms;
+
+    // One read per page faults the whole file in; the sum only keeps the reads from being optimised away.
+    unsigned int checksum = 0;
+    for (const auto& mapped_file : mappedFiles)
+    {
+        const auto* data = static_cast<const volatile unsigned char*>(mapped_file->getData());
+        for (size_t byte_idx = 0; byte_idx < mapped_file->getSize(); byte_idx += kPageSizeInBytes)
+        {
+            checksum += data[byte_idx];
+        }
+    }
+
+    loadInfo.touchTimeMs = juce::Time::getMillisecondCounterHiRes() - touch_start_time_ms;
+    juce::ignoreUnused(checksum);
+}
+
+OpenJTalkDictionaryMapping::~OpenJTalkDictionaryMapping()
+{
+}
+
+//==============================================================================
+juce::File OpenJTalkDictionaryMapping::getDefaultDictionaryDirectory()
+{
+    // Inside a plugin this is the plugin binary, not the host.
+    return juce::File::getSpecialLocation(juce::File::currentExecutableFile).getParentDirectory().getChildFile(kDictionaryDirectoryName);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+// OpenJTalkDictionaryMapping
+//
+// Maps the files of the Open JTalk dictionary read-only and touches every
+// page, before the first engine starts. The dictionary is already compiled
+// (sys.dic, matrix.bin, ...) and MeCab maps it rather than parsing it, so
+// what remains of the load is reading it from disk:
+// - The engine's own mapping of the same files then finds every page in the
+//   page cache instead of faulting them in from disk one at a time.
+// - The pages are file-backed, so they count as shared memory, held once by
+//   the OS for every instance and every process mapping the same files.
+// - The growth of the resident set while an engine starts no longer includes
+//   the dictionary, which keeps the per-engine estimate of the pool private.
+// Mappings are shared per file, so binaries using the same copy of the
+// dictionary share its pages; each format bundles its own copy.
+//==============================================================================
+class OpenJTalkDictionaryMapping final
+{
+public:
+    //==============================================================================
+    struct LoadInfo
+    {
+        int numFiles{ 0 };
+        size_t numBytes{ 0 };
+        double mapTimeMs{ 0.0 };
+        double touchTimeMs{ 0.0 };
+    };
+
+    //==============================================================================
+    explicit OpenJTalkDictionaryMapping(const juce::File& dictionaryDirectory);
+    ~OpenJTalkDictionaryMapping();
+
+    //==============================================================================
+    // Where the build places the dictionary, next to the plugin or executable.
+    static juce::File getDefaultDictionaryDirectory();
+
+    const LoadInfo& getLoadInfo() const noexcept { return loadInfo; }
+
+private:
+    //==============================================================================
+    std::vector<std::unique_ptr<juce::MemoryMappedFile>> mappedFiles;
+    LoadInfo loadInfo;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OpenJTalkDictionaryMapping)
+};
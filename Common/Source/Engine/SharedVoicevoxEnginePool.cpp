@@ -0,0 +1,141 @@
+#include "SharedVoicevoxEnginePool.h"
+#include "Metrics/ProcessMemory.h"
+
+namespace
+{
+    // Long enough to cover a host deleting and recreating its plugins, short enough to free the models soon after.
+    constexpr int kGracePeriodInSeconds = 30;
+
+    // Engines start on the first request; those beyond the budget or left idle are stopped again.
+    constexpr size_t kEngineMemoryBudgetInBytes = (size_t)2048 * 1024 * 1024;
+    constexpr int kEngineIdleTimeoutInSeconds = 300;
+}
+
+//==============================================================================
+SharedVoicevoxEnginePool::Reference::Reference()
+{
+    pool = &SharedVoicevoxEnginePool::getInstance()->addReference(scheduler);
+}
+
+SharedVoicevoxEnginePool::Reference::~Reference()
+{
+    SharedVoicevoxEnginePool::getInstance()->removeReference();
+}
+
+//==============================================================================
+JUCE_IMPLEMENT_SINGLETON(SharedVoicevoxEnginePool)
+
+SharedVoicevoxEnginePool::SharedVoicevoxEnginePool()
+    : juce::Thread("SharedVoicevoxEnginePool")
+    , numReferences(0)
+    , lastReferenceRemovedTimeMs(0.0)
+{
+    startThread();
+}
+
+SharedVoicevoxEnginePool::~SharedVoicevoxEnginePool()
+{
+    // Every processor is gone by the time JUCE shuts down.
+    jassert(numReferences == 0);
+
+    stopThread(-1);
+
+    scheduler.reset();
+
+    if (pool != nullptr)
+    {
+        pool->shutdown();
+        pool.reset();
+    }
+
+    clearSingletonInstance();
+}
+
+//==============================================================================
+int SharedVoicevoxEnginePool::getNumReferences() const
+{
+    const juce::ScopedLock scoped_lock(lock);
+    return numReferences;
+}
+
+//==============================================================================
+void SharedVoicevoxEnginePool::run()
+{
+    while (!threadShouldExit())
+    {
+        int wait_time_ms = -1;
+        {
+            const juce::ScopedLock scoped_lock(lock);
+            if (pool != nullptr && numReferences == 0)
+            {
+                const auto remaining_time_ms = kGracePeriodInSeconds * 1000.0 - (juce::Time::getMillisecondCounterHiRes() - lastReferenceRemovedTimeMs);
+                if (remaining_time_ms > 0.0)
+                {
+                    wait_time_ms = juce::jmax(1, (int)remaining_time_ms);
+                }
+                else
+                {
+                    // Torn down under the lock, so a processor created meanwhile waits for it and then starts a fresh pool.
+                    scheduler.reset();
+                    pool->shutdown();
+                    pool.reset();
+
+                    juce::Logger::outputDebugString("[SharedVoicevoxEnginePool] pool shut down after the grace period, resident: "
+                                                    + ProcessMemory::formatBytes(ProcessMemory::getResidentSetSizeInBytes()));
+                }
+            }
+        }
+
+        wait(wait_time_ms);
+    }
+}
+
+//==============================================================================
+VoicevoxEnginePool& SharedVoicevoxEnginePool::addReference(InferenceScheduler*& schedulerToUse)
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    if (pool == nullptr)
+    {
+        pool = std::make_unique<VoicevoxEnginePool>(VoicevoxEnginePool::getDefaultNumEngines());
+
+        // Set once here rather than by every processor, which would reset settings of the shared pool such as mapDictionary.
+        auto pool_settings = pool->getSettings();
+        pool_settings.memoryBudgetInBytes = kEngineMemoryBudgetInBytes;
+        pool_settings.idleTimeoutInSeconds = kEngineIdleTimeoutInSeconds;
+        pool_settings.modelVariant = VoicevoxModelVariants::getFromEnvironment();
+        pool->setSettings(pool_settings);
+        scheduler = std::make_unique<InferenceScheduler>(*pool, InferenceScheduler::getDefaultCoreBudget(pool->getNumEngines()));
+    }
+
+    schedulerToUse = scheduler.get();
+
+    numReferences++;
+
+    juce::Logger::outputDebugString("[SharedVoicevoxEnginePool] references: " + juce::String(numReferences)
+                                    + ", resident: " + ProcessMemory::formatBytes(ProcessMemory::getResidentSetSizeInBytes()));
+
+    return *pool;
+}
+
+void SharedVoicevoxEnginePool::removeReference()
+{
+    {
+        const juce::ScopedLock scoped_lock(lock);
+
+        jassert(numReferences > 0);
+        numReferences--;
+
+        if (numReferences > 0)
+        {
+            return;
+        }
+
+        lastReferenceRemovedTimeMs = juce::Time::getMillisecondCounterHiRes();
+
+        // A processor deleted right after it was created, as when a host scans plugins, does not start an engine.
+        pool->cancelWarmUp();
+    }
+
+    notify();
+}
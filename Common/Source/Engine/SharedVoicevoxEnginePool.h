@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Engine/InferenceScheduler.h"
+
+//==============================================================================
+// SharedVoicevoxEnginePool
+//
+// A single VoicevoxEnginePool shared by every processor loaded from the same
+// plugin binary, so that ten tracks do not hold ten copies of the voice
+// models and the dictionary.
+// - Each processor holds a Reference for its lifetime and keeps its own
+//   VoicevoxRequestQueue on top of the shared pool, so cancellation and
+//   priorities stay per instance while the engines are shared.
+// - The queues of all processors are rendered by one InferenceScheduler, so
+//   the instances together never run more inferences at once than the core
+//   budget allows.
+// - When the last reference is dropped, the pool stays loaded for a grace
+//   period before it is shut down, so a host that recreates its plugins
+//   (on a project reload, or when changing the sample rate) does not reload
+//   the models.
+// - The pool is shut down at the latest when JUCE shuts down.
+// - Its engines load the model variant named by VOICEVOX_MODEL_VARIANT, see
+//   VoicevoxModelVariants, since every instance renders on the same engines.
+// Unlike juce::SharedResourcePointer, the object outlives its last user for
+// the grace period, hence the singleton.
+//==============================================================================
+class SharedVoicevoxEnginePool final
+    : public juce::DeletedAtShutdown
+    , private juce::Thread
+{
+public:
+    //==============================================================================
+    // Keeps the shared pool alive; the pool is created by the first reference.
+    class Reference final
+    {
+    public:
+        Reference();
+        ~Reference();
+
+        VoicevoxEnginePool& operator*() const noexcept { return *pool; }
+        VoicevoxEnginePool* operator->() const noexcept { return pool; }
+
+        InferenceScheduler& getScheduler() const noexcept { return *scheduler; }
+
+    private:
+        VoicevoxEnginePool* pool{ nullptr };
+        InferenceScheduler* scheduler{ nullptr };
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Reference)
+    };
+
+    //==============================================================================
+    SharedVoicevoxEnginePool();
+    ~SharedVoicevoxEnginePool() override;
+
+    JUCE_DECLARE_SINGLETON(SharedVoicevoxEnginePool, false)
+
+    //==============================================================================
+    int getNumReferences() const;
+
+private:
+    //==============================================================================
+    // juce::Thread
+    void run() override;
+
+    //==============================================================================
+    // Returns the pool and sets scheduler to its scheduler.
+    VoicevoxEnginePool& addReference(InferenceScheduler*& scheduler);
+    void removeReference();
+
+    //==============================================================================
+    mutable juce::CriticalSection lock;
+    std::unique_ptr<VoicevoxEnginePool> pool;
+    std::unique_ptr<InferenceScheduler> scheduler;
+    int numReferences;
+    double lastReferenceRemovedTimeMs;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedVoicevoxEnginePool)
+};
@@ -0,0 +1,110 @@
+#include "SynthesisRequestRouter.h"
+#include "Engine/SharedVoicevoxEnginePool.h"
+#include "Metrics/ProcessMemory.h"
+
+namespace
+{
+    juce::String formatPercentiles(const LatencyRecorder::Percentiles& percentiles)
+    {
+        return juce::String(percentiles.p50Ms, 1) + "/" + juce::String(percentiles.p95Ms, 1) + "/" + juce::String(percentiles.p99Ms, 1) + " ms";
+    }
+}
+
+//==============================================================================
+SynthesisRequestRouter::SynthesisRequestRouter(VoicevoxRequestQueue& requestQueue, SynthesisCache& synthesisCache, AudioQueryCache& audioQueryCache, SynthesisDaemonClient* daemonClient)
+    : requestQueueRef(requestQueue)
+    , synthesisCacheRef(synthesisCache)
+    , audioQueryCacheRef(audioQueryCache)
+    , daemonClientPtr(daemonClient)
+{
+}
+
+SynthesisRequestRouter::~SynthesisRequestRouter()
+{
+}
+
+//==============================================================================
+void SynthesisRequestRouter::submit(const cctn::VoicevoxEngineRequest& request, VoicevoxRequestQueue::Callback callback, CancellationTokenPtr cancellationToken,
+                                    RequestPriority priority, std::optional<double> timelinePositionInSeconds)
+{
+    if (daemonClientPtr != nullptr)
+    {
+        daemonClientPtr->submit(request, std::move(callback), std::move(cancellationToken), priority, timelinePositionInSeconds);
+        return;
+    }
+
+    requestQueueRef.submit(request, std::move(callback), std::move(cancellationToken), priority, timelinePositionInSeconds);
+}
+
+void SynthesisRequestRouter::submitSynthesis(const cctn::VoicevoxEngineRequest& request, const juce::String& audioQueryJson, VoicevoxRequestQueue::Callback callback,
+                                             CancellationTokenPtr cancellationToken,
+                                             RequestPriority priority, std::optional<double> timelinePositionInSeconds)
+{
+    requestQueueRef.submitSynthesis(request, audioQueryJson, std::move(callback), std::move(cancellationToken), priority, timelinePositionInSeconds);
+}
+
+void SynthesisRequestRouter::submitAudioQuery(const cctn::VoicevoxEngineRequest& request, VoicevoxRequestQueue::AudioQueryCallback callback,
+                                              CancellationTokenPtr cancellationToken,
+                                              RequestPriority priority, std::optional<double> timelinePositionInSeconds)
+{
+    requestQueueRef.submitAudioQuery(request, std::move(callback), std::move(cancellationToken), priority, timelinePositionInSeconds);
+}
+
+//==============================================================================
+juce::StringArray SynthesisRequestRouter::getStatisticsReport() const
+{
+    juce::StringArray report;
+
+    if (daemonClientPtr != nullptr)
+    {
+        report.add("[SynthesisRequestRouter] rendering through VoicevoxSynthesisDaemon");
+        return report;
+    }
+
+    const auto cache_statistics = synthesisCacheRef.getStatistics();
+    const auto queue_statistics = requestQueueRef.getStatistics();
+    report.add("[VoicevoxRequestQueue] cache hits: " + juce::String(cache_statistics.numHits)
+               + ", misses: " + juce::String(cache_statistics.numMisses)
+               + ", hit rate: " + juce::String(cache_statistics.getHitRate() * 100.0, 1) + " %"
+               + ", render time saved: " + juce::String(cache_statistics.savedRenderTimeMs, 1) + " ms"
+               + ", coalesced: " + juce::String(queue_statistics.numCoalesced)
+               + ", cancelled: " + juce::String(queue_statistics.numCancelled));
+
+    const auto audio_query_cache_statistics = audioQueryCacheRef.getStatistics();
+    report.add("[AudioQueryCache] hits: " + juce::String(audio_query_cache_statistics.numHits)
+               + ", misses: " + juce::String(audio_query_cache_statistics.numMisses)
+               + ", hit rate: " + juce::String(audio_query_cache_statistics.getHitRate() * 100.0, 1) + " %"
+               + ", frontend time saved: " + juce::String(audio_query_cache_statistics.savedFrontendTimeMs, 1) + " ms"
+               + ", queries made: " + juce::String(queue_statistics.numAudioQueries));
+    report.add("[VoicevoxRequestQueue] wait p50/p95/p99 interactive: " + formatPercentiles(queue_statistics.interactiveWaitTime)
+               + ", background: " + formatPercentiles(queue_statistics.backgroundWaitTime));
+
+    auto& scheduler = requestQueueRef.getScheduler();
+    const auto pool_statistics = scheduler.getEnginePool().getStatistics();
+    const auto resident_bytes = ProcessMemory::getResidentSetSizeInBytes();
+    report.add("[VoicevoxEnginePool] running: " + juce::String(pool_statistics.numRunning) + "/" + juce::String(pool_statistics.numEngines)
+               + ", per engine: " + ProcessMemory::formatBytes(pool_statistics.estimatedBytesPerEngine)
+               + ", resident: " + ProcessMemory::formatBytes(resident_bytes));
+
+    // Every instance in the process shares the engines, so their memory is split between them.
+    if (auto* shared_pool = SharedVoicevoxEnginePool::getInstanceWithoutCreating())
+    {
+        const auto num_instances = juce::jmax(1, shared_pool->getNumReferences());
+        report.add("[SharedVoicevoxEnginePool] instances: " + juce::String(num_instances)
+                   + ", resident per instance: " + ProcessMemory::formatBytes(resident_bytes / (size_t)num_instances));
+    }
+
+    // They share the inference workers too; this is the part of the render time spent on this queue.
+    report.add("[InferenceScheduler] core budget: " + juce::String(scheduler.getCoreBudget())
+               + ", render time share: " + juce::String(scheduler.getRenderTimeShare(requestQueueRef) * 100.0, 1) + " %");
+
+    return report;
+}
+
+void SynthesisRequestRouter::logStatistics() const
+{
+    for (const auto& line : getStatisticsReport())
+    {
+        juce::Logger::outputDebugString(line);
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Engine/VoicevoxRequestQueue.h"
+#include "Daemon/SynthesisDaemonClient.h"
+
+//==============================================================================
+// SynthesisRequestRouter
+//
+// Sends the engine requests of one processor to a VoicevoxSynthesisDaemon
+// when one is connected, and to the processor's own request queue on the
+// shared engines otherwise.
+// - AudioQuery requests and their synthesis always run on the processor's own
+//   queue: the daemon protocol carries engine requests only.
+// - Statistics of the cache, the queue, the engines and the scheduler are
+//   gathered on demand, typically once a render session has completed,
+//   rather than on every request.
+//==============================================================================
+class SynthesisRequestRouter final
+{
+public:
+    //==============================================================================
+    // The queue, the caches and the daemon client, if any, must outlive the router.
+    SynthesisRequestRouter(VoicevoxRequestQueue& requestQueue, SynthesisCache& synthesisCache, AudioQueryCache& audioQueryCache, SynthesisDaemonClient* daemonClient);
+    ~SynthesisRequestRouter();
+
+    //==============================================================================
+    // Same contract as VoicevoxRequestQueue::submit().
+    void submit(const cctn::VoicevoxEngineRequest& request, VoicevoxRequestQueue::Callback callback, CancellationTokenPtr cancellationToken,
+                RequestPriority priority = RequestPriority::kInteractive,
+                std::optional<double> timelinePositionInSeconds = std::nullopt);
+
+    // Same contract as VoicevoxRequestQueue::submitSynthesis().
+    void submitSynthesis(const cctn::VoicevoxEngineRequest& request, const juce::String& audioQueryJson, VoicevoxRequestQueue::Callback callback,
+                         CancellationTokenPtr cancellationToken,
+                         RequestPriority priority = RequestPriority::kInteractive,
+                         std::optional<double> timelinePositionInSeconds = std::nullopt);
+
+    // Same contract as VoicevoxRequestQueue::submitAudioQuery().
+    void submitAudioQuery(const cctn::VoicevoxEngineRequest& request, VoicevoxRequestQueue::AudioQueryCallback callback,
+                          CancellationTokenPtr cancellationToken,
+                          RequestPriority priority = RequestPriority::kInteractive,
+                          std::optional<double> timelinePositionInSeconds = std::nullopt);
+
+    bool isUsingDaemon() const noexcept { return daemonClientPtr != nullptr; }
+
+    //==============================================================================
+    // One line per component.
+    juce::StringArray getStatisticsReport() const;
+    void logStatistics() const;
+
+private:
+    //==============================================================================
+    VoicevoxRequestQueue& requestQueueRef;
+    SynthesisCache& synthesisCacheRef;
+    AudioQueryCache& audioQueryCacheRef;
+    SynthesisDaemonClient* daemonClientPtr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SynthesisRequestRouter)
+};
@@ -0,0 +1,102 @@
+#include "SynthesisThreadPriority.h"
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+#elif JUCE_MAC
+ #include <pthread.h>
+ #include <sys/qos.h>
+#elif JUCE_LINUX
+ #include <sys/resource.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#endif
+
+namespace
+{
+#if JUCE_LINUX
+    // Well below the host's normal threads, while still getting idle cores at once.
+    constexpr int kNiceValue = 10;
+#endif
+
+    std::atomic<bool> enabled{ true };
+
+    juce::uint32 readAffinityMask()
+    {
+        const auto reserved_cores = juce::StringArray::fromTokens(
+            juce::SystemStats::getEnvironmentVariable(SynthesisThreadPriority::kReservedCoresEnvironmentVariableName, {}), ",", "");
+
+        const int num_cores = juce::jmin(32, juce::SystemStats::getNumCpus());
+        juce::uint32 affinity_mask = num_cores >= 32 ? 0xffffffffu : ((1u << num_cores) - 1u);
+        bool has_reserved_core = false;
+
+        for (const auto& reserved_core : reserved_cores)
+        {
+            const auto core_index = reserved_core.trim().getIntValue();
+            if (reserved_core.trim().containsOnly("0123456789") && core_index < num_cores)
+            {
+                affinity_mask &= ~(1u << core_index);
+                has_reserved_core = true;
+            }
+        }
+
+        // Reserving every core would leave synthesis nowhere to run.
+        return has_reserved_core && affinity_mask != 0 ? affinity_mask : 0;
+    }
+}
+
+//==============================================================================
+void SynthesisThreadPriority::setEnabled(bool shouldBeEnabled)
+{
+    enabled.store(shouldBeEnabled);
+}
+
+bool SynthesisThreadPriority::isEnabled()
+{
+    return enabled.load();
+}
+
+juce::uint32 SynthesisThreadPriority::getAffinityMask()
+{
+    static const auto affinity_mask = readAffinityMask();
+    return affinity_mask;
+}
+
+//==============================================================================
+bool SynthesisThreadPriority::startThread(juce::Thread& thread)
+{
+    if (!isEnabled())
+    {
+        return thread.startThread();
+    }
+
+    if (const auto affinity_mask = getAffinityMask(); affinity_mask != 0)
+    {
+        thread.setAffinityMask(affinity_mask);
+    }
+
+    return thread.startThread(juce::Thread::Priority::low);
+}
+
+void SynthesisThreadPriority::applyToCurrentThread()
+{
+    thread_local bool applied = false;
+    if (applied || !isEnabled())
+    {
+        return;
+    }
+
+    applied = true;
+
+    if (const auto affinity_mask = getAffinityMask(); affinity_mask != 0)
+    {
+        juce::Thread::setCurrentThreadAffinityMask(affinity_mask);
+    }
+
+#if JUCE_WINDOWS
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+#elif JUCE_MAC
+    pthread_set_qos_class_self_np(QOS_CLASS_UTILITY, 0);
+#elif JUCE_LINUX
+    setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), kNiceValue);
+#endif
+}
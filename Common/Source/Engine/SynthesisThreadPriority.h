@@ -0,0 +1,42 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+// SynthesisThreadPriority
+//
+// Keeps synthesis out of the way of the host's audio callback.
+// - Every thread rendering, starting engines or reading ahead for playback
+//   runs below normal priority. On Linux, where JUCE priorities do not apply
+//   to normal threads, the thread's nice value is raised instead.
+// - The engine's own inference threads are not created here; they are
+//   lowered from within the first callback they run.
+// - Optionally the threads are kept off some cores, listed in the
+//   VOICEVOX_SYNTHESIS_RESERVED_CORES environment variable (e.g. "0,1"), so
+//   that a host pinning its audio callback to those cores keeps them to
+//   itself.
+//==============================================================================
+class SynthesisThreadPriority final
+{
+public:
+    //==============================================================================
+    static constexpr const char* kReservedCoresEnvironmentVariableName = "VOICEVOX_SYNTHESIS_RESERVED_CORES";
+
+    // Enabled by default; disabled only to measure the difference.
+    static void setEnabled(bool shouldBeEnabled);
+    static bool isEnabled();
+
+    // Bit n allows core n; 0, meaning any core, when no core is reserved.
+    static juce::uint32 getAffinityMask();
+
+    //==============================================================================
+    // Starts a thread below normal priority and off the reserved cores.
+    static bool startThread(juce::Thread& thread);
+
+    // To be called first thing on a synthesis thread, and from callbacks on
+    // threads created elsewhere. Only the first call on each thread has any effect.
+    static void applyToCurrentThread();
+
+private:
+    SynthesisThreadPriority() = delete;
+};
@@ -0,0 +1,780 @@
+#include "VoicevoxEnginePool.h"
+#include "Engine/SynthesisThreadPriority.h"
+#include "Metrics/ProcessMemory.h"
+
+namespace
+{
+    constexpr int kMaxDefaultNumEngines = 4;
+    constexpr int kNumCpusPerEngine = 4;
+    constexpr int kIdleCheckIntervalMs = 1000;
+    constexpr int kWarmUpCheckIntervalMs = 100;
+
+    // Long enough for a plugin scan to construct and delete the processor without starting an engine.
+    constexpr double kWarmUpDelayWithCachedMetadataMs = 2000.0;
+
+    // Short enough to be cheap, long enough to initialise every stage of the pipeline.
+    const char* const kWarmUpTalkText = "あ";
+    const char* const kWarmUpScoreJson = R"({"notes":[{"key":null,"frame_length":15,"lyric":""},{"key":60,"frame_length":15,"lyric":"ら"},{"key":null,"frame_length":15,"lyric":""}]})";
+}
+
+//==============================================================================
+VoicevoxEnginePool::Lease::Lease(VoicevoxEnginePool& poolToUse, int engineIndexToUse, cctn::VoicevoxEngine& engineToUse, juce::int64 speakerIdToUse)
+    : pool(&poolToUse)
+    , engineIndex(engineIndexToUse)
+    , engine(&engineToUse)
+    , speakerId(speakerIdToUse)
+{
+}
+
+VoicevoxEnginePool::Lease::Lease(Lease&& other) noexcept
+    : pool(std::exchange(other.pool, nullptr))
+    , engineIndex(std::exchange(other.engineIndex, -1))
+    , engine(std::exchange(other.engine, nullptr))
+    , speakerId(std::exchange(other.speakerId, -1))
+{
+}
+
+VoicevoxEnginePool::Lease& VoicevoxEnginePool::Lease::operator=(Lease&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        pool = std::exchange(other.pool, nullptr);
+        engineIndex = std::exchange(other.engineIndex, -1);
+        engine = std::exchange(other.engine, nullptr);
+        speakerId = std::exchange(other.speakerId, -1);
+    }
+
+    return *this;
+}
+
+VoicevoxEnginePool::Lease::~Lease()
+{
+    release();
+}
+
+void VoicevoxEnginePool::Lease::release()
+{
+    if (pool != nullptr)
+    {
+        pool->release(engineIndex, speakerId);
+    }
+
+    pool = nullptr;
+    engineIndex = -1;
+    engine = nullptr;
+}
+
+//==============================================================================
+VoicevoxEnginePool::VoicevoxEnginePool(int numEngines)
+    : juce::Thread("VoicevoxEnginePool")
+{
+    slots.resize((size_t)juce::jmax(1, numEngines));
+    for (auto& slot : slots)
+    {
+        slot.engine = std::make_unique<cctn::VoicevoxEngine>();
+    }
+
+    statistics.numEngines = (int)slots.size();
+
+    // Engines start and warm up on this thread.
+    SynthesisThreadPriority::startThread(*this);
+}
+
+VoicevoxEnginePool::~VoicevoxEnginePool()
+{
+    // Starting an engine cannot be interrupted, and killing the thread half way would be worse than waiting.
+    stopThread(-1);
+
+    // Destroying an engine may drop the callback of a render that was given up on, which releases
+    // its lease; the slots must still be there when it does.
+    for (auto& slot : slots)
+    {
+        slot.engine.reset();
+    }
+}
+
+//==============================================================================
+int VoicevoxEnginePool::getDefaultNumEngines()
+{
+    return juce::jlimit(1, kMaxDefaultNumEngines, juce::SystemStats::getNumCpus() / kNumCpusPerEngine);
+}
+
+void VoicevoxEnginePool::setSettings(const Settings& newSettings)
+{
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        settings = newSettings;
+    }
+
+    notify();
+}
+
+VoicevoxEnginePool::Settings VoicevoxEnginePool::getSettings() const
+{
+    const juce::ScopedLock scoped_lock(lock);
+    return settings;
+}
+
+//==============================================================================
+void VoicevoxEnginePool::start()
+{
+    for (int slot_idx = 0; slot_idx < (int)slots.size(); slot_idx++)
+    {
+        {
+            const juce::ScopedLock scoped_lock(lock);
+            if (slots[(size_t)slot_idx].isRunning || slots[(size_t)slot_idx].isLeased)
+            {
+                continue;
+            }
+
+            slots[(size_t)slot_idx].isLeased = true;
+        }
+
+        startSlot(slot_idx);
+        release(slot_idx, -1);
+    }
+}
+
+void VoicevoxEnginePool::stop()
+{
+    while (stopLeastRecentlyUsedIdleSlot([](const Slot&) { return true; }))
+    {
+    }
+}
+
+void VoicevoxEnginePool::shutdown()
+{
+    stopThread(-1);
+
+    for (auto& slot : slots)
+    {
+        slot.engine->shutdown();
+    }
+
+    const juce::ScopedLock scoped_lock(lock);
+    for (auto& slot : slots)
+    {
+        slot.isRunning = false;
+    }
+}
+
+void VoicevoxEnginePool::warmUpAsync()
+{
+    if (isWarmUpRequested.exchange(true))
+    {
+        return;
+    }
+
+    // Without cached metadata the caller has nothing to show until an engine has started, so there is no point in waiting.
+    const auto warm_up_delay_ms = loadCachedMetadata() ? kWarmUpDelayWithCachedMetadataMs : 0.0;
+    warmUpDueTimeMs.store(juce::Time::getMillisecondCounterHiRes() + warm_up_delay_ms);
+
+    isWarmUpPending.store(true);
+    notify();
+}
+
+void VoicevoxEnginePool::cancelWarmUp()
+{
+    if (isWarmUpPending.exchange(false))
+    {
+        isWarmUpRequested.store(false);
+    }
+}
+
+bool VoicevoxEnginePool::hasMetadata() const
+{
+    const juce::ScopedLock scoped_lock(lock);
+    return metadata.has_value();
+}
+
+bool VoicevoxEnginePool::loadCachedMetadata()
+{
+    if (hasMetadata())
+    {
+        return true;
+    }
+
+    const auto load_start_time_ms = juce::Time::getMillisecondCounterHiRes();
+    auto cached_metadata = getMetadataCache().load();
+    if (!cached_metadata.has_value())
+    {
+        juce::Logger::outputDebugString("[VoicevoxEnginePool] no cached metadata for " + getMetadataCache().getKey());
+        return false;
+    }
+
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        if (metadata.has_value())
+        {
+            return true;
+        }
+
+        metadata = std::move(cached_metadata);
+        statistics.isMetadataFromCache = true;
+    }
+
+    juce::Logger::outputDebugString("[VoicevoxEnginePool] metadata read from cache in "
+                                    + juce::String(juce::Time::getMillisecondCounterHiRes() - load_start_time_ms, 1) + " ms");
+
+    notifyMetadataAvailable();
+    return true;
+}
+
+void VoicevoxEnginePool::addListener(Listener* listener)
+{
+    const juce::ScopedLock scoped_lock(listenerLock);
+    listeners.add(listener);
+}
+
+void VoicevoxEnginePool::removeListener(Listener* listener)
+{
+    const juce::ScopedLock scoped_lock(listenerLock);
+    listeners.remove(listener);
+}
+
+//==============================================================================
+VoicevoxEnginePool::Lease VoicevoxEnginePool::acquire(juce::int64 speakerId, std::function<bool()> shouldAbort)
+{
+    while (true)
+    {
+        int slot_index = -1;
+        bool needs_start = false;
+        {
+            const juce::ScopedLock scoped_lock(lock);
+
+            slot_index = findIdleSlot(speakerId);
+            if (slot_index < 0 && canStartAnotherEngine())
+            {
+                slot_index = findStoppedSlot();
+                needs_start = slot_index >= 0;
+            }
+
+            if (slot_index >= 0)
+            {
+                slots[(size_t)slot_index].isLeased = true;
+            }
+        }
+
+        if (slot_index >= 0)
+        {
+            if (needs_start)
+            {
+                startSlot(slot_index);
+            }
+
+            return Lease(*this, slot_index, *slots[(size_t)slot_index].engine.get(), speakerId);
+        }
+
+        // An idle engine of the previous variant makes room for one of the current variant.
+        if (stopIdleSlotOfOtherModelVariant())
+        {
+            continue;
+        }
+
+        if (shouldAbort != nullptr && shouldAbort())
+        {
+            return Lease();
+        }
+
+        slotReleasedEvent.wait(50);
+    }
+}
+
+std::optional<OpenJTalkDictionaryMapping::LoadInfo> VoicevoxEnginePool::getDictionaryLoadInfo() const
+{
+    const juce::ScopedLock scoped_lock(dictionaryLock);
+    if (dictionaryMapping == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    return dictionaryMapping->getLoadInfo();
+}
+
+VoicevoxEnginePool::Statistics VoicevoxEnginePool::getStatistics() const
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    auto current_statistics = statistics;
+    current_statistics.numRunning = getNumRunningSlots();
+    current_statistics.numLeased = (int)std::count_if(slots.begin(), slots.end(), [](const Slot& slot) { return slot.isLeased; });
+
+    return current_statistics;
+}
+
+//==============================================================================
+juce::var VoicevoxEnginePool::getMetaJson()
+{
+    return getMetadata().metaJson;
+}
+
+std::map<juce::String, juce::uint32> VoicevoxEnginePool::getSpeakerIdentifierToSpeakerIdMap()
+{
+    return getMetadata().speakerIdentifierToSpeakerId;
+}
+
+juce::StringArray VoicevoxEnginePool::getTalkSpeakerIdentifierList()
+{
+    return getMetadata().talkSpeakerIdentifierList;
+}
+
+juce::StringArray VoicevoxEnginePool::getHummingSpeakerIdentifierList()
+{
+    return getMetadata().hummingSpeakerIdentifierList;
+}
+
+//==============================================================================
+std::optional<cctn::VoicevoxEngineArtefact> VoicevoxEnginePool::renderAndWait(Lease lease,
+                                                                              const cctn::VoicevoxEngineRequest& request,
+                                                                              std::function<bool()> shouldAbort)
+{
+    jassert(lease);
+
+    // Shared with the engine callback, so the caller may stop waiting without leaving it dangling.
+    // The callback holds the lease: the engine is still rendering when the caller gives up, and
+    // must not be leased to anyone else until it is done.
+    struct Completion
+    {
+        juce::WaitableEvent finishedEvent;
+        cctn::VoicevoxEngineArtefact artefact;
+        Lease lease;
+    };
+    auto completion = std::make_shared<Completion>();
+    auto& engine = *lease;
+    completion->lease = std::move(lease);
+
+    engine.requestAsync(request,
+        [completion](const cctn::VoicevoxEngineArtefact& artefact) {
+            // The engine renders on threads of its own, which the first callback lowers as well.
+            if (!juce::MessageManager::existsAndIsCurrentThread())
+            {
+                SynthesisThreadPriority::applyToCurrentThread();
+            }
+
+            completion->artefact = artefact;
+            completion->lease.release();
+            completion->finishedEvent.signal();
+        });
+
+    while (!completion->finishedEvent.wait(50))
+    {
+        if (shouldAbort != nullptr && shouldAbort())
+        {
+            return std::nullopt;
+        }
+    }
+
+    return completion->artefact;
+}
+
+//==============================================================================
+void VoicevoxEnginePool::run()
+{
+    SynthesisThreadPriority::applyToCurrentThread();
+
+    while (!threadShouldExit())
+    {
+        if (isWarmUpPending.load() && juce::Time::getMillisecondCounterHiRes() >= warmUpDueTimeMs.load()
+            && isWarmUpPending.exchange(false))
+        {
+            runWarmUp();
+        }
+
+        wait(isWarmUpPending.load() ? kWarmUpCheckIntervalMs : kIdleCheckIntervalMs);
+
+        const auto idle_timeout_ms = getSettings().idleTimeoutInSeconds * 1000.0;
+        if (idle_timeout_ms > 0.0)
+        {
+            const auto now_ms = juce::Time::getMillisecondCounterHiRes();
+            while (!threadShouldExit()
+                   && stopLeastRecentlyUsedIdleSlot([&](const Slot& slot) { return now_ms - slot.lastUsedTimeMs > idle_timeout_ms; }))
+            {
+                const juce::ScopedLock scoped_lock(lock);
+                statistics.numIdleStops++;
+            }
+        }
+
+        while (!threadShouldExit() && isOverMemoryBudget()
+               && stopLeastRecentlyUsedIdleSlot([](const Slot&) { return true; }))
+        {
+            const juce::ScopedLock scoped_lock(lock);
+            statistics.numBudgetStops++;
+        }
+
+        while (!threadShouldExit() && stopIdleSlotOfOtherModelVariant())
+        {
+        }
+    }
+}
+
+//==============================================================================
+int VoicevoxEnginePool::findIdleSlot(juce::int64 speakerId) const
+{
+    // Same speaker first, then the most recently used, whose memory is most likely still warm.
+    int best_slot_index = -1;
+    for (int slot_idx = 0; slot_idx < (int)slots.size(); slot_idx++)
+    {
+        const auto& slot = slots[(size_t)slot_idx];
+        if (!slot.isRunning || slot.isLeased || slot.modelVariant != settings.modelVariant)
+        {
+            continue;
+        }
+
+        if (best_slot_index < 0)
+        {
+            best_slot_index = slot_idx;
+            continue;
+        }
+
+        const auto& best_slot = slots[(size_t)best_slot_index];
+        const bool is_same_speaker = slot.lastSpeakerId == speakerId;
+        const bool is_best_same_speaker = best_slot.lastSpeakerId == speakerId;
+
+        if (is_same_speaker != is_best_same_speaker)
+        {
+            if (is_same_speaker)
+            {
+                best_slot_index = slot_idx;
+            }
+        }
+        else if (slot.lastUsedTimeMs > best_slot.lastUsedTimeMs)
+        {
+            best_slot_index = slot_idx;
+        }
+    }
+
+    return best_slot_index;
+}
+
+int VoicevoxEnginePool::findStoppedSlot() const
+{
+    for (int slot_idx = 0; slot_idx < (int)slots.size(); slot_idx++)
+    {
+        if (!slots[(size_t)slot_idx].isRunning && !slots[(size_t)slot_idx].isLeased)
+        {
+            return slot_idx;
+        }
+    }
+
+    return -1;
+}
+
+bool VoicevoxEnginePool::canStartAnotherEngine() const
+{
+    const auto num_running = getNumRunningSlots();
+
+    // One engine always fits, and nothing is known about the size before the first one has started.
+    if (num_running == 0 || settings.memoryBudgetInBytes == 0 || statistics.estimatedBytesPerEngine == 0)
+    {
+        return true;
+    }
+
+    return (size_t)(num_running + 1) * statistics.estimatedBytesPerEngine <= settings.memoryBudgetInBytes;
+}
+
+int VoicevoxEnginePool::getNumRunningSlots() const
+{
+    // Engines being started count as running, so that concurrent starts respect the budget.
+    return (int)std::count_if(slots.begin(), slots.end(),
+        [](const Slot& slot) {
+            return slot.isRunning || slot.isLeased;
+        });
+}
+
+bool VoicevoxEnginePool::isOverMemoryBudget() const
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    if (settings.memoryBudgetInBytes == 0 || statistics.estimatedBytesPerEngine == 0)
+    {
+        return false;
+    }
+
+    const auto num_running = (size_t)std::count_if(slots.begin(), slots.end(), [](const Slot& slot) { return slot.isRunning; });
+    return num_running > 1 && num_running * statistics.estimatedBytesPerEngine > settings.memoryBudgetInBytes;
+}
+
+bool VoicevoxEnginePool::stopIdleSlotOfOtherModelVariant()
+{
+    const auto model_variant = getSettings().modelVariant;
+    if (!stopLeastRecentlyUsedIdleSlot([model_variant](const Slot& slot) { return slot.modelVariant != model_variant; }))
+    {
+        return false;
+    }
+
+    const juce::ScopedLock scoped_lock(lock);
+    statistics.numModelVariantStops++;
+
+    return true;
+}
+
+void VoicevoxEnginePool::mapDictionaryIfNeeded()
+{
+    if (!getSettings().mapDictionary)
+    {
+        return;
+    }
+
+    const juce::ScopedLock scoped_lock(dictionaryLock);
+    if (dictionaryMapping != nullptr)
+    {
+        return;
+    }
+
+    const auto resident_bytes_before = ProcessMemory::getResidentSetSizeInBytes();
+    dictionaryMapping = std::make_unique<OpenJTalkDictionaryMapping>(OpenJTalkDictionaryMapping::getDefaultDictionaryDirectory());
+    const auto resident_bytes_after = ProcessMemory::getResidentSetSizeInBytes();
+    const auto& load_info = dictionaryMapping->getLoadInfo();
+
+    juce::Logger::outputDebugString("[VoicevoxEnginePool] dictionary mapped: " + juce::String(load_info.numFiles) + " files, "
+                                    + ProcessMemory::formatBytes(load_info.numBytes)
+                                    + " in " + juce::String(load_info.mapTimeMs + load_info.touchTimeMs, 1) + " ms"
+                                    + ", resident +" + ProcessMemory::formatBytes(resident_bytes_after - juce::jmin(resident_bytes_before, resident_bytes_after))
+                                    + ", shared " + ProcessMemory::formatBytes(ProcessMemory::getSharedResidentSetSizeInBytes()));
+}
+
+void VoicevoxEnginePool::startSlot(int slotIndex)
+{
+    auto& engine = *slots[(size_t)slotIndex].engine.get();
+
+    mapDictionaryIfNeeded();
+
+    const auto model_variant = getSettings().modelVariant;
+    const auto engine_directory = EngineMetadataCache::getDefaultEngineDirectory();
+    auto loaded_model_variant = model_variant;
+    if (!VoicevoxModelVariants::isInstalled(engine_directory, model_variant))
+    {
+        juce::Logger::outputDebugString("[VoicevoxEnginePool] " + VoicevoxModelVariants::toString(model_variant)
+                                        + " models not installed, engine " + juce::String(slotIndex) + " loads the default models");
+        loaded_model_variant = VoicevoxModelVariant::kDefault;
+    }
+
+    engine.setModelDirectory(VoicevoxModelVariants::getModelDirectory(engine_directory, loaded_model_variant));
+
+    // Other engines may start or stop at the same time, so this is an estimate.
+    const auto resident_bytes_before = ProcessMemory::getResidentSetSizeInBytes();
+    const auto start_time_ms = juce::Time::getMillisecondCounterHiRes();
+    engine.start();
+    const auto start_duration_ms = juce::Time::getMillisecondCounterHiRes() - start_time_ms;
+    const auto resident_bytes_after = ProcessMemory::getResidentSetSizeInBytes();
+
+    std::optional<Metadata> started_engine_metadata;
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        if (!metadata.has_value())
+        {
+            started_engine_metadata = Metadata();
+        }
+    }
+
+    if (started_engine_metadata.has_value())
+    {
+        started_engine_metadata->metaJson = engine.getMetaJson();
+        started_engine_metadata->speakerIdentifierToSpeakerId = engine.getSpeakerIdentifierToSpeakerIdMap();
+        started_engine_metadata->talkSpeakerIdentifierList = engine.getTalkSpeakerIdentifierList();
+        started_engine_metadata->hummingSpeakerIdentifierList = engine.getHummingSpeakerIdentifierList();
+    }
+
+    {
+        const juce::ScopedLock scoped_lock(lock);
+
+        auto& slot = slots[(size_t)slotIndex];
+        slot.isRunning = true;
+        slot.lastUsedTimeMs = juce::Time::getMillisecondCounterHiRes();
+        // Kept as requested even after falling back, so the engine is not restarted for the same settings.
+        slot.modelVariant = model_variant;
+        statistics.numStarts++;
+
+        if (resident_bytes_after > resident_bytes_before)
+        {
+            statistics.estimatedBytesPerEngine = juce::jmax(statistics.estimatedBytesPerEngine, resident_bytes_after - resident_bytes_before);
+        }
+
+        statistics.lastStartDurationMs = start_duration_ms;
+
+        if (metadata.has_value())
+        {
+            started_engine_metadata.reset();
+        }
+        else if (started_engine_metadata.has_value())
+        {
+            metadata = started_engine_metadata;
+        }
+    }
+
+    juce::Logger::outputDebugString("[VoicevoxEnginePool] engine " + juce::String(slotIndex) + " started with the "
+                                    + VoicevoxModelVariants::toString(loaded_model_variant) + " models in "
+                                    + juce::String(start_duration_ms, 1) + " ms, resident "
+                                    + ProcessMemory::formatBytes(resident_bytes_after));
+
+    if (started_engine_metadata.has_value())
+    {
+        getMetadataCache().store(started_engine_metadata.value());
+        notifyMetadataAvailable();
+    }
+
+    // A fresh measurement may show that the engines already running no longer fit.
+    notify();
+}
+
+bool VoicevoxEnginePool::stopLeastRecentlyUsedIdleSlot(std::function<bool(const Slot& slot)> canStop)
+{
+    int slot_index = -1;
+    {
+        const juce::ScopedLock scoped_lock(lock);
+
+        for (int slot_idx = 0; slot_idx < (int)slots.size(); slot_idx++)
+        {
+            const auto& slot = slots[(size_t)slot_idx];
+            if (!slot.isRunning || slot.isLeased || !canStop(slot))
+            {
+                continue;
+            }
+
+            if (slot_index < 0 || slot.lastUsedTimeMs < slots[(size_t)slot_index].lastUsedTimeMs)
+            {
+                slot_index = slot_idx;
+            }
+        }
+
+        if (slot_index < 0)
+        {
+            return false;
+        }
+
+        slots[(size_t)slot_index].isLeased = true;
+    }
+
+    slots[(size_t)slot_index].engine->stop();
+
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        slots[(size_t)slot_index].isRunning = false;
+        slots[(size_t)slot_index].isLeased = false;
+    }
+
+    juce::Logger::outputDebugString("[VoicevoxEnginePool] engine " + juce::String(slot_index) + " stopped, resident "
+                                    + ProcessMemory::formatBytes(ProcessMemory::getResidentSetSizeInBytes()));
+
+    slotReleasedEvent.signal();
+
+    return true;
+}
+
+void VoicevoxEnginePool::release(int slotIndex, juce::int64 speakerId)
+{
+    {
+        const juce::ScopedLock scoped_lock(lock);
+
+        auto& slot = slots[(size_t)slotIndex];
+        slot.isLeased = false;
+        slot.lastUsedTimeMs = juce::Time::getMillisecondCounterHiRes();
+        slot.lastSpeakerId = speakerId;
+    }
+
+    slotReleasedEvent.signal();
+}
+
+const VoicevoxEnginePool::Metadata& VoicevoxEnginePool::getMetadata()
+{
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        if (metadata.has_value())
+        {
+            return metadata.value();
+        }
+    }
+
+    // Leasing an engine starts one when none is running, which captures the metadata.
+    acquire(-1).release();
+
+    const juce::ScopedLock scoped_lock(lock);
+    jassert(metadata.has_value());
+    return metadata.value();
+}
+
+EngineMetadataCache& VoicevoxEnginePool::getMetadataCache()
+{
+    const juce::ScopedLock scoped_lock(metadataCacheLock);
+    if (metadataCache == nullptr)
+    {
+        metadataCache = std::make_unique<EngineMetadataCache>(EngineMetadataCache::getDefaultEngineDirectory());
+    }
+
+    return *metadataCache;
+}
+
+void VoicevoxEnginePool::notifyMetadataAvailable()
+{
+    const juce::ScopedLock scoped_lock(listenerLock);
+    listeners.call([](Listener& listener) { listener.voicevoxEnginePoolMetadataAvailable(); });
+}
+
+void VoicevoxEnginePool::runWarmUp()
+{
+    auto should_abort = [this] {
+        return threadShouldExit();
+    };
+
+    // Only to start an engine and capture the metadata; each inference leases the engine again.
+    if (!acquire(-1, should_abort))
+    {
+        return;
+    }
+
+    const auto warm_up_start_time_ms = juce::Time::getMillisecondCounterHiRes();
+    const auto& engine_metadata = getMetadata();
+
+    auto find_first_speaker_id = [&engine_metadata](const juce::StringArray& speakerIdentifiers) -> std::optional<juce::int64> {
+        const auto it = engine_metadata.speakerIdentifierToSpeakerId.find(speakerIdentifiers[0]);
+        if (it == engine_metadata.speakerIdentifierToSpeakerId.end())
+        {
+            return std::nullopt;
+        }
+
+        return (juce::int64)it->second;
+    };
+
+    // One inference per pipeline, so the first real request of either kind skips session initialisation.
+    if (const auto talk_speaker_id = find_first_speaker_id(engine_metadata.talkSpeakerIdentifierList))
+    {
+        cctn::VoicevoxEngineRequest request;
+        request.requestId = juce::Uuid();
+        request.speakerId = talk_speaker_id.value();
+        request.text = juce::CharPointer_UTF8(kWarmUpTalkText);
+        request.processType = cctn::VoicevoxEngineProcessType::kTalk;
+        if (auto engine_lease = acquire(-1, should_abort))
+        {
+            renderAndWait(std::move(engine_lease), request, should_abort);
+        }
+    }
+
+    const auto humming_speaker_id = find_first_speaker_id(engine_metadata.hummingSpeakerIdentifierList);
+    if (humming_speaker_id.has_value() && !threadShouldExit())
+    {
+        cctn::VoicevoxEngineRequest request;
+        request.requestId = juce::Uuid();
+        request.speakerId = humming_speaker_id.value();
+        request.scoreJson = kWarmUpScoreJson;
+        request.sampleRate = 24000;
+        request.processType = cctn::VoicevoxEngineProcessType::kHumming;
+        if (auto engine_lease = acquire(-1, should_abort))
+        {
+            renderAndWait(std::move(engine_lease), request, should_abort);
+        }
+    }
+
+    if (threadShouldExit())
+    {
+        return;
+    }
+
+    juce::Logger::outputDebugString("[VoicevoxEnginePool] warm-up inference took "
+                                    + juce::String(juce::Time::getMillisecondCounterHiRes() - warm_up_start_time_ms, 1) + " ms");
+
+    ready.store(true);
+
+    const juce::ScopedLock scoped_lock(listenerLock);
+    listeners.call([](Listener& listener) { listener.voicevoxEnginePoolReady(); });
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <voicevox_juce_extra/voicevox_juce_extra.h>
+#include "Engine/EngineMetadataCache.h"
+#include "Engine/OpenJTalkDictionaryMapping.h"
+#include "Engine/VoicevoxModelVariant.h"
+
+//==============================================================================
+// VoicevoxEnginePool
+//
+// A bounded set of engines rendering side by side. Engines are started on
+// demand by the first request that needs one, instead of all at once:
+// - A request leases an idle running engine, preferring the one that last
+//   rendered the same speaker, and only starts another engine when none is
+//   idle and the memory budget allows it.
+// - The memory of an engine is measured from the growth of the resident set
+//   while it starts; running engines beyond the budget are stopped, least
+//   recently used first.
+// - Engines idle for longer than the idle timeout are stopped.
+// - Engines load the model variant of the settings. Changing it stops the
+//   engines running another variant as soon as they are idle, and requests
+//   only lease engines of the current one.
+// - warmUpAsync() starts the first engine in the background and runs a
+//   short inference on it, so that neither the caller nor the first real
+//   request waits for model loading and session initialisation. It only
+//   runs once, however many processors share the pool.
+// - The metadata of the first engine start is kept in an EngineMetadataCache.
+//   Later warm-ups read it from there right away, and only start the engine
+//   after a short delay, so that a host scanning plugins or opening a
+//   project gets the speaker lists without waiting for the sessions.
+// The engine loads its voice models as a whole when it starts, so an engine
+// instance is the unit of residency here.
+//==============================================================================
+class VoicevoxEnginePool final
+    : private juce::Thread
+{
+public:
+    //==============================================================================
+    struct Settings
+    {
+        // 0 means no limit.
+        size_t memoryBudgetInBytes{ 0 };
+        // 0 means engines are never stopped for being idle.
+        int idleTimeoutInSeconds{ 0 };
+        // Maps the dictionary before the first engine starts; see OpenJTalkDictionaryMapping.
+        bool mapDictionary{ true };
+        // Falls back to the default models when the variant is not installed; see VoicevoxModelVariants.
+        VoicevoxModelVariant modelVariant{ VoicevoxModelVariant::kDefault };
+    };
+
+    struct Statistics
+    {
+        int numEngines{ 0 };
+        int numRunning{ 0 };
+        int numLeased{ 0 };
+        size_t estimatedBytesPerEngine{ 0 };
+        juce::int64 numStarts{ 0 };
+        juce::int64 numIdleStops{ 0 };
+        juce::int64 numBudgetStops{ 0 };
+        juce::int64 numModelVariantStops{ 0 };
+        // Wall time of the latest engine start, which builds the inference sessions.
+        double lastStartDurationMs{ 0.0 };
+        bool isMetadataFromCache{ false };
+    };
+
+    //==============================================================================
+    class Listener
+    {
+    public:
+        virtual ~Listener() = default;
+
+        // Called on the pool's thread once the metadata is available, from the cache or a started engine.
+        virtual void voicevoxEnginePoolMetadataAvailable() {}
+
+        // Called on the pool's thread once the metadata is available and the warm-up inference has run.
+        virtual void voicevoxEnginePoolReady() = 0;
+    };
+
+    //==============================================================================
+    // Exclusive use of a running engine; released when destroyed.
+    class Lease final
+    {
+    public:
+        Lease() = default;
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        ~Lease();
+
+        cctn::VoicevoxEngine* get() const noexcept { return engine; }
+        cctn::VoicevoxEngine& operator*() const noexcept { return *engine; }
+        explicit operator bool() const noexcept { return engine != nullptr; }
+
+        void release();
+
+    private:
+        friend class VoicevoxEnginePool;
+        Lease(VoicevoxEnginePool& pool, int engineIndex, cctn::VoicevoxEngine& engine, juce::int64 speakerId);
+
+        VoicevoxEnginePool* pool{ nullptr };
+        int engineIndex{ -1 };
+        cctn::VoicevoxEngine* engine{ nullptr };
+        juce::int64 speakerId{ -1 };
+    };
+
+    //==============================================================================
+    explicit VoicevoxEnginePool(int numEngines);
+    ~VoicevoxEnginePool() override;
+
+    //==============================================================================
+    // Every engine holds its own models, so the default stays well below the core count.
+    static int getDefaultNumEngines();
+
+    void setSettings(const Settings& newSettings);
+    Settings getSettings() const;
+
+    //==============================================================================
+    // Starts every engine up front, for tools that use all of them right away.
+    void start();
+    // Stops every engine which is not leased.
+    void stop();
+    void shutdown();
+
+    // Listeners are notified when the warm-up has finished; does nothing once it has been requested.
+    void warmUpAsync();
+    // Drops a warm-up that has not started yet, for instances removed again right away.
+    void cancelWarmUp();
+    bool isReady() const noexcept { return ready.load(); }
+    bool hasMetadata() const;
+
+    // Reads the metadata from the cache when no engine has provided it yet. Returns true when it is available.
+    bool loadCachedMetadata();
+
+    // Once removeListener() returns, the listener is not being called any more.
+    void addListener(Listener* listener);
+    void removeListener(Listener* listener);
+
+    //==============================================================================
+    // Blocks until an engine is available, polling shouldAbort while waiting.
+    // Returns an empty lease when aborted.
+    Lease acquire(juce::int64 speakerId, std::function<bool()> shouldAbort = nullptr);
+
+    int getNumEngines() const noexcept { return (int)slots.size(); }
+    Statistics getStatistics() const;
+
+    // Set once the dictionary has been mapped.
+    std::optional<OpenJTalkDictionaryMapping::LoadInfo> getDictionaryLoadInfo() const;
+
+    //==============================================================================
+    // Engine metadata, captured when the first engine starts; starts one if none has yet.
+    juce::var getMetaJson();
+    std::map<juce::String, juce::uint32> getSpeakerIdentifierToSpeakerIdMap();
+    juce::StringArray getTalkSpeakerIdentifierList();
+    juce::StringArray getHummingSpeakerIdentifierList();
+
+    //==============================================================================
+    // Runs a request on the leased engine and waits for it, polling shouldAbort while waiting.
+    // Returns nullopt when aborted. The lease is handed to the engine callback and released
+    // only once the engine has finished, so an aborted render keeps its engine until then.
+    static std::optional<cctn::VoicevoxEngineArtefact> renderAndWait(Lease lease,
+                                                                     const cctn::VoicevoxEngineRequest& request,
+                                                                     std::function<bool()> shouldAbort = nullptr);
+
+private:
+    //==============================================================================
+    struct Slot
+    {
+        std::unique_ptr<cctn::VoicevoxEngine> engine;
+        bool isRunning{ false };
+        // Leased for rendering, or busy starting or stopping.
+        bool isLeased{ false };
+        double lastUsedTimeMs{ 0.0 };
+        juce::int64 lastSpeakerId{ -1 };
+        // The variant of the settings when the engine started.
+        VoicevoxModelVariant modelVariant{ VoicevoxModelVariant::kDefault };
+    };
+
+    using Metadata = EngineMetadata;
+
+    //==============================================================================
+    // juce::Thread
+    void run() override;
+
+    //==============================================================================
+    int findIdleSlot(juce::int64 speakerId) const;
+    int findStoppedSlot() const;
+    bool canStartAnotherEngine() const;
+    int getNumRunningSlots() const;
+    bool isOverMemoryBudget() const;
+    bool stopIdleSlotOfOtherModelVariant();
+    void mapDictionaryIfNeeded();
+    void startSlot(int slotIndex);
+    bool stopLeastRecentlyUsedIdleSlot(std::function<bool(const Slot& slot)> canStop);
+    void release(int slotIndex, juce::int64 speakerId);
+    const Metadata& getMetadata();
+    EngineMetadataCache& getMetadataCache();
+    void notifyMetadataAvailable();
+    void runWarmUp();
+
+    //==============================================================================
+    std::vector<Slot> slots;
+
+    mutable juce::CriticalSection lock;
+    juce::WaitableEvent slotReleasedEvent;
+    Settings settings;
+    Statistics statistics;
+    std::optional<Metadata> metadata;
+
+    // Separate from the lock, so that leasing engines does not wait for the dictionary to be read.
+    mutable juce::CriticalSection dictionaryLock;
+    std::unique_ptr<OpenJTalkDictionaryMapping> dictionaryMapping;
+
+    // Created on first use, since fingerprinting reads the engine directory.
+    juce::CriticalSection metadataCacheLock;
+    std::unique_ptr<EngineMetadataCache> metadataCache;
+
+    juce::CriticalSection listenerLock;
+    juce::ListenerList<Listener> listeners;
+    std::atomic<bool> isWarmUpRequested{ false };
+    std::atomic<bool> isWarmUpPending{ false };
+    std::atomic<double> warmUpDueTimeMs{ 0.0 };
+    std::atomic<bool> ready{ false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VoicevoxEnginePool)
+};
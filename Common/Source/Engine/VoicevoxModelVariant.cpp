@@ -0,0 +1,63 @@
+#include "VoicevoxModelVariant.h"
+
+//==============================================================================
+juce::String VoicevoxModelVariants::toString(VoicevoxModelVariant variant)
+{
+    switch (variant)
+    {
+    case VoicevoxModelVariant::kInt8:
+        return "int8";
+    case VoicevoxModelVariant::kFp16:
+        return "fp16";
+    case VoicevoxModelVariant::kDefault:
+    default:
+        return "default";
+    }
+}
+
+std::optional<VoicevoxModelVariant> VoicevoxModelVariants::fromString(const juce::String& name)
+{
+    for (const auto variant : { VoicevoxModelVariant::kDefault, VoicevoxModelVariant::kInt8, VoicevoxModelVariant::kFp16 })
+    {
+        if (name.trim().equalsIgnoreCase(toString(variant)))
+        {
+            return variant;
+        }
+    }
+
+    return std::nullopt;
+}
+
+VoicevoxModelVariant VoicevoxModelVariants::getFromEnvironment()
+{
+    const auto name = juce::SystemStats::getEnvironmentVariable(kEnvironmentVariableName, {});
+    if (name.isEmpty())
+    {
+        return VoicevoxModelVariant::kDefault;
+    }
+
+    const auto variant = fromString(name);
+    if (!variant.has_value())
+    {
+        juce::Logger::outputDebugString("[VoicevoxModelVariants] unknown variant " + name + ", using the default models");
+    }
+
+    return variant.value_or(VoicevoxModelVariant::kDefault);
+}
+
+//==============================================================================
+juce::File VoicevoxModelVariants::getModelDirectory(const juce::File& engineDirectory, VoicevoxModelVariant variant)
+{
+    if (variant == VoicevoxModelVariant::kDefault)
+    {
+        return engineDirectory.getChildFile("model");
+    }
+
+    return engineDirectory.getChildFile("model_" + toString(variant));
+}
+
+bool VoicevoxModelVariants::isInstalled(const juce::File& engineDirectory, VoicevoxModelVariant variant)
+{
+    const auto model_directory = getModelDirectory(engineDirectory, variant);
+    return model_directory.isDirectory() && model_directory.getNumberOfChildFiles(juce::File::findFiles) > 0;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+enum class VoicevoxModelVariant
+{
+    // The models installed with the engine.
+    kDefault = 0,
+    kInt8,
+    kFp16,
+};
+
+//==============================================================================
+// VoicevoxModelVariants
+//
+// Where the voice models of each variant are installed, next to the engine:
+// - "model" holds the default models, as copied by the build,
+// - "model_int8" and "model_fp16" hold the quantized and half precision
+//   exports of the same voices, when installed.
+// A variant that is not installed falls back to the default models.
+//==============================================================================
+class VoicevoxModelVariants final
+{
+public:
+    //==============================================================================
+    static constexpr const char* kEnvironmentVariableName = "VOICEVOX_MODEL_VARIANT";
+
+    static juce::String toString(VoicevoxModelVariant variant);
+    // "default", "int8" or "fp16"; nullopt for anything else.
+    static std::optional<VoicevoxModelVariant> fromString(const juce::String& name);
+
+    // From the environment variable, or the default models when unset or unknown.
+    static VoicevoxModelVariant getFromEnvironment();
+
+    //==============================================================================
+    static juce::File getModelDirectory(const juce::File& engineDirectory, VoicevoxModelVariant variant);
+    static bool isInstalled(const juce::File& engineDirectory, VoicevoxModelVariant variant);
+
+private:
+    VoicevoxModelVariants() = delete;
+};
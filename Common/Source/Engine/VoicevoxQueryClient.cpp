@@ -0,0 +1,45 @@
+#include "VoicevoxQueryClient.h"
+
+namespace
+{
+    bool loadModel(cctn::VoicevoxClient& client, juce::int64 speakerId)
+    {
+        const auto result = client.loadModel(speakerId);
+        if (result.failed())
+        {
+            juce::Logger::outputDebugString("[VoicevoxQueryClient] " + result.getErrorMessage());
+            return false;
+        }
+
+        return true;
+    }
+}
+
+//==============================================================================
+std::optional<juce::String> VoicevoxQueryClient::audioQuery(cctn::VoicevoxEngine& engine, juce::int64 speakerId, const juce::String& text)
+{
+    auto& client = engine.getClient();
+    if (!loadModel(client, speakerId))
+    {
+        return std::nullopt;
+    }
+
+    return client.audioQuery(speakerId, text);
+}
+
+cctn::VoicevoxEngineArtefact VoicevoxQueryClient::synthesis(cctn::VoicevoxEngine& engine, const juce::Uuid& requestId, juce::int64 speakerId, const juce::String& audioQueryJson)
+{
+    cctn::VoicevoxEngineArtefact artefact;
+    artefact.requestId = requestId;
+
+    auto& client = engine.getClient();
+    if (!loadModel(client, speakerId))
+    {
+        return artefact;
+    }
+
+    // Left as wav, like the engine's talk renders, so it is decoded after the lease has gone.
+    artefact.wavBinary = client.synthesis(speakerId, audioQueryJson);
+
+    return artefact;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <voicevox_juce_extra/voicevox_juce_extra.h>
+
+//==============================================================================
+// VoicevoxQueryClient
+//
+// The core's two step path on an engine: audio_query runs the text frontend
+// and the prosody prediction, synthesis runs the waveform decoder on the
+// resulting AudioQuery. An engine request runs both for every render; going
+// through here lets a query be cached, tuned or supplied by the caller.
+// - Both calls block, on a thread holding the engine's lease.
+// - The speaker's model is loaded on the first call for it.
+//==============================================================================
+class VoicevoxQueryClient final
+{
+public:
+    //==============================================================================
+    static std::optional<juce::String> audioQuery(cctn::VoicevoxEngine& engine, juce::int64 speakerId, const juce::String& text);
+
+    // The artefact carries the wav, or no audio when the query could not be synthesized.
+    static cctn::VoicevoxEngineArtefact synthesis(cctn::VoicevoxEngine& engine, const juce::Uuid& requestId, juce::int64 speakerId, const juce::String& audioQueryJson);
+
+private:
+    VoicevoxQueryClient() = delete;
+};
@@ -0,0 +1,459 @@
+#include "VoicevoxRequestQueue.h"
+#include "Engine/VoicevoxQueryClient.h"
+
+//==============================================================================
+bool VoicevoxRequestQueue::Job::hasActiveWaiter() const
+{
+    return std::any_of(waiters.begin(), waiters.end(),
+        [](const Waiter& waiter) {
+            return waiter.cancellationToken == nullptr || !waiter.cancellationToken->isCancelled();
+        });
+}
+
+//==============================================================================
+VoicevoxRequestQueue::VoicevoxRequestQueue(InferenceScheduler& scheduler, SynthesisCache& synthesisCache, AudioQueryCache& audioQueryCache)
+    : schedulerRef(scheduler)
+    , synthesisCacheRef(synthesisCache)
+    , audioQueryCacheRef(audioQueryCache)
+    , latestCancellationToken(std::make_shared<CancellationToken>())
+    , nextSequenceNumber(0)
+{
+    schedulerRef.addQueue(this);
+}
+
+VoicevoxRequestQueue::~VoicevoxRequestQueue()
+{
+    cancelAll();
+
+    isShuttingDown.store(true);
+    schedulerRef.removeQueue(this);
+}
+
+//==============================================================================
+CancellationTokenPtr VoicevoxRequestQueue::supersedePreviousRequests()
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    latestCancellationToken->cancel();
+    latestCancellationToken = std::make_shared<CancellationToken>();
+
+    return latestCancellationToken;
+}
+
+void VoicevoxRequestQueue::submit(const cctn::VoicevoxEngineRequest& request, Callback callback, CancellationTokenPtr cancellationToken,
+                                  RequestPriority priority, std::optional<double> timelinePositionInSeconds)
+{
+    if (cancellationToken != nullptr && cancellationToken->isCancelled())
+    {
+        return;
+    }
+
+    const auto key = SynthesisCache::makeKey(request);
+    if (const auto cached_entry = synthesisCacheRef.lookup(key))
+    {
+        callback(SynthesisCache::makeArtefact(request.requestId, cached_entry.value()));
+        return;
+    }
+
+    submitJob(key, request, Stage::kRender, {}, Waiter{ std::move(callback), nullptr, std::move(cancellationToken) }, priority, timelinePositionInSeconds);
+}
+
+void VoicevoxRequestQueue::submitSynthesis(const cctn::VoicevoxEngineRequest& request, const juce::String& audioQueryJson, Callback callback, CancellationTokenPtr cancellationToken,
+                                           RequestPriority priority, std::optional<double> timelinePositionInSeconds)
+{
+    if (cancellationToken != nullptr && cancellationToken->isCancelled())
+    {
+        return;
+    }
+
+    jassert(audioQueryJson.isNotEmpty());
+
+    const auto key = SynthesisCache::makeKey(request, audioQueryJson);
+    if (const auto cached_entry = synthesisCacheRef.lookup(key))
+    {
+        callback(SynthesisCache::makeArtefact(request.requestId, cached_entry.value()));
+        return;
+    }
+
+    submitJob(key, request, Stage::kSynthesis, audioQueryJson, Waiter{ std::move(callback), nullptr, std::move(cancellationToken) }, priority, timelinePositionInSeconds);
+}
+
+void VoicevoxRequestQueue::submitAudioQuery(const cctn::VoicevoxEngineRequest& request, AudioQueryCallback callback, CancellationTokenPtr cancellationToken,
+                                            RequestPriority priority, std::optional<double> timelinePositionInSeconds)
+{
+    if (cancellationToken != nullptr && cancellationToken->isCancelled())
+    {
+        return;
+    }
+
+    const auto key = AudioQueryCache::makeKey(request.speakerId, request.text);
+    if (const auto cached_entry = audioQueryCacheRef.lookup(key))
+    {
+        callback(cached_entry->audioQueryJson);
+        return;
+    }
+
+    submitJob(key, request, Stage::kAudioQuery, {}, Waiter{ nullptr, std::move(callback), std::move(cancellationToken) }, priority, timelinePositionInSeconds);
+}
+
+void VoicevoxRequestQueue::submitJob(const SynthesisCache::Key& key, const cctn::VoicevoxEngineRequest& request, Stage stage, const juce::String& audioQueryJson,
+                                     Waiter waiter, RequestPriority priority, std::optional<double> timelinePositionInSeconds)
+{
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        statistics.numSubmitted++;
+
+        // Single flight: an identical request already on its way just gains another waiter.
+        auto is_same_request = [&key](const std::shared_ptr<Job>& job) {
+            return job != nullptr && job->key.hash == key.hash && job->key.normalizedRequest == key.normalizedRequest;
+        };
+
+        const auto in_flight_it = std::find_if(inFlightJobs.begin(), inFlightJobs.end(), is_same_request);
+        if (in_flight_it != inFlightJobs.end())
+        {
+            (*in_flight_it)->waiters.push_back(std::move(waiter));
+            statistics.numCoalesced++;
+            return;
+        }
+
+        const auto pending_it = std::find_if(pendingJobs.begin(), pendingJobs.end(), is_same_request);
+        if (pending_it != pendingJobs.end())
+        {
+            auto& pending_job = *pending_it;
+            pending_job->waiters.push_back(std::move(waiter));
+
+            // A pending job takes the most urgent class of its waiters.
+            if (priority == RequestPriority::kInteractive)
+            {
+                pending_job->priority = RequestPriority::kInteractive;
+            }
+
+            statistics.numCoalesced++;
+            return;
+        }
+
+        auto job = std::make_shared<Job>();
+        job->key = key;
+        job->request = request;
+        job->stage = stage;
+        job->audioQueryJson = audioQueryJson;
+        job->waiters.push_back(std::move(waiter));
+        job->priority = priority;
+        job->timelinePositionInSeconds = timelinePositionInSeconds;
+        job->submittedTimeMs = juce::Time::getMillisecondCounterHiRes();
+        job->sequenceNumber = nextSequenceNumber++;
+        pendingJobs.push_back(std::move(job));
+    }
+
+    schedulerRef.notifyJobAvailable();
+}
+
+void VoicevoxRequestQueue::cancelAll()
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    latestCancellationToken->cancel();
+    latestCancellationToken = std::make_shared<CancellationToken>();
+
+    for (const auto& job : pendingJobs)
+    {
+        for (const auto& waiter : job->waiters)
+        {
+            if (waiter.cancellationToken != nullptr)
+            {
+                waiter.cancellationToken->cancel();
+            }
+        }
+    }
+
+    statistics.numCancelled += (juce::int64)pendingJobs.size();
+    pendingJobs.clear();
+}
+
+VoicevoxRequestQueue::Statistics VoicevoxRequestQueue::getStatistics() const
+{
+    Statistics current_statistics;
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        current_statistics = statistics;
+    }
+
+    current_statistics.interactiveWaitTime = interactiveWaitTimeRecorder.getPercentiles();
+    current_statistics.backgroundWaitTime = backgroundWaitTimeRecorder.getPercentiles();
+
+    return current_statistics;
+}
+
+double VoicevoxRequestQueue::getRenderTimeMs() const
+{
+    const juce::ScopedLock scoped_lock(lock);
+    return statistics.renderTimeMs;
+}
+
+void VoicevoxRequestQueue::setPlayheadPositionProvider(PlayheadPositionProvider provider)
+{
+    const juce::ScopedLock scoped_lock(lock);
+    playheadPositionProvider = std::move(provider);
+}
+
+//==============================================================================
+std::optional<RequestPriority> VoicevoxRequestQueue::peekNextJobPriority()
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    removeCancelledJobs();
+    if (pendingJobs.empty())
+    {
+        return std::nullopt;
+    }
+
+    const auto most_urgent_it = std::min_element(pendingJobs.begin(), pendingJobs.end(),
+        [](const std::shared_ptr<Job>& lhs, const std::shared_ptr<Job>& rhs) {
+            return lhs->priority < rhs->priority;
+        });
+
+    return (*most_urgent_it)->priority;
+}
+
+double VoicevoxRequestQueue::runNextJob(std::function<bool()> shouldAbort)
+{
+    auto job = takeNextJob();
+    if (job == nullptr)
+    {
+        return 0.0;
+    }
+
+    auto should_abort = [this, &shouldAbort] {
+        return isShuttingDown.load() || (shouldAbort != nullptr && shouldAbort());
+    };
+
+    // Starts an engine when none is idle, as long as the pool's memory budget allows.
+    auto engine_lease = schedulerRef.getEnginePool().acquire(job->request.speakerId, should_abort);
+    if (!engine_lease)
+    {
+        abandonJob(job);
+        return 0.0;
+    }
+
+    const auto render_start_time_ms = juce::Time::getMillisecondCounterHiRes();
+
+    if (job->stage == Stage::kAudioQuery)
+    {
+        // Blocks like synthesis does; the engine goes back before the waiters submit their next stage.
+        const auto audio_query = VoicevoxQueryClient::audioQuery(*engine_lease, job->request.speakerId, job->request.text);
+        engine_lease.release();
+
+        const auto frontend_time_ms = juce::Time::getMillisecondCounterHiRes() - render_start_time_ms;
+        {
+            const juce::ScopedLock scoped_lock(lock);
+            statistics.renderTimeMs += frontend_time_ms;
+        }
+
+        if (audio_query.has_value())
+        {
+            audioQueryCacheRef.store(job->key, { audio_query.value(), frontend_time_ms });
+        }
+
+        finishAudioQueryJob(job, audio_query);
+        return frontend_time_ms;
+    }
+
+    const auto artefact = renderJob(std::move(engine_lease), *job, should_abort);
+    const auto render_time_ms = juce::Time::getMillisecondCounterHiRes() - render_start_time_ms;
+
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        statistics.renderTimeMs += render_time_ms;
+    }
+
+    if (artefact.has_value())
+    {
+        finishJob(job, artefact.value(), render_time_ms);
+    }
+    else
+    {
+        abandonJob(job);
+    }
+
+    return render_time_ms;
+}
+
+std::optional<cctn::VoicevoxEngineArtefact> VoicevoxRequestQueue::renderJob(VoicevoxEnginePool::Lease engineLease, const Job& job, std::function<bool()> shouldAbort)
+{
+    if (job.stage == Stage::kRender)
+    {
+        return VoicevoxEnginePool::renderAndWait(std::move(engineLease), job.request, std::move(shouldAbort));
+    }
+
+    // The core's synthesis blocks this worker and cannot be aborted; the lease goes once it returns.
+    return VoicevoxQueryClient::synthesis(*engineLease, job.request.requestId, job.request.speakerId, job.audioQueryJson);
+}
+
+void VoicevoxRequestQueue::removeCancelledJobs()
+{
+    // Stage boundary: superseded jobs never reach the engine.
+    const auto num_jobs_before = pendingJobs.size();
+    pendingJobs.erase(std::remove_if(pendingJobs.begin(), pendingJobs.end(),
+                                     [](const std::shared_ptr<Job>& pending_job) { return !pending_job->hasActiveWaiter(); }),
+                      pendingJobs.end());
+    statistics.numCancelled += (juce::int64)(num_jobs_before - pendingJobs.size());
+}
+
+std::shared_ptr<VoicevoxRequestQueue::Job> VoicevoxRequestQueue::takeNextJob()
+{
+    std::shared_ptr<Job> job;
+    {
+        const juce::ScopedLock scoped_lock(lock);
+
+        removeCancelledJobs();
+        if (pendingJobs.empty())
+        {
+            return nullptr;
+        }
+
+        // The playhead is read once per dispatch, so the order follows it while the host plays.
+        const auto playhead_position = playheadPositionProvider != nullptr ? playheadPositionProvider() : std::nullopt;
+
+        const auto next_it = std::min_element(pendingJobs.begin(), pendingJobs.end(),
+            [this, &playhead_position](const std::shared_ptr<Job>& lhs, const std::shared_ptr<Job>& rhs) {
+                if (lhs->priority != rhs->priority)
+                {
+                    return lhs->priority < rhs->priority;
+                }
+
+                const auto lhs_distance = getSchedulingDistance(*lhs, playhead_position);
+                const auto rhs_distance = getSchedulingDistance(*rhs, playhead_position);
+                if (lhs_distance != rhs_distance)
+                {
+                    return lhs_distance < rhs_distance;
+                }
+
+                return lhs->sequenceNumber < rhs->sequenceNumber;
+            });
+
+        job = *next_it;
+        pendingJobs.erase(next_it);
+        inFlightJobs.push_back(job);
+    }
+
+    const auto wait_time_ms = juce::Time::getMillisecondCounterHiRes() - job->submittedTimeMs;
+    if (job->priority == RequestPriority::kInteractive)
+    {
+        interactiveWaitTimeRecorder.record(wait_time_ms);
+    }
+    else
+    {
+        backgroundWaitTimeRecorder.record(wait_time_ms);
+    }
+
+    return job;
+}
+
+double VoicevoxRequestQueue::getSchedulingDistance(const Job& job, std::optional<double> playheadPositionInSeconds) const
+{
+    // Jobs off the timeline, or without a known playhead, keep their submission order.
+    if (!job.timelinePositionInSeconds.has_value() || !playheadPositionInSeconds.has_value())
+    {
+        return 0.0;
+    }
+
+    const auto distance = job.timelinePositionInSeconds.value() - playheadPositionInSeconds.value();
+    if (distance >= 0.0)
+    {
+        return distance;
+    }
+
+    // Audio already behind the playhead is only heard again after a relocation, so it comes last.
+    return std::numeric_limits<double>::max() / 2.0 - distance;
+}
+
+void VoicevoxRequestQueue::finishJob(const std::shared_ptr<Job>& job, const cctn::VoicevoxEngineArtefact& artefact, double renderTimeMs)
+{
+    synthesisCacheRef.store(job->key, SynthesisCache::makeEntry(artefact, renderTimeMs));
+
+    std::vector<Waiter> waiters;
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        waiters = std::move(job->waiters);
+        inFlightJobs.erase(std::remove(inFlightJobs.begin(), inFlightJobs.end(), job), inFlightJobs.end());
+        statistics.numRendered++;
+    }
+
+    // Stage boundary: results of requests cancelled while rendering are dropped.
+    for (const auto& waiter : waiters)
+    {
+        if (waiter.cancellationToken == nullptr || !waiter.cancellationToken->isCancelled())
+        {
+            waiter.callback(artefact);
+        }
+        else
+        {
+            const juce::ScopedLock scoped_lock(lock);
+            statistics.numCancelled++;
+        }
+    }
+}
+
+void VoicevoxRequestQueue::finishAudioQueryJob(const std::shared_ptr<Job>& job, const std::optional<juce::String>& audioQueryJson)
+{
+    std::vector<Waiter> waiters;
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        waiters = std::move(job->waiters);
+        inFlightJobs.erase(std::remove(inFlightJobs.begin(), inFlightJobs.end(), job), inFlightJobs.end());
+        statistics.numAudioQueries++;
+    }
+
+    for (const auto& waiter : waiters)
+    {
+        if (waiter.cancellationToken == nullptr || !waiter.cancellationToken->isCancelled())
+        {
+            waiter.audioQueryCallback(audioQueryJson);
+        }
+        else
+        {
+            const juce::ScopedLock scoped_lock(lock);
+            statistics.numCancelled++;
+        }
+    }
+}
+
+void VoicevoxRequestQueue::abandonJob(const std::shared_ptr<Job>& job)
+{
+    std::vector<Waiter> waiters;
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        waiters = std::move(job->waiters);
+        inFlightJobs.erase(std::remove(inFlightJobs.begin(), inFlightJobs.end(), job), inFlightJobs.end());
+    }
+
+    // While shutting down the waiters' owners are going away, so they are only cancelled.
+    // Otherwise they get an artefact without audio, as for a failed render, and their sessions still complete.
+    cctn::VoicevoxEngineArtefact empty_artefact;
+    empty_artefact.requestId = job->request.requestId;
+
+    for (const auto& waiter : waiters)
+    {
+        const bool is_active = waiter.cancellationToken == nullptr || !waiter.cancellationToken->isCancelled();
+        if (is_active && !isShuttingDown.load())
+        {
+            if (job->stage == Stage::kAudioQuery)
+            {
+                waiter.audioQueryCallback(std::nullopt);
+            }
+            else
+            {
+                waiter.callback(empty_artefact);
+            }
+            continue;
+        }
+
+        if (waiter.cancellationToken != nullptr)
+        {
+            waiter.cancellationToken->cancel();
+        }
+
+        const juce::ScopedLock scoped_lock(lock);
+        statistics.numCancelled++;
+    }
+}
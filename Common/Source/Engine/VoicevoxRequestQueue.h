@@ -0,0 +1,188 @@
+#pragma once
+
+#include <voicevox_juce_extra/voicevox_juce_extra.h>
+#include "Cache/AudioQueryCache.h"
+#include "Cache/SynthesisCache.h"
+#include "Engine/InferenceScheduler.h"
+#include "Metrics/LatencyRecorder.h"
+
+//==============================================================================
+// CancellationToken
+//==============================================================================
+class CancellationToken final
+{
+public:
+    void cancel() noexcept { cancelled.store(true); }
+    bool isCancelled() const noexcept { return cancelled.load(); }
+
+private:
+    std::atomic<bool> cancelled{ false };
+};
+
+using CancellationTokenPtr = std::shared_ptr<CancellationToken>;
+
+//==============================================================================
+enum class RequestPriority
+{
+    kInteractive = 0,
+    kBackground,
+};
+
+//==============================================================================
+// VoicevoxRequestQueue
+//
+// Holds the requests of one client, typically a plugin instance, until the
+// workers of an InferenceScheduler render them. The scheduler is shared with
+// other clients, so independent requests render concurrently within one core
+// budget. Workers lease an engine for each request, so engines only start
+// once needed.
+// - Results are served from the SynthesisCache when possible.
+// - Identical requests pending or in flight are coalesced into one render.
+// - Each request carries a cancellation token, checked before it is handed
+//   to the engine and again before its callback runs.
+// - supersedePreviousRequests() cancels everything submitted so far, which
+//   gives the owning processor a latest-wins policy.
+// - submitSynthesis() renders an AudioQuery instead of an engine request: the
+//   core's synthesis alone, skipping the text frontend and prosody prediction.
+//   submitAudioQuery() runs those two on their own and keeps the result in the
+//   AudioQueryCache, so talk renders in two stages on different workers.
+// - Interactive requests are dispatched before any background request, so a
+//   preview preempts a long render at its next phrase boundary. Background
+//   requests placed on the timeline are dispatched in order of their distance
+//   ahead of the playhead, the audio about to be heard first.
+//==============================================================================
+class VoicevoxRequestQueue final
+{
+public:
+    //==============================================================================
+    using Callback = std::function<void(const cctn::VoicevoxEngineArtefact& artefact)>;
+    // Gets nullopt when the query could not be made.
+    using AudioQueryCallback = std::function<void(const std::optional<juce::String>& audioQueryJson)>;
+
+    struct Statistics
+    {
+        juce::int64 numSubmitted{ 0 };
+        juce::int64 numRendered{ 0 };
+        juce::int64 numAudioQueries{ 0 };
+        juce::int64 numCoalesced{ 0 };
+        juce::int64 numCancelled{ 0 };
+        // Time engines were leased to render this queue's jobs.
+        double renderTimeMs{ 0.0 };
+
+        // Time from submission until a worker picks the request up.
+        LatencyRecorder::Percentiles interactiveWaitTime;
+        LatencyRecorder::Percentiles backgroundWaitTime;
+    };
+
+    // Returns the current playhead position in seconds, when known.
+    using PlayheadPositionProvider = std::function<std::optional<double>()>;
+
+    //==============================================================================
+    VoicevoxRequestQueue(InferenceScheduler& scheduler, SynthesisCache& synthesisCache, AudioQueryCache& audioQueryCache);
+    ~VoicevoxRequestQueue();
+
+    //==============================================================================
+    // Cancels all requests submitted so far and returns a fresh token for the ones that replace them.
+    CancellationTokenPtr supersedePreviousRequests();
+
+    // The callback runs on a worker thread, or synchronously on a cache hit.
+    // timelinePositionInSeconds is where the rendered audio starts on the host timeline, if anywhere.
+    void submit(const cctn::VoicevoxEngineRequest& request, Callback callback, CancellationTokenPtr cancellationToken,
+                RequestPriority priority = RequestPriority::kInteractive,
+                std::optional<double> timelinePositionInSeconds = std::nullopt);
+
+    // Same contract as submit(); the request gives the speaker, the sample rate and the id, its text and score are not used.
+    void submitSynthesis(const cctn::VoicevoxEngineRequest& request, const juce::String& audioQueryJson, Callback callback, CancellationTokenPtr cancellationToken,
+                         RequestPriority priority = RequestPriority::kInteractive,
+                         std::optional<double> timelinePositionInSeconds = std::nullopt);
+
+    // Same contract as submit(), for the AudioQuery of the request's text and speaker.
+    void submitAudioQuery(const cctn::VoicevoxEngineRequest& request, AudioQueryCallback callback, CancellationTokenPtr cancellationToken,
+                          RequestPriority priority = RequestPriority::kInteractive,
+                          std::optional<double> timelinePositionInSeconds = std::nullopt);
+
+    void cancelAll();
+
+    Statistics getStatistics() const;
+    double getRenderTimeMs() const;
+    InferenceScheduler& getScheduler() const noexcept { return schedulerRef; }
+
+    // Called from the worker threads while choosing the next request.
+    void setPlayheadPositionProvider(PlayheadPositionProvider provider);
+
+private:
+    //==============================================================================
+    enum class Stage
+    {
+        // The engine request, text or score to audio.
+        kRender = 0,
+        // Text to AudioQuery.
+        kAudioQuery,
+        // AudioQuery to audio.
+        kSynthesis,
+    };
+
+    struct Waiter
+    {
+        // The one matching the job's stage is set.
+        Callback callback;
+        AudioQueryCallback audioQueryCallback;
+        CancellationTokenPtr cancellationToken;
+    };
+
+    struct Job
+    {
+        SynthesisCache::Key key;
+        cctn::VoicevoxEngineRequest request;
+        Stage stage{ Stage::kRender };
+        // The query synthesized by a kSynthesis job.
+        juce::String audioQueryJson;
+        std::vector<Waiter> waiters;
+        RequestPriority priority{ RequestPriority::kInteractive };
+        std::optional<double> timelinePositionInSeconds;
+        double submittedTimeMs{ 0.0 };
+        juce::int64 sequenceNumber{ 0 };
+
+        bool hasActiveWaiter() const;
+    };
+
+    //==============================================================================
+    // Called by the scheduler's workers.
+    friend class InferenceScheduler;
+    std::optional<RequestPriority> peekNextJobPriority();
+    // Renders the most urgent job, if any, and returns how long an engine was leased for it.
+    double runNextJob(std::function<bool()> shouldAbort);
+
+    void submitJob(const SynthesisCache::Key& key, const cctn::VoicevoxEngineRequest& request, Stage stage, const juce::String& audioQueryJson,
+                   Waiter waiter, RequestPriority priority, std::optional<double> timelinePositionInSeconds);
+    std::optional<cctn::VoicevoxEngineArtefact> renderJob(VoicevoxEnginePool::Lease engineLease, const Job& job, std::function<bool()> shouldAbort);
+    void runAudioQueryJob(VoicevoxEnginePool::Lease engineLease, const std::shared_ptr<Job>& job);
+
+    void removeCancelledJobs();
+    std::shared_ptr<Job> takeNextJob();
+    double getSchedulingDistance(const Job& job, std::optional<double> playheadPositionInSeconds) const;
+    void finishJob(const std::shared_ptr<Job>& job, const cctn::VoicevoxEngineArtefact& artefact, double renderTimeMs);
+    void finishAudioQueryJob(const std::shared_ptr<Job>& job, const std::optional<juce::String>& audioQueryJson);
+    // For a job given up before it rendered; it leaves the in-flight list so that identical requests are not attached to it.
+    void abandonJob(const std::shared_ptr<Job>& job);
+
+    //==============================================================================
+    InferenceScheduler& schedulerRef;
+    SynthesisCache& synthesisCacheRef;
+    AudioQueryCache& audioQueryCacheRef;
+    // Set while the queue is destroyed, so that its jobs in flight give up their engines.
+    std::atomic<bool> isShuttingDown{ false };
+
+    mutable juce::CriticalSection lock;
+    std::vector<std::shared_ptr<Job>> pendingJobs;
+    std::vector<std::shared_ptr<Job>> inFlightJobs;
+    CancellationTokenPtr latestCancellationToken;
+    Statistics statistics;
+    juce::int64 nextSequenceNumber;
+    PlayheadPositionProvider playheadPositionProvider;
+
+    LatencyRecorder interactiveWaitTimeRecorder;
+    LatencyRecorder backgroundWaitTimeRecorder;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VoicevoxRequestQueue)
+};
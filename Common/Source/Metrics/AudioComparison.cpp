@@ -0,0 +1,42 @@
+#include "AudioComparison.h"
+
+//==============================================================================
+double AudioComparison::getSignalToNoiseRatioInDecibels(const juce::AudioBuffer<float>& reference, const juce::AudioBuffer<float>& test)
+{
+    const auto num_channels = juce::jmax(reference.getNumChannels(), test.getNumChannels());
+    const auto num_samples = juce::jmax(reference.getNumSamples(), test.getNumSamples());
+
+    auto get_sample = [](const juce::AudioBuffer<float>& buffer, int channelIndex, int sampleIndex) {
+        if (channelIndex >= buffer.getNumChannels() || sampleIndex >= buffer.getNumSamples())
+        {
+            return 0.0;
+        }
+
+        return (double)buffer.getSample(channelIndex, sampleIndex);
+    };
+
+    double signal_energy = 0.0;
+    double noise_energy = 0.0;
+    for (int channel_idx = 0; channel_idx < num_channels; channel_idx++)
+    {
+        for (int sample_idx = 0; sample_idx < num_samples; sample_idx++)
+        {
+            const auto reference_sample = get_sample(reference, channel_idx, sample_idx);
+            const auto difference = reference_sample - get_sample(test, channel_idx, sample_idx);
+            signal_energy += reference_sample * reference_sample;
+            noise_energy += difference * difference;
+        }
+    }
+
+    if (noise_energy <= 0.0)
+    {
+        return kMaxSignalToNoiseRatioInDecibels;
+    }
+
+    if (signal_energy <= 0.0)
+    {
+        return -kMaxSignalToNoiseRatioInDecibels;
+    }
+
+    return juce::jlimit(-kMaxSignalToNoiseRatioInDecibels, kMaxSignalToNoiseRatioInDecibels, 10.0 * std::log10(signal_energy / noise_energy));
+}
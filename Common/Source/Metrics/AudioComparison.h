@@ -0,0 +1,22 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+//==============================================================================
+// AudioComparison
+//
+// How far a render is from a reference render of the same request, such as a
+// quantized model against the full precision one.
+//==============================================================================
+class AudioComparison final
+{
+public:
+    // Reference energy over the energy of the difference, in dB. Samples missing
+    // from either side count as difference. Identical renders give kMaxSignalToNoiseRatioInDecibels.
+    static double getSignalToNoiseRatioInDecibels(const juce::AudioBuffer<float>& reference, const juce::AudioBuffer<float>& test);
+
+    static constexpr double kMaxSignalToNoiseRatioInDecibels = 200.0;
+
+private:
+    AudioComparison() = delete;
+};
@@ -0,0 +1,68 @@
+#include "LatencyRecorder.h"
+
+//==============================================================================
+LatencyRecorder::LatencyRecorder(int maxNumSamplesToUse)
+    : maxNumSamples(juce::jmax(1, maxNumSamplesToUse))
+    , nextSampleIndex(0)
+{
+    samples.reserve((size_t)maxNumSamples);
+}
+
+LatencyRecorder::~LatencyRecorder()
+{
+}
+
+//==============================================================================
+void LatencyRecorder::record(double latencyMs)
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    if ((int)samples.size() < maxNumSamples)
+    {
+        samples.push_back(latencyMs);
+        return;
+    }
+
+    // Once full, the oldest sample is overwritten.
+    samples[(size_t)nextSampleIndex] = latencyMs;
+    nextSampleIndex = (nextSampleIndex + 1) % maxNumSamples;
+}
+
+void LatencyRecorder::reset()
+{
+    const juce::ScopedLock scoped_lock(lock);
+
+    samples.clear();
+    nextSampleIndex = 0;
+}
+
+LatencyRecorder::Percentiles LatencyRecorder::getPercentiles() const
+{
+    std::vector<double> sorted_samples;
+    {
+        const juce::ScopedLock scoped_lock(lock);
+        sorted_samples = samples;
+    }
+
+    std::sort(sorted_samples.begin(), sorted_samples.end());
+
+    Percentiles percentiles;
+    percentiles.numSamples = (int)sorted_samples.size();
+    percentiles.p50Ms = getPercentile(sorted_samples, 0.50);
+    percentiles.p95Ms = getPercentile(sorted_samples, 0.95);
+    percentiles.p99Ms = getPercentile(sorted_samples, 0.99);
+    percentiles.maxMs = sorted_samples.empty() ? 0.0 : sorted_samples.back();
+
+    return percentiles;
+}
+
+double LatencyRecorder::getPercentile(const std::vector<double>& sortedSamples, double fraction)
+{
+    if (sortedSamples.empty())
+    {
+        return 0.0;
+    }
+
+    const auto rank = (int)std::ceil(juce::jlimit(0.0, 1.0, fraction) * (double)sortedSamples.size());
+    return sortedSamples[(size_t)juce::jlimit(0, (int)sortedSamples.size() - 1, rank - 1)];
+}
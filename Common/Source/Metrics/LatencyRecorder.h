@@ -0,0 +1,46 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+// LatencyRecorder
+//
+// Keeps the most recent latency samples, in milliseconds, and reports their
+// percentiles. Safe to use from several threads.
+//==============================================================================
+class LatencyRecorder final
+{
+public:
+    //==============================================================================
+    struct Percentiles
+    {
+        int numSamples{ 0 };
+        double p50Ms{ 0.0 };
+        double p95Ms{ 0.0 };
+        double p99Ms{ 0.0 };
+        double maxMs{ 0.0 };
+    };
+
+    //==============================================================================
+    explicit LatencyRecorder(int maxNumSamples = 1024);
+    ~LatencyRecorder();
+
+    //==============================================================================
+    void record(double latencyMs);
+    void reset();
+
+    Percentiles getPercentiles() const;
+
+    // Nearest-rank percentile of already sorted samples; fraction is in [0, 1].
+    static double getPercentile(const std::vector<double>& sortedSamples, double fraction);
+
+private:
+    //==============================================================================
+    const int maxNumSamples;
+
+    mutable juce::CriticalSection lock;
+    std::vector<double> samples;
+    int nextSampleIndex;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LatencyRecorder)
+};
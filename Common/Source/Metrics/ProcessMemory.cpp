@@ -0,0 +1,80 @@
+#include "ProcessMemory.h"
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+ #include <psapi.h>
+ #pragma comment(lib, "psapi.lib")
+#elif JUCE_MAC
+ #include <mach/mach.h>
+#elif JUCE_LINUX
+ #include <cstdio>
+ #include <unistd.h>
+#endif
+
+#if JUCE_LINUX
+namespace
+{
+    // Fields of /proc/self/statm, in pages: size, resident, shared, ...
+    // Read with stdio, since procfs files report a size of zero.
+    size_t readStatmPages(int fieldIndex)
+    {
+        auto* statm_file = std::fopen("/proc/self/statm", "r");
+        if (statm_file == nullptr)
+        {
+            return 0;
+        }
+
+        long fields[3] = { 0, 0, 0 };
+        const auto num_fields_read = std::fscanf(statm_file, "%ld %ld %ld", &fields[0], &fields[1], &fields[2]);
+        std::fclose(statm_file);
+
+        if (num_fields_read <= fieldIndex)
+        {
+            return 0;
+        }
+
+        return (size_t)fields[fieldIndex];
+    }
+}
+#endif
+
+//==============================================================================
+size_t ProcessMemory::getResidentSetSizeInBytes()
+{
+#if JUCE_WINDOWS
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return (size_t)counters.WorkingSetSize;
+    }
+
+    return 0;
+#elif JUCE_MAC
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) == KERN_SUCCESS)
+    {
+        return (size_t)info.resident_size;
+    }
+
+    return 0;
+#elif JUCE_LINUX
+    return readStatmPages(1) * (size_t)sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
+
+size_t ProcessMemory::getSharedResidentSetSizeInBytes()
+{
+#if JUCE_LINUX
+    return readStatmPages(2) * (size_t)sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
+
+juce::String ProcessMemory::formatBytes(size_t numBytes)
+{
+    return juce::String((double)numBytes / (1024.0 * 1024.0), 1) + " MB";
+}
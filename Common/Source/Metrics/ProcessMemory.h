@@ -0,0 +1,21 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+// ProcessMemory
+//==============================================================================
+class ProcessMemory final
+{
+public:
+    // Resident set size of this process, or 0 when the platform does not report it.
+    static size_t getResidentSetSizeInBytes();
+    // The part of the resident set backed by files, such as memory-mapped dictionaries, and shareable
+    // with other processes; 0 when the platform does not report it.
+    static size_t getSharedResidentSetSizeInBytes();
+
+    static juce::String formatBytes(size_t numBytes);
+
+private:
+    ProcessMemory() = delete;
+};
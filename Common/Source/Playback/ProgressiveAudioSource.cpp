@@ -0,0 +1,173 @@
+#include "ProgressiveAudioSource.h"
+
+//==============================================================================
+ProgressiveAudioSource::ProgressiveAudioSource(int numChannelsToUse)
+    : numChannels(juce::jmax(1, numChannelsToUse))
+    , numSamplesWritten(0)
+    , readPosition(0)
+    , complete(false)
+    , looping(false)
+{
+    buffer.setSize(numChannels, 0);
+}
+
+ProgressiveAudioSource::~ProgressiveAudioSource()
+{
+}
+
+//==============================================================================
+void ProgressiveAudioSource::appendSamples(const juce::AudioBuffer<float>& sourceBuffer)
+{
+    appendSamples(sourceBuffer, 0, sourceBuffer.getNumSamples());
+}
+
+void ProgressiveAudioSource::appendSamples(const juce::AudioBuffer<float>& sourceBuffer, int startSample, int numSamples)
+{
+    jassert(startSample >= 0 && startSample + numSamples <= sourceBuffer.getNumSamples());
+
+    const auto num_samples_to_append = numSamples;
+    if (num_samples_to_append <= 0 || sourceBuffer.getNumChannels() <= 0)
+    {
+        return;
+    }
+
+    const auto write_position = (int)numSamplesWritten.load();
+    ensureCapacity(write_position + num_samples_to_append);
+
+    // The region after numSamplesWritten is never read by the audio thread, so it can be filled without the lock.
+    for (int channel_idx = 0; channel_idx < numChannels; channel_idx++)
+    {
+        const auto source_channel = juce::jmin(channel_idx, sourceBuffer.getNumChannels() - 1);
+        buffer.copyFrom(channel_idx, write_position, sourceBuffer, source_channel, startSample, num_samples_to_append);
+    }
+
+    numSamplesWritten.store(write_position + num_samples_to_append);
+}
+
+void ProgressiveAudioSource::markComplete()
+{
+    complete.store(true);
+}
+
+juce::AudioBuffer<float> ProgressiveAudioSource::createSnapshot() const
+{
+    const juce::SpinLock::ScopedLockType lock(bufferLock);
+
+    const auto num_samples = (int)numSamplesWritten.load();
+
+    juce::AudioBuffer<float> snapshot(numChannels, num_samples);
+    for (int channel_idx = 0; channel_idx < numChannels; channel_idx++)
+    {
+        snapshot.copyFrom(channel_idx, 0, buffer, channel_idx, 0, num_samples);
+    }
+
+    return snapshot;
+}
+
+//==============================================================================
+void ProgressiveAudioSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    juce::ignoreUnused(samplesPerBlockExpected, sampleRate);
+}
+
+void ProgressiveAudioSource::releaseResources()
+{
+}
+
+void ProgressiveAudioSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    bufferToFill.clearActiveBufferRegion();
+
+    const juce::SpinLock::ScopedTryLockType lock(bufferLock);
+    if (!lock.isLocked())
+    {
+        return;
+    }
+
+    const auto num_samples_available = numSamplesWritten.load();
+    auto position = readPosition.load();
+    int num_samples_filled = 0;
+
+    while (num_samples_filled < bufferToFill.numSamples)
+    {
+        if (position >= num_samples_available)
+        {
+            if (complete.load() && looping.load() && num_samples_available > 0)
+            {
+                position = 0;
+                continue;
+            }
+
+            // Hold the position until the writer catches up.
+            break;
+        }
+
+        const auto num_samples_to_copy = (int)juce::jmin((juce::int64)(bufferToFill.numSamples - num_samples_filled), num_samples_available - position);
+        for (int channel_idx = 0; channel_idx < bufferToFill.buffer->getNumChannels(); channel_idx++)
+        {
+            const auto source_channel = juce::jmin(channel_idx, numChannels - 1);
+            bufferToFill.buffer->copyFrom(channel_idx, bufferToFill.startSample + num_samples_filled, buffer, source_channel, (int)position, num_samples_to_copy);
+        }
+
+        num_samples_filled += num_samples_to_copy;
+        position += num_samples_to_copy;
+    }
+
+    // When the stream is complete, move past the end so that the transport can detect it.
+    if (complete.load() && !looping.load() && num_samples_filled < bufferToFill.numSamples)
+    {
+        position = num_samples_available + (bufferToFill.numSamples - num_samples_filled);
+    }
+
+    readPosition.store(position);
+}
+
+//==============================================================================
+void ProgressiveAudioSource::setNextReadPosition(juce::int64 newPosition)
+{
+    readPosition.store(juce::jmax((juce::int64)0, newPosition));
+}
+
+juce::int64 ProgressiveAudioSource::getNextReadPosition() const
+{
+    return readPosition.load();
+}
+
+juce::int64 ProgressiveAudioSource::getTotalLength() const
+{
+    return numSamplesWritten.load();
+}
+
+bool ProgressiveAudioSource::isLooping() const
+{
+    return looping.load();
+}
+
+void ProgressiveAudioSource::setLooping(bool shouldLoop)
+{
+    looping.store(shouldLoop);
+}
+
+//==============================================================================
+void ProgressiveAudioSource::ensureCapacity(int numSamplesRequired)
+{
+    if (buffer.getNumSamples() >= numSamplesRequired)
+    {
+        return;
+    }
+
+    // Grow geometrically so that appending many small chunks stays cheap.
+    const auto new_capacity = juce::jmax(numSamplesRequired, buffer.getNumSamples() * 2, 48000);
+
+    juce::AudioBuffer<float> grown_buffer(numChannels, new_capacity);
+    grown_buffer.clear();
+
+    const auto num_samples_to_keep = (int)numSamplesWritten.load();
+    for (int channel_idx = 0; channel_idx < numChannels; channel_idx++)
+    {
+        grown_buffer.copyFrom(channel_idx, 0, buffer, channel_idx, 0, num_samples_to_keep);
+    }
+
+    const juce::SpinLock::ScopedLockType lock(bufferLock);
+    std::swap(buffer, grown_buffer);
+}
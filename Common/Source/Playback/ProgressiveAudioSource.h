@@ -0,0 +1,62 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+//==============================================================================
+// ProgressiveAudioSource
+//
+// A positionable source over a buffer that keeps growing while it is played.
+// A single writer thread appends rendered chunks; the audio thread reads what
+// has been written so far and holds its position (outputting silence) when it
+// catches up with the writer, until markComplete() is called.
+//==============================================================================
+class ProgressiveAudioSource final
+    : public juce::PositionableAudioSource
+{
+public:
+    //==============================================================================
+    explicit ProgressiveAudioSource(int numChannels);
+    ~ProgressiveAudioSource() override;
+
+    //==============================================================================
+    // Should be called from a single writer thread.
+    void appendSamples(const juce::AudioBuffer<float>& sourceBuffer);
+    void appendSamples(const juce::AudioBuffer<float>& sourceBuffer, int startSample, int numSamples);
+    void markComplete();
+
+    bool isComplete() const noexcept { return complete.load(); }
+    juce::int64 getNumSamplesWritten() const noexcept { return numSamplesWritten.load(); }
+
+    // Returns a copy of everything written so far.
+    juce::AudioBuffer<float> createSnapshot() const;
+
+    //==============================================================================
+    // juce::AudioSource
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+    // juce::PositionableAudioSource
+    void setNextReadPosition(juce::int64 newPosition) override;
+    juce::int64 getNextReadPosition() const override;
+    juce::int64 getTotalLength() const override;
+    bool isLooping() const override;
+    void setLooping(bool shouldLoop) override;
+
+private:
+    //==============================================================================
+    void ensureCapacity(int numSamplesRequired);
+
+    //==============================================================================
+    const int numChannels;
+
+    mutable juce::SpinLock bufferLock;
+    juce::AudioBuffer<float> buffer;
+
+    std::atomic<juce::int64> numSamplesWritten;
+    std::atomic<juce::int64> readPosition;
+    std::atomic<bool> complete;
+    std::atomic<bool> looping;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProgressiveAudioSource)
+};
@@ -0,0 +1,22 @@
+#include "SharedAudioBufferingThread.h"
+#include "Engine/SynthesisThreadPriority.h"
+
+//==============================================================================
+SharedAudioBufferingThread::SharedAudioBufferingThread()
+    : juce::TimeSliceThread("AudioBufferingThread")
+{
+    SynthesisThreadPriority::startThread(*this);
+}
+
+SharedAudioBufferingThread::~SharedAudioBufferingThread()
+{
+    stopThread(-1);
+}
+
+//==============================================================================
+void SharedAudioBufferingThread::run()
+{
+    SynthesisThreadPriority::applyToCurrentThread();
+
+    juce::TimeSliceThread::run();
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+// SharedAudioBufferingThread
+//
+// The read-ahead thread of the transport sources. Share it with
+// juce::SharedResourcePointer so that every processor in the process buffers
+// on one thread, rather than adding a thread per instance next to the
+// inference workers. Like those, it runs below normal priority (see
+// SynthesisThreadPriority); it reads far enough ahead of playback to ride
+// out being preempted.
+//==============================================================================
+class SharedAudioBufferingThread final
+    : public juce::TimeSliceThread
+{
+public:
+    //==============================================================================
+    SharedAudioBufferingThread();
+    ~SharedAudioBufferingThread() override;
+
+    //==============================================================================
+    // juce::TimeSliceThread
+    void run() override;
+
+private:
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedAudioBufferingThread)
+};
@@ -0,0 +1,133 @@
+#include "ScorePhraseBatcher.h"
+
+//==============================================================================
+ScorePhraseBatcher::ScorePhraseBatcher(int maxBatchFramesToUse)
+    : maxBatchFrames(juce::jmax(kBucketFrames, maxBatchFramesToUse))
+{
+}
+
+ScorePhraseBatcher::~ScorePhraseBatcher()
+{
+}
+
+//==============================================================================
+std::vector<ScorePhraseBatch> ScorePhraseBatcher::makeBatches(const std::vector<const ScorePhrase*>& phrases, int minNumBatches) const
+{
+    std::vector<ScorePhraseBatch> batches;
+
+    int total_frames = 0;
+    for (const auto* phrase : phrases)
+    {
+        total_frames += phrase->numFrames;
+    }
+
+    // Smaller batches when there is too little to keep every engine busy otherwise.
+    const int frames_per_engine = getBucketFrames((total_frames + juce::jmax(1, minNumBatches) - 1) / juce::jmax(1, minNumBatches));
+    const int batch_frames_limit = juce::jlimit(kBucketFrames, maxBatchFrames, frames_per_engine);
+
+    std::vector<int> phrase_indices;
+    int batch_frames = 0;
+
+    for (int phrase_idx = 0; phrase_idx < (int)phrases.size(); phrase_idx++)
+    {
+        const int phrase_frames = phrases[(size_t)phrase_idx]->numFrames;
+
+        // A phrase longer than the limit still makes a batch of its own.
+        if (!phrase_indices.empty() && batch_frames + phrase_frames > batch_frames_limit)
+        {
+            batches.push_back(makeBatch(phrases, phrase_indices));
+            phrase_indices.clear();
+            batch_frames = 0;
+        }
+
+        phrase_indices.push_back(phrase_idx);
+        batch_frames += phrase_frames;
+    }
+
+    if (!phrase_indices.empty())
+    {
+        batches.push_back(makeBatch(phrases, phrase_indices));
+    }
+
+    return batches;
+}
+
+std::optional<cctn::AudioBufferInfo> ScorePhraseBatcher::extractPhraseAudio(const ScorePhraseBatch& batch, int phraseIndexInBatch,
+                                                                            const ScorePhrase& phrase, const cctn::AudioBufferInfo& batchAudio)
+{
+    if (!juce::isPositiveAndBelow(phraseIndexInBatch, (int)batch.phraseStartFrames.size()) || batchAudio.sampleRate <= 0.0)
+    {
+        return std::nullopt;
+    }
+
+    const auto samples_per_frame = batchAudio.sampleRate / ScorePhraseSplitter::kFramesPerSecond;
+    const int start_sample = juce::roundToInt(batch.phraseStartFrames[(size_t)phraseIndexInBatch] * samples_per_frame);
+    const int num_samples = juce::jmin(juce::roundToInt(phrase.numFrames * samples_per_frame),
+                                       batchAudio.audioBuffer.getNumSamples() - start_sample);
+    if (num_samples <= 0)
+    {
+        return std::nullopt;
+    }
+
+    cctn::AudioBufferInfo phrase_audio;
+    phrase_audio.sampleRate = batchAudio.sampleRate;
+    phrase_audio.audioBuffer.setSize(batchAudio.audioBuffer.getNumChannels(), num_samples);
+    for (int channel_idx = 0; channel_idx < batchAudio.audioBuffer.getNumChannels(); channel_idx++)
+    {
+        phrase_audio.audioBuffer.copyFrom(channel_idx, 0, batchAudio.audioBuffer, channel_idx, start_sample, num_samples);
+    }
+
+    return phrase_audio;
+}
+
+int ScorePhraseBatcher::getBucketFrames(int numFrames)
+{
+    return juce::jmax(1, (numFrames + kBucketFrames - 1) / kBucketFrames) * kBucketFrames;
+}
+
+cctn::VoicevoxEngineRequest ScorePhraseBatcher::makePhraseRequest(const ScorePhrase& phrase, juce::int64 speakerId, double sampleRate)
+{
+    cctn::VoicevoxEngineRequest request;
+    request.requestId = juce::Uuid();
+    request.speakerId = speakerId;
+    request.scoreJson = phrase.scoreJson;
+    request.sampleRate = sampleRate;
+    request.processType = cctn::VoicevoxEngineProcessType::kHumming;
+
+    return request;
+}
+
+//==============================================================================
+ScorePhraseBatch ScorePhraseBatcher::makeBatch(const std::vector<const ScorePhrase*>& phrases, const std::vector<int>& phraseIndices)
+{
+    ScorePhraseBatch batch;
+    batch.phraseIndices = phraseIndices;
+
+    juce::Array<juce::var> batch_notes;
+    int batch_frames = 0;
+
+    for (const auto phrase_idx : phraseIndices)
+    {
+        const auto* phrase = phrases[(size_t)phrase_idx];
+        const auto phrase_score = juce::JSON::parse(phrase->scoreJson);
+        if (const auto* phrase_notes = phrase_score.getProperty("notes", juce::var()).getArray())
+        {
+            batch_notes.addArray(*phrase_notes);
+        }
+
+        batch.phraseStartFrames.push_back(batch_frames);
+        batch_frames += phrase->numFrames;
+    }
+
+    batch.numFrames = getBucketFrames(batch_frames);
+    if (batch.numFrames > batch_frames)
+    {
+        batch_notes.add(ScorePhraseSplitter::makeRest(batch.numFrames - batch_frames));
+    }
+
+    juce::DynamicObject::Ptr batch_score = new juce::DynamicObject();
+    batch_score->setProperty("notes", batch_notes);
+    batch.scoreJson = juce::JSON::toString(juce::var(batch_score.get()), true);
+
+    return batch;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <voicevox_juce_extra/voicevox_juce_extra.h>
+#include "Score/ScorePhraseSplitter.h"
+
+//==============================================================================
+// ScorePhraseBatch
+//
+// Several phrases rendered as one score: the phrases one after the other,
+// each with its own padding rests, followed by a rest up to the bucket length.
+//==============================================================================
+struct ScorePhraseBatch
+{
+    // Indices into the phrases the batch was made from, in the order they appear in the batch.
+    std::vector<int> phraseIndices;
+    // First frame of each phrase within the batch.
+    std::vector<int> phraseStartFrames;
+    int numFrames{ 0 };
+    juce::String scoreJson;
+};
+
+//==============================================================================
+// ScorePhraseBatcher
+//
+// Groups phrases into batches which render in one engine request each, so
+// that pending phrases make a few long inference calls instead of many short
+// ones with small tensors.
+// - Phrases are batched in score order, so the start of the song still comes
+//   back first, until a batch would exceed the maximum length.
+// - Each batch is padded with a trailing rest up to a multiple of the bucket
+//   length, so that the engine sees a handful of distinct input lengths.
+// - Phrases keep their own padding rests, so the rendered batch is split back
+//   by frame position, and each phrase comes out as if rendered on its own.
+// - Only phrases missing from the SynthesisCache should be batched: each
+//   phrase is cached under the key of its own request, see
+//   makePhraseRequest(), so a hit does not depend on how it was batched.
+//==============================================================================
+class ScorePhraseBatcher final
+{
+public:
+    //==============================================================================
+    static constexpr int kBucketFrames = 256;
+
+    //==============================================================================
+    // About 21 seconds of audio per batch at most.
+    explicit ScorePhraseBatcher(int maxBatchFrames = 2048);
+    ~ScorePhraseBatcher();
+
+    //==============================================================================
+    // Makes at least minNumBatches batches while there are enough phrases, so that every engine gets one.
+    std::vector<ScorePhraseBatch> makeBatches(const std::vector<const ScorePhrase*>& phrases, int minNumBatches = 1) const;
+
+    // Cuts the audio of the batch's phraseIndexInBatch-th phrase out of the rendered batch.
+    static std::optional<cctn::AudioBufferInfo> extractPhraseAudio(const ScorePhraseBatch& batch, int phraseIndexInBatch,
+                                                                   const ScorePhrase& phrase, const cctn::AudioBufferInfo& batchAudio);
+
+    static int getBucketFrames(int numFrames);
+
+    // The request rendering the phrase on its own, whose cache key the phrase's audio is looked up and stored under.
+    static cctn::VoicevoxEngineRequest makePhraseRequest(const ScorePhrase& phrase, juce::int64 speakerId, double sampleRate);
+
+private:
+    //==============================================================================
+    static ScorePhraseBatch makeBatch(const std::vector<const ScorePhrase*>& phrases, const std::vector<int>& phraseIndices);
+
+    //==============================================================================
+    const int maxBatchFrames;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScorePhraseBatcher)
+};
@@ -0,0 +1,121 @@
+#include "ScorePhraseSplitter.h"
+
+//==============================================================================
+ScorePhraseSplitter::ScorePhraseSplitter(int maxPaddingRestFramesToUse)
+    : maxPaddingRestFrames(juce::jmax(1, maxPaddingRestFramesToUse))
+{
+}
+
+ScorePhraseSplitter::~ScorePhraseSplitter()
+{
+}
+
+//==============================================================================
+std::vector<ScorePhrase> ScorePhraseSplitter::split(const juce::String& scoreJson, const juce::String& fingerprintSalt) const
+{
+    std::vector<ScorePhrase> phrases;
+
+    const auto score = juce::JSON::parse(scoreJson);
+    const auto* notes = score.getProperty("notes", juce::var()).getArray();
+    if (notes == nullptr)
+    {
+        return phrases;
+    }
+
+    int note_idx = 0;
+    int frame_position = 0;
+
+    while (note_idx < notes->size())
+    {
+        if (isRest(notes->getReference(note_idx)))
+        {
+            frame_position += (int)notes->getReference(note_idx).getProperty("frame_length", 0);
+            note_idx++;
+            continue;
+        }
+
+        // Leading rest: the tail of the preceding rest, or a synthetic one at the start of the score.
+        int leading_rest_frames = maxPaddingRestFrames;
+        if (note_idx > 0)
+        {
+            leading_rest_frames = juce::jlimit(1, maxPaddingRestFrames, (int)notes->getReference(note_idx - 1).getProperty("frame_length", 0));
+        }
+
+        juce::Array<juce::var> phrase_notes;
+        phrase_notes.add(makeRest(leading_rest_frames));
+
+        const int phrase_start_frame = frame_position - leading_rest_frames;
+        int phrase_num_frames = leading_rest_frames;
+
+        while (note_idx < notes->size() && !isRest(notes->getReference(note_idx)))
+        {
+            const auto& note = notes->getReference(note_idx);
+            phrase_notes.add(note);
+
+            const int note_frames = (int)note.getProperty("frame_length", 0);
+            phrase_num_frames += note_frames;
+            frame_position += note_frames;
+            note_idx++;
+        }
+
+        // Trailing rest: the head of the following rest, leaving room for the release.
+        int trailing_rest_frames = maxPaddingRestFrames;
+        if (note_idx < notes->size())
+        {
+            trailing_rest_frames = juce::jlimit(1, maxPaddingRestFrames, (int)notes->getReference(note_idx).getProperty("frame_length", 0));
+        }
+
+        phrase_notes.add(makeRest(trailing_rest_frames));
+        phrase_num_frames += trailing_rest_frames;
+
+        juce::DynamicObject::Ptr phrase_score = new juce::DynamicObject();
+        phrase_score->setProperty("notes", phrase_notes);
+
+        ScorePhrase phrase;
+        phrase.startFrame = phrase_start_frame;
+        phrase.numFrames = phrase_num_frames;
+        phrase.leadingRestFrames = leading_rest_frames;
+        phrase.trailingRestFrames = trailing_rest_frames;
+        phrase.scoreJson = juce::JSON::toString(juce::var(phrase_score.get()), true);
+        phrase.fingerprint = juce::String::toHexString((fingerprintSalt + "|" + phrase.scoreJson).hashCode64());
+
+        phrases.push_back(std::move(phrase));
+    }
+
+    return phrases;
+}
+
+int ScorePhraseSplitter::getTotalFrames(const juce::String& scoreJson)
+{
+    const auto score = juce::JSON::parse(scoreJson);
+    const auto* notes = score.getProperty("notes", juce::var()).getArray();
+    if (notes == nullptr)
+    {
+        return 0;
+    }
+
+    int total_frames = 0;
+    for (const auto& note : *notes)
+    {
+        total_frames += (int)note.getProperty("frame_length", 0);
+    }
+
+    return total_frames;
+}
+
+bool ScorePhraseSplitter::isRest(const juce::var& note)
+{
+    const auto key = note.getProperty("key", juce::var());
+    return key.isVoid() || key.isUndefined() || note.getProperty("lyric", "").toString().isEmpty();
+}
+
+//==============================================================================
+juce::var ScorePhraseSplitter::makeRest(int numFrames)
+{
+    juce::DynamicObject::Ptr rest = new juce::DynamicObject();
+    rest->setProperty("key", juce::var());
+    rest->setProperty("frame_length", numFrames);
+    rest->setProperty("lyric", "");
+
+    return juce::var(rest.get());
+}
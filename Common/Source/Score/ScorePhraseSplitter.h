@@ -0,0 +1,50 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+// ScorePhrase
+//
+// A run of sung notes between two rests, extracted from a VOICEVOX score json
+// as a standalone score padded with a leading and a trailing rest.
+//==============================================================================
+struct ScorePhrase
+{
+    // Position of the phrase's leading rest in the whole score, in frames.
+    // May be negative when the score starts without a rest.
+    int startFrame{ 0 };
+    int numFrames{ 0 };
+    int leadingRestFrames{ 0 };
+    int trailingRestFrames{ 0 };
+    juce::String scoreJson;
+    juce::String fingerprint;
+};
+
+//==============================================================================
+// ScorePhraseSplitter
+//==============================================================================
+class ScorePhraseSplitter final
+{
+public:
+    //==============================================================================
+    // VOICEVOX renders scores at 24kHz with a hop size of 256 samples.
+    static constexpr double kFramesPerSecond = 24000.0 / 256.0;
+
+    //==============================================================================
+    explicit ScorePhraseSplitter(int maxPaddingRestFrames = 15);
+    ~ScorePhraseSplitter();
+
+    //==============================================================================
+    // The fingerprint salt should contain everything besides the notes that changes the rendered audio.
+    std::vector<ScorePhrase> split(const juce::String& scoreJson, const juce::String& fingerprintSalt) const;
+
+    static int getTotalFrames(const juce::String& scoreJson);
+    static bool isRest(const juce::var& note);
+    static juce::var makeRest(int numFrames);
+
+private:
+    //==============================================================================
+    const int maxPaddingRestFrames;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScorePhraseSplitter)
+};
@@ -0,0 +1,117 @@
+#include "PluginStateArchive.h"
+
+namespace
+{
+    const juce::Identifier kStateType("VoicevoxPluginState");
+    const juce::Identifier kVersion("version");
+    const juce::Identifier kTalkText("talkText");
+    const juce::Identifier kSongDocument("songDocument");
+    const juce::Identifier kSelectedTalkSpeakerIdentifier("selectedTalkSpeakerIdentifier");
+    const juce::Identifier kSelectedHummingSpeakerIdentifier("selectedHummingSpeakerIdentifier");
+    const juce::Identifier kEmbedsRenderedAudio("embedsRenderedAudio");
+    const juce::Identifier kRenderedAudio("renderedAudio");
+
+    constexpr int kCompressedBitsPerSample = 24;
+}
+
+//==============================================================================
+void PluginStateArchive::write(const Contents& contents, juce::MemoryBlock& destData)
+{
+    juce::ValueTree state(kStateType);
+    state.setProperty(kVersion, kCurrentVersion, nullptr);
+    state.setProperty(kTalkText, contents.talkText, nullptr);
+    state.setProperty(kSongDocument, contents.songDocument, nullptr);
+    state.setProperty(kSelectedTalkSpeakerIdentifier, contents.selectedTalkSpeakerIdentifier, nullptr);
+    state.setProperty(kSelectedHummingSpeakerIdentifier, contents.selectedHummingSpeakerIdentifier, nullptr);
+    state.setProperty(kEmbedsRenderedAudio, contents.embedsRenderedAudio, nullptr);
+
+    if (contents.embedsRenderedAudio && contents.compressedAudio.getSize() > 0)
+    {
+        state.setProperty(kRenderedAudio, contents.compressedAudio, nullptr);
+    }
+
+    juce::MemoryOutputStream output_stream(destData, false);
+    state.writeToStream(output_stream);
+}
+
+std::optional<PluginStateArchive::Contents> PluginStateArchive::read(const void* data, int sizeInBytes)
+{
+    const auto state = juce::ValueTree::readFromData(data, (size_t)sizeInBytes);
+    if (!state.hasType(kStateType))
+    {
+        return std::nullopt;
+    }
+
+    Contents contents;
+    contents.version = state.getProperty(kVersion, 0);
+
+    // A state written by a newer version is ignored rather than half understood.
+    if (contents.version <= 0 || contents.version > kCurrentVersion)
+    {
+        return std::nullopt;
+    }
+
+    contents.talkText = state.getProperty(kTalkText).toString();
+    contents.songDocument = state.getProperty(kSongDocument).toString();
+    contents.selectedTalkSpeakerIdentifier = state.getProperty(kSelectedTalkSpeakerIdentifier).toString();
+    contents.selectedHummingSpeakerIdentifier = state.getProperty(kSelectedHummingSpeakerIdentifier).toString();
+    contents.embedsRenderedAudio = state.getProperty(kEmbedsRenderedAudio, false);
+
+    if (const auto* compressed_audio = state.getProperty(kRenderedAudio).getBinaryData())
+    {
+        contents.compressedAudio = *compressed_audio;
+    }
+
+    return contents;
+}
+
+//==============================================================================
+juce::MemoryBlock PluginStateArchive::compressAudio(const juce::AudioBuffer<float>& audioBuffer, double sampleRate)
+{
+    juce::MemoryBlock compressed_audio;
+
+    if (audioBuffer.getNumSamples() == 0 || sampleRate <= 0.0)
+    {
+        return compressed_audio;
+    }
+
+    // Engine output is mono and only duplicated for playback, so the first channel is enough.
+    juce::FlacAudioFormat flac_format;
+    std::unique_ptr<juce::AudioFormatWriter> writer(flac_format.createWriterFor(new juce::MemoryOutputStream(compressed_audio, false),
+                                                                                sampleRate,
+                                                                                1,
+                                                                                kCompressedBitsPerSample,
+                                                                                {},
+                                                                                0));
+    if (writer == nullptr)
+    {
+        return {};
+    }
+
+    writer->writeFromAudioSampleBuffer(audioBuffer, 0, audioBuffer.getNumSamples());
+    writer.reset();
+
+    return compressed_audio;
+}
+
+std::optional<cctn::AudioBufferInfo> PluginStateArchive::decompressAudio(const juce::MemoryBlock& compressedAudio)
+{
+    if (compressedAudio.getSize() == 0)
+    {
+        return std::nullopt;
+    }
+
+    juce::FlacAudioFormat flac_format;
+    std::unique_ptr<juce::AudioFormatReader> reader(flac_format.createReaderFor(new juce::MemoryInputStream(compressedAudio, false), true));
+    if (reader == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    cctn::AudioBufferInfo audio_buffer_info;
+    audio_buffer_info.sampleRate = reader->sampleRate;
+    audio_buffer_info.audioBuffer.setSize((int)reader->numChannels, (int)reader->lengthInSamples);
+    reader->read(&audio_buffer_info.audioBuffer, 0, (int)reader->lengthInSamples, 0, true, true);
+
+    return audio_buffer_info;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <voicevox_juce_extra/voicevox_juce_extra.h>
+
+//==============================================================================
+// PluginStateArchive
+//
+// Versioned plugin state shared by the Talk and Song processors. Besides the
+// document and the selected speakers it can optionally carry the rendered
+// audio, FLAC compressed, so that a session recalls without the engine.
+//==============================================================================
+class PluginStateArchive final
+{
+public:
+    //==============================================================================
+    // Version 2 stores the Song document itself rather than its VOICEVOX score.
+    static constexpr int kCurrentVersion = 2;
+
+    struct Contents
+    {
+        int version{ kCurrentVersion };
+        juce::String talkText;
+        juce::String songDocument;
+        juce::String selectedTalkSpeakerIdentifier;
+        juce::String selectedHummingSpeakerIdentifier;
+        bool embedsRenderedAudio{ false };
+
+        // Left compressed until the processor decodes it off the message thread.
+        juce::MemoryBlock compressedAudio;
+    };
+
+    //==============================================================================
+    static void write(const Contents& contents, juce::MemoryBlock& destData);
+    static std::optional<Contents> read(const void* data, int sizeInBytes);
+
+    //==============================================================================
+    static juce::MemoryBlock compressAudio(const juce::AudioBuffer<float>& audioBuffer, double sampleRate);
+    static std::optional<cctn::AudioBufferInfo> decompressAudio(const juce::MemoryBlock& compressedAudio);
+
+private:
+    //==============================================================================
+    PluginStateArchive() = delete;
+};
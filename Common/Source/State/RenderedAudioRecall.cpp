@@ -0,0 +1,68 @@
+#include "RenderedAudioRecall.h"
+#include "PluginStateArchive.h"
+
+//==============================================================================
+struct RenderedAudioRecall::SharedThreadPool
+{
+    juce::ThreadPool threadPool{ 2 };
+};
+
+//==============================================================================
+class RenderedAudioRecall::DecodeJob final
+    : public juce::ThreadPoolJob
+{
+public:
+    DecodeJob(const juce::MemoryBlock& compressedAudioToDecode, Callback onDecodedToUse)
+        : juce::ThreadPoolJob("RenderedAudioRecall")
+        , compressedAudio(compressedAudioToDecode)
+        , onDecoded(std::move(onDecodedToUse))
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        const auto audio_buffer_info = PluginStateArchive::decompressAudio(compressedAudio);
+
+        if (audio_buffer_info.has_value() && !shouldExit())
+        {
+            onDecoded(audio_buffer_info.value());
+        }
+
+        return jobHasFinished;
+    }
+
+private:
+    const juce::MemoryBlock compressedAudio;
+    const Callback onDecoded;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DecodeJob)
+};
+
+//==============================================================================
+RenderedAudioRecall::RenderedAudioRecall()
+{
+}
+
+RenderedAudioRecall::~RenderedAudioRecall()
+{
+    cancel();
+}
+
+//==============================================================================
+void RenderedAudioRecall::decodeAsync(const juce::MemoryBlock& compressedAudio, Callback onDecoded)
+{
+    cancel();
+
+    currentJob = std::make_unique<DecodeJob>(compressedAudio, std::move(onDecoded));
+    sharedThreadPool->threadPool.addJob(currentJob.get(), false);
+}
+
+void RenderedAudioRecall::cancel()
+{
+    if (currentJob != nullptr)
+    {
+        // Waits for a running decode so that its callback never outlives the owner.
+        sharedThreadPool->threadPool.removeJob(currentJob.get(), true, -1);
+        currentJob.reset();
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <voicevox_juce_extra/voicevox_juce_extra.h>
+
+//==============================================================================
+// RenderedAudioRecall
+//
+// Decodes audio embedded in the plugin state on a small process-wide thread
+// pool, so that setStateInformation returns immediately even when a host
+// restores many instances at once.
+//==============================================================================
+class RenderedAudioRecall final
+{
+public:
+    //==============================================================================
+    using Callback = std::function<void(const cctn::AudioBufferInfo& audioBufferInfo)>;
+
+    //==============================================================================
+    RenderedAudioRecall();
+    ~RenderedAudioRecall();
+
+    //==============================================================================
+    // Replaces any pending decode. The callback runs on a pool thread.
+    void decodeAsync(const juce::MemoryBlock& compressedAudio, Callback onDecoded);
+    void cancel();
+
+private:
+    //==============================================================================
+    class DecodeJob;
+    struct SharedThreadPool;
+
+    juce::SharedResourcePointer<SharedThreadPool> sharedThreadPool;
+    std::unique_ptr<DecodeJob> currentJob;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RenderedAudioRecall)
+};
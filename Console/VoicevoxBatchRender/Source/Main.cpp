@@ -0,0 +1,241 @@
+#include <juce_events/juce_events.h>
+#include "Audio/WavAudioCodec.h"
+#include "Batch/BatchRenderer.h"
+#include "Engine/VoicevoxEnginePool.h"
+
+namespace
+{
+    constexpr double kDefaultScriptGapInSeconds = 0.3;
+
+    void printUsage()
+    {
+        std::cout << "Usage:" << std::endl
+                  << "  VoicevoxBatchRender --scores <directory> [options]" << std::endl
+                  << "  VoicevoxBatchRender --talk <text file> [options]" << std::endl
+                  << "  VoicevoxBatchRender --script <script file> [options]" << std::endl
+                  << std::endl
+                  << "A script has one line per row, \"speaker<TAB>text[<TAB>gap in seconds]\", and renders into one wav file." << std::endl
+                  << std::endl
+                  << "Options:" << std::endl
+                  << "  --output <directory>  Where the wav files are written. (default: ./BatchRenderOutput)" << std::endl
+                  << "  --speaker <id>        Speaker id or speaker identifier. (default: the first speaker)" << std::endl
+                  << "  --jobs <count>        Number of engines rendering in parallel. (default: "
+                  << VoicevoxEnginePool::getDefaultNumEngines() << ")" << std::endl
+                  << "  --gap <seconds>       Silence after a script line without a gap of its own. (default: "
+                  << kDefaultScriptGapInSeconds << ")" << std::endl
+                  << "  --model-variant <name> default, int8 or fp16. (default: "
+                  << VoicevoxModelVariants::kEnvironmentVariableName << ", or default)" << std::endl;
+    }
+
+    // Accepts "--name value" pairs.
+    juce::StringPairArray parseOptions(const juce::StringArray& arguments)
+    {
+        juce::StringPairArray options;
+        for (int argument_idx = 0; argument_idx < arguments.size(); argument_idx++)
+        {
+            const auto& argument = arguments[argument_idx];
+            if (argument.startsWith("--") && argument_idx + 1 < arguments.size())
+            {
+                options.set(argument.substring(2), arguments[++argument_idx]);
+            }
+        }
+
+        return options;
+    }
+
+    std::optional<juce::int64> resolveSpeakerId(VoicevoxEnginePool& enginePool, const juce::String& speaker, const juce::StringArray& defaultSpeakerIdentifiers)
+    {
+        if (speaker.containsOnly("0123456789") && speaker.isNotEmpty())
+        {
+            return speaker.getLargeIntValue();
+        }
+
+        const auto speaker_map = enginePool.getSpeakerIdentifierToSpeakerIdMap();
+        const auto speaker_identifier = speaker.isNotEmpty() ? speaker : defaultSpeakerIdentifiers[0];
+
+        const auto it = speaker_map.find(speaker_identifier);
+        if (it == speaker_map.end())
+        {
+            return std::nullopt;
+        }
+
+        return (juce::int64)it->second;
+    }
+
+    int renderScript(VoicevoxEnginePool& enginePool, const juce::File& scriptFile, const juce::File& outputDirectory,
+                     const juce::String& defaultSpeaker, double defaultGapInSeconds)
+    {
+        juce::String error_message;
+        const auto lines = TalkScript::parse(scriptFile.loadFileAsString(),
+            [&](const juce::String& speaker) {
+                return resolveSpeakerId(enginePool, speaker.isNotEmpty() ? speaker : defaultSpeaker, enginePool.getTalkSpeakerIdentifierList());
+            },
+            defaultGapInSeconds, error_message);
+
+        if (!lines.has_value())
+        {
+            std::cerr << scriptFile.getFileName() << ": " << error_message << std::endl;
+            return 1;
+        }
+
+        std::cout << "Rendering " << (int)lines->size() << " script line(s)" << std::endl;
+
+        juce::CriticalSection output_lock;
+
+        BatchRenderer batch_renderer(enginePool);
+        const auto result = batch_renderer.renderTalkScript(lines.value(),
+            [&](const TalkScriptProgress& progress) {
+                const juce::ScopedLock scoped_lock(output_lock);
+                std::cout << "[" << progress.numLinesFinished << "/" << progress.numLines << "] line " << progress.lineIndex + 1
+                          << (progress.succeeded ? "" : " FAILED")
+                          << ": render " << juce::String(progress.renderTimeMs, 1) << " ms" << std::endl;
+            });
+
+        // Where each line landed, for lining the timeline up against the script.
+        for (size_t line_idx = 0; line_idx < result.lineTimings.size(); line_idx++)
+        {
+            const auto& line_timing = result.lineTimings[line_idx];
+            std::cout << "line " << (int)line_idx + 1
+                      << (line_timing.succeeded ? "" : " FAILED")
+                      << ": start " << juce::String(line_timing.startTimeInSeconds, 3) << " s"
+                      << ", length " << juce::String(line_timing.lengthInSeconds, 3) << " s"
+                      << ", render " << juce::String(line_timing.renderTimeMs, 1) << " ms" << std::endl;
+        }
+
+        const auto output_file = outputDirectory.getChildFile(scriptFile.getFileNameWithoutExtension() + ".wav");
+        const bool is_written = result.timeline.has_value() && WavAudioCodec::writeWavFile(output_file, result.timeline.value());
+
+        const auto audio_length_in_seconds = result.timeline.has_value() ? result.timeline->audioBuffer.getNumSamples() / result.timeline->sampleRate : 0.0;
+        std::cout << "Total: " << (int)result.lineTimings.size() << " line(s), " << result.getNumFailedLines() << " failed"
+                  << ", wall " << juce::String(result.wallTimeMs / 1000.0, 2) << " s"
+                  << ", audio " << juce::String(audio_length_in_seconds, 2) << " s"
+                  << ", RTF " << juce::String(audio_length_in_seconds > 0.0 ? (result.wallTimeMs / 1000.0) / audio_length_in_seconds : 0.0, 3)
+                  << (is_written ? ", written to " + output_file.getFullPathName() : juce::String(", nothing written"))
+                  << std::endl;
+
+        return is_written && result.getNumFailedLines() == 0 ? 0 : 2;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juce_initialiser;
+
+    juce::StringArray arguments;
+    for (int argument_idx = 1; argument_idx < argc; argument_idx++)
+    {
+        arguments.add(juce::CharPointer_UTF8(argv[argument_idx]));
+    }
+
+    const auto options = parseOptions(arguments);
+    const bool is_score_mode = options.containsKey("scores");
+    const bool is_talk_mode = options.containsKey("talk");
+    const bool is_script_mode = options.containsKey("script");
+    if ((int)is_score_mode + (int)is_talk_mode + (int)is_script_mode != 1)
+    {
+        printUsage();
+        return 1;
+    }
+
+    const auto working_directory = juce::File::getCurrentWorkingDirectory();
+    const auto input = working_directory.getChildFile(is_score_mode ? options["scores"] : is_talk_mode ? options["talk"] : options["script"]);
+    const auto output_directory = working_directory.getChildFile(options.containsKey("output") ? options["output"] : "BatchRenderOutput");
+    const int num_jobs = options.containsKey("jobs") ? juce::jmax(1, options["jobs"].getIntValue()) : VoicevoxEnginePool::getDefaultNumEngines();
+    const auto model_variant = options.containsKey("model-variant") ? VoicevoxModelVariants::fromString(options["model-variant"])
+                                                                    : VoicevoxModelVariants::getFromEnvironment();
+
+    if (!model_variant.has_value())
+    {
+        std::cerr << "Unknown model variant: " << options["model-variant"] << std::endl;
+        return 1;
+    }
+
+    if (!input.exists())
+    {
+        std::cerr << "Input not found: " << input.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    if (!output_directory.createDirectory())
+    {
+        std::cerr << "Could not create output directory: " << output_directory.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    // Engines are started once up front, so model loading is not counted against any file.
+    const auto engine_start_time_ms = juce::Time::getMillisecondCounterHiRes();
+    VoicevoxEnginePool engine_pool(num_jobs);
+    auto pool_settings = engine_pool.getSettings();
+    pool_settings.modelVariant = model_variant.value();
+    engine_pool.setSettings(pool_settings);
+    engine_pool.start();
+    std::cout << "Started " << engine_pool.getNumEngines() << " engine(s) in "
+              << juce::String(juce::Time::getMillisecondCounterHiRes() - engine_start_time_ms, 1) << " ms" << std::endl;
+
+    if (is_script_mode)
+    {
+        const auto gap_in_seconds = options.containsKey("gap") ? juce::jmax(0.0, options["gap"].getDoubleValue()) : kDefaultScriptGapInSeconds;
+        const auto exit_code = renderScript(engine_pool, input, output_directory, options["speaker"], gap_in_seconds);
+
+        engine_pool.shutdown();
+
+        return exit_code;
+    }
+
+    const auto speaker_id = resolveSpeakerId(engine_pool, options["speaker"],
+                                             is_score_mode ? engine_pool.getHummingSpeakerIdentifierList() : engine_pool.getTalkSpeakerIdentifierList());
+    if (!speaker_id.has_value())
+    {
+        std::cerr << "Unknown speaker: " << options["speaker"] << std::endl;
+        engine_pool.shutdown();
+        return 1;
+    }
+
+    const auto items = is_score_mode ? BatchRenderer::loadScoreItems(input, speaker_id.value())
+                                     : BatchRenderer::loadTalkItems(input, speaker_id.value());
+
+    std::cout << "Rendering " << (int)items.size() << " item(s) with speaker " << speaker_id.value() << std::endl;
+
+    juce::CriticalSection output_lock;
+    std::atomic<int> num_failed{ 0 };
+
+    const auto batch_start_time_ms = juce::Time::getMillisecondCounterHiRes();
+
+    BatchRenderer batch_renderer(engine_pool);
+    const auto results = batch_renderer.render(items,
+        [&](int /*itemIndex*/, const BatchRenderResult& result) {
+            const bool is_written = result.succeeded
+                                    && WavAudioCodec::writeWavFile(output_directory.getChildFile(result.name + ".wav"), result.audioBufferInfo.value());
+            if (!is_written)
+            {
+                num_failed++;
+            }
+
+            const juce::ScopedLock scoped_lock(output_lock);
+            std::cout << result.name
+                      << (is_written ? "" : " FAILED")
+                      << ": wall " << juce::String(result.wallTimeMs, 1) << " ms"
+                      << ", audio " << juce::String(result.audioLengthInSeconds, 2) << " s"
+                      << ", RTF " << juce::String(result.getRealTimeFactor(), 3) << std::endl;
+        });
+
+    const auto batch_wall_time_ms = juce::Time::getMillisecondCounterHiRes() - batch_start_time_ms;
+
+    double total_audio_length_in_seconds = 0.0;
+    for (const auto& result : results)
+    {
+        total_audio_length_in_seconds += result.audioLengthInSeconds;
+    }
+
+    // Throughput is measured on the whole batch, so it reflects the parallelism.
+    std::cout << "Total: " << (int)results.size() << " item(s), " << num_failed.load() << " failed"
+              << ", wall " << juce::String(batch_wall_time_ms / 1000.0, 2) << " s"
+              << ", audio " << juce::String(total_audio_length_in_seconds, 2) << " s"
+              << ", RTF " << juce::String(total_audio_length_in_seconds > 0.0 ? (batch_wall_time_ms / 1000.0) / total_audio_length_in_seconds : 0.0, 3)
+              << std::endl;
+
+    engine_pool.shutdown();
+
+    return num_failed.load() == 0 ? 0 : 2;
+}
@@ -0,0 +1,142 @@
+#include "AudioCallbackSimulator.h"
+
+namespace
+{
+    // Enough for several minutes of blocks, so that percentiles cover a whole corpus.
+    constexpr int kMaxNumRecordedCallbacks = 1 << 16;
+    constexpr int kNumCalibrationBlocks = 200;
+    constexpr float kFilterCoefficient = 0.05f;
+}
+
+//==============================================================================
+AudioCallbackSimulator::AudioCallbackSimulator(const Settings& settingsToUse)
+    : juce::Thread("AudioCallbackSimulator")
+    , settings(settingsToUse)
+    , blockPeriodMs(1000.0 * settingsToUse.blockSize / settingsToUse.sampleRate)
+    , buffer(settingsToUse.numChannels, settingsToUse.blockSize)
+    , filterStates((size_t)settingsToUse.numChannels, 0.0f)
+    , oscillatorPhase(0.0f)
+    , numPasses(1)
+    , numCallbacks(0)
+    , numXruns(0)
+    , isRealtime(false)
+    , wakeUpDelayRecorder(kMaxNumRecordedCallbacks)
+    , callbackTimeRecorder(kMaxNumRecordedCallbacks)
+{
+}
+
+AudioCallbackSimulator::~AudioCallbackSimulator()
+{
+    stopThread(-1);
+}
+
+//==============================================================================
+void AudioCallbackSimulator::start()
+{
+    // Calibrated before the engines get busy, so that the load is what the host would need on an idle machine.
+    numPasses = calibrateNumPasses();
+
+    isRealtime = startRealtimeThread(juce::Thread::RealtimeOptions{}.withPeriodMs(blockPeriodMs));
+    if (!isRealtime)
+    {
+        // Without the rights for realtime scheduling, which is what a host without them gets too.
+        startThread(juce::Thread::Priority::highest);
+    }
+}
+
+AudioCallbackSimulator::Result AudioCallbackSimulator::stop()
+{
+    stopThread(-1);
+
+    Result result;
+    result.numCallbacks = numCallbacks.load();
+    result.numXruns = numXruns.load();
+    result.isRealtime = isRealtime;
+    result.wakeUpDelay = wakeUpDelayRecorder.getPercentiles();
+    result.callbackTime = callbackTimeRecorder.getPercentiles();
+
+    return result;
+}
+
+//==============================================================================
+void AudioCallbackSimulator::run()
+{
+    using Clock = std::chrono::steady_clock;
+    const auto block_period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(blockPeriodMs));
+
+    auto due_time = Clock::now() + block_period;
+
+    while (!threadShouldExit())
+    {
+        std::this_thread::sleep_until(due_time);
+
+        const auto callback_start_time = Clock::now();
+        processBlock();
+        const auto callback_end_time = Clock::now();
+
+        wakeUpDelayRecorder.record(std::chrono::duration<double, std::milli>(callback_start_time - due_time).count());
+        callbackTimeRecorder.record(std::chrono::duration<double, std::milli>(callback_end_time - callback_start_time).count());
+        numCallbacks++;
+
+        due_time += block_period;
+        if (callback_end_time > due_time)
+        {
+            // The driver would have played a gap; it carries on with the next block due from now.
+            numXruns++;
+            while (due_time < callback_end_time)
+            {
+                due_time += block_period;
+            }
+        }
+    }
+}
+
+//==============================================================================
+void AudioCallbackSimulator::processBlock()
+{
+    // An oscillator through a one-pole low-pass per channel, repeated to reach the configured load.
+    const auto phase_increment = juce::MathConstants<float>::twoPi * 440.0f / (float)settings.sampleRate;
+
+    for (int pass_idx = 0; pass_idx < numPasses; pass_idx++)
+    {
+        for (int channel_idx = 0; channel_idx < buffer.getNumChannels(); channel_idx++)
+        {
+            auto* samples = buffer.getWritePointer(channel_idx);
+            auto& filter_state = filterStates[(size_t)channel_idx];
+            auto phase = oscillatorPhase;
+
+            for (int sample_idx = 0; sample_idx < buffer.getNumSamples(); sample_idx++)
+            {
+                filter_state += kFilterCoefficient * (std::sin(phase) - filter_state);
+                samples[sample_idx] = filter_state;
+
+                phase += phase_increment;
+                if (phase >= juce::MathConstants<float>::twoPi)
+                {
+                    phase -= juce::MathConstants<float>::twoPi;
+                }
+            }
+        }
+    }
+
+    oscillatorPhase = std::fmod(oscillatorPhase + phase_increment * (float)buffer.getNumSamples(), juce::MathConstants<float>::twoPi);
+}
+
+int AudioCallbackSimulator::calibrateNumPasses()
+{
+    numPasses = 1;
+
+    const auto start_time_ms = juce::Time::getMillisecondCounterHiRes();
+    for (int block_idx = 0; block_idx < kNumCalibrationBlocks; block_idx++)
+    {
+        processBlock();
+    }
+    const auto time_per_pass_ms = (juce::Time::getMillisecondCounterHiRes() - start_time_ms) / kNumCalibrationBlocks;
+
+    if (time_per_pass_ms <= 0.0)
+    {
+        return 1;
+    }
+
+    return juce::jmax(1, juce::roundToInt(blockPeriodMs * settings.load / time_per_pass_ms));
+}
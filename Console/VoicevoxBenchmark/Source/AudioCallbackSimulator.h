@@ -0,0 +1,73 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "Metrics/LatencyRecorder.h"
+
+//==============================================================================
+// AudioCallbackSimulator
+//
+// Stands in for a host while the engines render: a realtime thread calls a
+// simulated processBlock once per block period, as an audio driver would,
+// and spends a fixed share of the period on signal processing. A callback
+// that has not finished by the time the next block is due is an xrun.
+//==============================================================================
+class AudioCallbackSimulator final
+    : private juce::Thread
+{
+public:
+    //==============================================================================
+    struct Settings
+    {
+        double sampleRate{ 48000.0 };
+        int blockSize{ 256 };
+        int numChannels{ 2 };
+        // Share of the block period the simulated processBlock works for on an idle machine.
+        double load{ 0.3 };
+    };
+
+    struct Result
+    {
+        juce::int64 numCallbacks{ 0 };
+        juce::int64 numXruns{ 0 };
+        bool isRealtime{ false };
+        // How late each callback started after its block was due.
+        LatencyRecorder::Percentiles wakeUpDelay;
+        // How long each callback took.
+        LatencyRecorder::Percentiles callbackTime;
+    };
+
+    //==============================================================================
+    explicit AudioCallbackSimulator(const Settings& settings);
+    ~AudioCallbackSimulator() override;
+
+    //==============================================================================
+    void start();
+    Result stop();
+
+private:
+    //==============================================================================
+    // juce::Thread
+    void run() override;
+
+    //==============================================================================
+    void processBlock();
+    // Finds how many passes over the buffer take the configured share of a block period.
+    int calibrateNumPasses();
+
+    //==============================================================================
+    const Settings settings;
+    const double blockPeriodMs;
+
+    juce::AudioBuffer<float> buffer;
+    std::vector<float> filterStates;
+    float oscillatorPhase;
+    int numPasses;
+
+    std::atomic<juce::int64> numCallbacks;
+    std::atomic<juce::int64> numXruns;
+    bool isRealtime;
+    LatencyRecorder wakeUpDelayRecorder;
+    LatencyRecorder callbackTimeRecorder;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioCallbackSimulator)
+};
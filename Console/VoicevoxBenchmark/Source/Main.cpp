@@ -0,0 +1,159 @@
+#include <juce_events/juce_events.h>
+#include "SynthesisBenchmark.h"
+#include "Engine/SynthesisThreadPriority.h"
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "Usage:" << std::endl
+                  << "  VoicevoxBenchmark [options]" << std::endl
+                  << std::endl
+                  << "Options:" << std::endl
+                  << "  --scores <directory>        Directory of the E2E scores. (default: ./Test/E2E)" << std::endl
+                  << "  --talk-corpus <text file>   One sentence per line. (default: the built-in corpus)" << std::endl
+                  << "  --song-speakers <a,b,...>   Speaker ids or identifiers. (default: the first humming speaker)" << std::endl
+                  << "  --talk-speakers <a,b,...>   Speaker ids or identifiers. (default: the first talk speaker)" << std::endl
+                  << "  --engines <n,m,...>         Numbers of engines rendering concurrently. (default: 1)" << std::endl
+                  << "  --iterations <count>        Passes over each corpus. (default: 3)" << std::endl
+                  << "  --long-song-phrases <count> Phrases of the song rendered one by one and batched; 0 skips it. (default: 50)" << std::endl
+                  << "  --map-dictionary <on|off>   Map the dictionary before the engines start. (default: on)" << std::endl
+                  << "  --model-variant <name>      Models the engines load: default, int8 or fp16. (default: default)" << std::endl
+                  << "  --model-label <name>        Names the model set in the report. (default: the model variant)" << std::endl
+                  << "  --write-renders <directory> Writes the first pass over each corpus as float wav." << std::endl
+                  << "  --reference-renders <dir>   Reports the SNR of each render against the wav written there before." << std::endl
+                  << "  --audio-callback <on|off>   Simulates a host audio callback during each corpus and reports its xruns. (default: off)" << std::endl
+                  << "  --synthesis-priority <low|normal> Priority of the synthesis threads. (default: low)" << std::endl
+                  << "  --output <json file>        Where the report is written. (default: stdout)" << std::endl;
+    }
+
+    // Accepts "--name value" pairs.
+    juce::StringPairArray parseOptions(const juce::StringArray& arguments)
+    {
+        juce::StringPairArray options;
+        for (int argument_idx = 0; argument_idx < arguments.size(); argument_idx++)
+        {
+            const auto& argument = arguments[argument_idx];
+            if (argument.startsWith("--") && argument_idx + 1 < arguments.size())
+            {
+                options.set(argument.substring(2), arguments[++argument_idx]);
+            }
+        }
+
+        return options;
+    }
+
+    juce::StringArray splitList(const juce::String& list)
+    {
+        auto items = juce::StringArray::fromTokens(list, ",", "");
+        items.trim();
+        items.removeEmptyStrings();
+        return items;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juce_initialiser;
+
+    juce::StringArray arguments;
+    for (int argument_idx = 1; argument_idx < argc; argument_idx++)
+    {
+        arguments.add(juce::CharPointer_UTF8(argv[argument_idx]));
+    }
+
+    if (arguments.contains("--help"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    const auto options = parseOptions(arguments);
+    const auto working_directory = juce::File::getCurrentWorkingDirectory();
+
+    SynthesisBenchmark::Options benchmark_options;
+    benchmark_options.scoreDirectory = working_directory.getChildFile(options.containsKey("scores") ? options["scores"] : "Test/E2E");
+    benchmark_options.talkCorpus = SynthesisBenchmark::getDefaultTalkCorpus();
+    benchmark_options.songSpeakers = splitList(options["song-speakers"]);
+    benchmark_options.talkSpeakers = splitList(options["talk-speakers"]);
+
+    if (options.containsKey("talk-corpus"))
+    {
+        working_directory.getChildFile(options["talk-corpus"]).readLines(benchmark_options.talkCorpus);
+        benchmark_options.talkCorpus.removeEmptyStrings();
+    }
+
+    if (options.containsKey("engines"))
+    {
+        benchmark_options.engineCounts.clear();
+        for (const auto& engine_count : splitList(options["engines"]))
+        {
+            benchmark_options.engineCounts.add(juce::jmax(1, engine_count.getIntValue()));
+        }
+    }
+
+    if (options.containsKey("model-variant"))
+    {
+        const auto model_variant = VoicevoxModelVariants::fromString(options["model-variant"]);
+        if (!model_variant.has_value())
+        {
+            std::cerr << "Unknown model variant: " << options["model-variant"] << std::endl;
+            return 1;
+        }
+
+        benchmark_options.modelVariant = model_variant.value();
+    }
+
+    benchmark_options.modelLabel = options.containsKey("model-label") ? options["model-label"]
+                                                                      : VoicevoxModelVariants::toString(benchmark_options.modelVariant);
+
+    if (options.containsKey("write-renders"))
+    {
+        benchmark_options.renderOutputDirectory = working_directory.getChildFile(options["write-renders"]);
+    }
+
+    if (options.containsKey("reference-renders"))
+    {
+        benchmark_options.referenceRenderDirectory = working_directory.getChildFile(options["reference-renders"]);
+    }
+
+    benchmark_options.simulateAudioCallback = options["audio-callback"] == "on";
+
+    // Process wide, so set before any engine thread starts.
+    SynthesisThreadPriority::setEnabled(options["synthesis-priority"] != "normal");
+
+    if (options.containsKey("map-dictionary"))
+    {
+        benchmark_options.mapDictionary = options["map-dictionary"] != "off";
+    }
+
+    if (options.containsKey("long-song-phrases"))
+    {
+        benchmark_options.numLongSongPhrases = juce::jmax(0, options["long-song-phrases"].getIntValue());
+    }
+
+    if (options.containsKey("iterations"))
+    {
+        benchmark_options.numIterations = juce::jmax(1, options["iterations"].getIntValue());
+    }
+
+    const auto report = SynthesisBenchmark(benchmark_options).run();
+    const auto report_json = juce::JSON::toString(report);
+
+    if (options.containsKey("output"))
+    {
+        const auto output_file = working_directory.getChildFile(options["output"]);
+        if (!output_file.replaceWithText(report_json))
+        {
+            std::cerr << "Could not write report: " << output_file.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << report_json << std::endl;
+    }
+
+    return 0;
+}
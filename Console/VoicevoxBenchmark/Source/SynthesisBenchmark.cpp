@@ -0,0 +1,571 @@
+#include "SynthesisBenchmark.h"
+#include "AudioCallbackSimulator.h"
+#include "Audio/WavAudioCodec.h"
+#include "Engine/SynthesisThreadPriority.h"
+#include "Engine/VoicevoxQueryClient.h"
+#include "Metrics/AudioComparison.h"
+#include "Metrics/ProcessMemory.h"
+#include "Score/ScorePhraseBatcher.h"
+
+namespace
+{
+    // Bumped whenever the layout of the report changes.
+    constexpr int kReportSchemaVersion = 8;
+}
+
+//==============================================================================
+SynthesisBenchmark::SynthesisBenchmark(const Options& optionsToUse)
+    : options(optionsToUse)
+{
+}
+
+SynthesisBenchmark::~SynthesisBenchmark()
+{
+}
+
+//==============================================================================
+juce::var SynthesisBenchmark::run()
+{
+    juce::DynamicObject::Ptr report = new juce::DynamicObject();
+    report->setProperty("schema_version", kReportSchemaVersion);
+    report->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    report->setProperty("system", makeSystemInfo());
+    report->setProperty("model_label", options.modelLabel);
+    report->setProperty("model_variant", VoicevoxModelVariants::toString(options.modelVariant));
+
+    juce::Array<juce::var> runs;
+    for (const auto num_engines : options.engineCounts)
+    {
+        runs.add(runEngineCount(num_engines));
+    }
+    report->setProperty("runs", runs);
+
+    return juce::var(report.get());
+}
+
+//==============================================================================
+juce::StringArray SynthesisBenchmark::getDefaultTalkCorpus()
+{
+    // Fixed sentences of increasing length, so numbers stay comparable between versions.
+    return {
+        juce::CharPointer_UTF8("こんにちは。"),
+        juce::CharPointer_UTF8("今日はいい天気ですね。"),
+        juce::CharPointer_UTF8("明日の天気は晴れのち曇り、午後から雨が降るでしょう。"),
+        juce::CharPointer_UTF8("音声合成エンジンの処理速度を、いくつかの文章で測定しています。"),
+        juce::CharPointer_UTF8("吾輩は猫である。名前はまだ無い。どこで生れたかとんと見当がつかぬ。"),
+        juce::CharPointer_UTF8("何でも薄暗いじめじめした所でニャーニャー泣いていた事だけは記憶している。吾輩はここで始めて人間というものを見た。"),
+    };
+}
+
+//==============================================================================
+juce::var SynthesisBenchmark::runEngineCount(int numEngines)
+{
+    juce::DynamicObject::Ptr run_result = new juce::DynamicObject();
+    run_result->setProperty("num_engines", numEngines);
+
+    // Cold start: creating and starting the engines, including model and dictionary loading.
+    const auto resident_bytes_before_start = ProcessMemory::getResidentSetSizeInBytes();
+    const auto cold_start_time_ms = juce::Time::getMillisecondCounterHiRes();
+    VoicevoxEnginePool engine_pool(numEngines);
+    auto pool_settings = engine_pool.getSettings();
+    pool_settings.mapDictionary = options.mapDictionary;
+    pool_settings.modelVariant = options.modelVariant;
+    engine_pool.setSettings(pool_settings);
+
+    // What a plugin scan or project open waits for before it can show the speakers.
+    const auto metadata_time_ms = juce::Time::getMillisecondCounterHiRes();
+    run_result->setProperty("metadata_cache_hit", engine_pool.loadCachedMetadata());
+    run_result->setProperty("time_to_metadata_ms", juce::Time::getMillisecondCounterHiRes() - metadata_time_ms);
+
+    engine_pool.start();
+    run_result->setProperty("cold_start_ms", juce::Time::getMillisecondCounterHiRes() - cold_start_time_ms);
+    run_result->setProperty("last_engine_start_ms", engine_pool.getStatistics().lastStartDurationMs);
+
+    // The shared part is file-backed, so other processes mapping the same files do not pay for it again.
+    run_result->setProperty("resident_bytes_before_start", (juce::int64)resident_bytes_before_start);
+    run_result->setProperty("resident_bytes_after_start", (juce::int64)ProcessMemory::getResidentSetSizeInBytes());
+    run_result->setProperty("shared_resident_bytes_after_start", (juce::int64)ProcessMemory::getSharedResidentSetSizeInBytes());
+    run_result->setProperty("dictionary", makeDictionaryInfo(engine_pool));
+
+    run_result->setProperty("engine_meta", engine_pool.getMetaJson());
+
+    const auto song_speaker_ids = resolveSpeakerIds(engine_pool, options.songSpeakers, engine_pool.getHummingSpeakerIdentifierList());
+    const auto talk_speaker_ids = resolveSpeakerIds(engine_pool, options.talkSpeakers, engine_pool.getTalkSpeakerIdentifierList());
+
+    // First request: the first talk sentence on a freshly started engine.
+    if (!talk_speaker_ids.isEmpty() && !options.talkCorpus.isEmpty())
+    {
+        const auto first_items = makeTalkItems(talk_speaker_ids.getFirst());
+
+        auto engine_lease = engine_pool.acquire(talk_speaker_ids.getFirst());
+
+        const auto first_request_time_ms = juce::Time::getMillisecondCounterHiRes();
+        VoicevoxEnginePool::renderAndWait(std::move(engine_lease), first_items.front().request);
+        run_result->setProperty("first_request_ms", juce::Time::getMillisecondCounterHiRes() - first_request_time_ms);
+    }
+
+    juce::Array<juce::var> corpus_results;
+    for (const auto speaker_id : song_speaker_ids)
+    {
+        corpus_results.add(measureCorpus(engine_pool, "song", makeSongItems(speaker_id)));
+    }
+
+    for (const auto speaker_id : talk_speaker_ids)
+    {
+        corpus_results.add(measureCorpus(engine_pool, "talk", makeTalkItems(speaker_id)));
+    }
+    run_result->setProperty("corpora", corpus_results);
+
+    if (options.numLongSongPhrases > 0)
+    {
+        juce::Array<juce::var> phrase_batching_results;
+        for (const auto speaker_id : song_speaker_ids)
+        {
+            phrase_batching_results.add(measurePhraseBatching(engine_pool, speaker_id));
+        }
+        run_result->setProperty("phrase_batching", phrase_batching_results);
+    }
+
+    if (!options.talkCorpus.isEmpty())
+    {
+        juce::Array<juce::var> query_path_results;
+        for (const auto speaker_id : talk_speaker_ids)
+        {
+            query_path_results.add(measureQueryPath(engine_pool, speaker_id));
+        }
+        run_result->setProperty("query_path", query_path_results);
+    }
+
+    engine_pool.shutdown();
+
+    return juce::var(run_result.get());
+}
+
+juce::var SynthesisBenchmark::measureCorpus(VoicevoxEnginePool& enginePool, const juce::String& corpusName, const std::vector<BatchRenderItem>& items)
+{
+    juce::DynamicObject::Ptr corpus_result = new juce::DynamicObject();
+    corpus_result->setProperty("corpus", corpusName);
+    corpus_result->setProperty("speaker_id", items.empty() ? juce::var() : juce::var(items.front().request.speakerId));
+
+    std::vector<BatchRenderItem> repeated_items;
+    for (int iteration_idx = 0; iteration_idx < options.numIterations; iteration_idx++)
+    {
+        repeated_items.insert(repeated_items.end(), items.begin(), items.end());
+    }
+
+    std::unique_ptr<AudioCallbackSimulator> audio_callback_simulator;
+    if (options.simulateAudioCallback)
+    {
+        audio_callback_simulator = std::make_unique<AudioCallbackSimulator>(AudioCallbackSimulator::Settings());
+        audio_callback_simulator->start();
+    }
+
+    const auto start_time_ms = juce::Time::getMillisecondCounterHiRes();
+    const auto results = BatchRenderer(enginePool).render(repeated_items);
+    const auto wall_time_ms = juce::Time::getMillisecondCounterHiRes() - start_time_ms;
+
+    if (audio_callback_simulator != nullptr)
+    {
+        const auto simulator_result = audio_callback_simulator->stop();
+
+        juce::DynamicObject::Ptr audio_callback = new juce::DynamicObject();
+        audio_callback->setProperty("realtime", simulator_result.isRealtime);
+        audio_callback->setProperty("num_callbacks", simulator_result.numCallbacks);
+        audio_callback->setProperty("num_xruns", simulator_result.numXruns);
+        audio_callback->setProperty("wake_up_delay_ms", makePercentiles(simulator_result.wakeUpDelay));
+        audio_callback->setProperty("callback_ms", makePercentiles(simulator_result.callbackTime));
+        corpus_result->setProperty("audio_callback", juce::var(audio_callback.get()));
+    }
+
+    std::vector<double> latencies_ms;
+    std::vector<double> real_time_factors;
+    double total_audio_length_in_seconds = 0.0;
+    int num_failed = 0;
+
+    for (const auto& result : results)
+    {
+        if (!result.succeeded)
+        {
+            num_failed++;
+            continue;
+        }
+
+        latencies_ms.push_back(result.wallTimeMs);
+        real_time_factors.push_back(result.getRealTimeFactor());
+        total_audio_length_in_seconds += result.audioLengthInSeconds;
+    }
+
+    corpus_result->setProperty("num_requests", (int)results.size());
+    corpus_result->setProperty("num_failed", num_failed);
+    corpus_result->setProperty("latency_ms", makePercentiles(latencies_ms));
+    corpus_result->setProperty("rtf", makePercentiles(real_time_factors));
+    corpus_result->setProperty("wall_time_ms", wall_time_ms);
+    corpus_result->setProperty("audio_length_sec", total_audio_length_in_seconds);
+
+    // Wall time of the whole corpus over its audio length, so concurrency shows up here.
+    corpus_result->setProperty("throughput_rtf", total_audio_length_in_seconds > 0.0 ? (wall_time_ms / 1000.0) / total_audio_length_in_seconds : 0.0);
+
+    // Only the first pass is kept and compared; the others render the same requests.
+    std::vector<double> signal_to_noise_ratios_db;
+    for (size_t item_idx = 0; item_idx < items.size() && item_idx < results.size(); item_idx++)
+    {
+        const auto& result = results[item_idx];
+        if (!result.succeeded)
+        {
+            continue;
+        }
+
+        const auto render_file_name = corpusName + "_" + juce::String(items[item_idx].request.speakerId) + "_" + result.name + ".wav";
+
+        if (options.renderOutputDirectory != juce::File() && options.renderOutputDirectory.createDirectory())
+        {
+            WavAudioCodec::writeWavFile(options.renderOutputDirectory.getChildFile(render_file_name), result.audioBufferInfo.value(), 32);
+        }
+
+        if (options.referenceRenderDirectory != juce::File())
+        {
+            if (const auto reference = WavAudioCodec::readWavFile(options.referenceRenderDirectory.getChildFile(render_file_name)))
+            {
+                signal_to_noise_ratios_db.push_back(AudioComparison::getSignalToNoiseRatioInDecibels(reference->audioBuffer, result.audioBufferInfo->audioBuffer));
+            }
+        }
+    }
+
+    if (options.referenceRenderDirectory != juce::File())
+    {
+        corpus_result->setProperty("snr_db", makeSignalToNoiseRatios(std::move(signal_to_noise_ratios_db)));
+    }
+
+    return juce::var(corpus_result.get());
+}
+
+juce::var SynthesisBenchmark::measurePhraseBatching(VoicevoxEnginePool& enginePool, juce::int64 speakerId)
+{
+    juce::DynamicObject::Ptr batching_result = new juce::DynamicObject();
+    batching_result->setProperty("speaker_id", speakerId);
+
+    const auto phrases = ScorePhraseSplitter().split(makeLongSongScore(options.numLongSongPhrases), juce::String(speakerId));
+
+    std::vector<const ScorePhrase*> phrase_pointers;
+    int total_phrase_frames = 0;
+    for (const auto& phrase : phrases)
+    {
+        phrase_pointers.push_back(&phrase);
+        total_phrase_frames += phrase.numFrames;
+    }
+
+    // Batched the way the Song plugin does it: at least one batch per engine.
+    const auto batches = ScorePhraseBatcher().makeBatches(phrase_pointers, enginePool.getNumEngines());
+    const auto audio_length_in_seconds = total_phrase_frames / ScorePhraseSplitter::kFramesPerSecond;
+
+    batching_result->setProperty("num_phrases", (int)phrases.size());
+    batching_result->setProperty("num_batches", (int)batches.size());
+    batching_result->setProperty("audio_length_sec", audio_length_in_seconds);
+
+    auto make_item = [speakerId](const juce::String& name, const juce::String& scoreJson) {
+        BatchRenderItem item;
+        item.name = name;
+        item.request.requestId = juce::Uuid();
+        item.request.speakerId = speakerId;
+        item.request.scoreJson = scoreJson;
+        item.request.sampleRate = 24000;
+        item.request.processType = cctn::VoicevoxEngineProcessType::kHumming;
+        return item;
+    };
+
+    std::vector<BatchRenderItem> phrase_items;
+    for (size_t phrase_idx = 0; phrase_idx < phrases.size(); phrase_idx++)
+    {
+        phrase_items.push_back(make_item("phrase_" + juce::String((int)phrase_idx), phrases[phrase_idx].scoreJson));
+    }
+
+    std::vector<BatchRenderItem> batch_items;
+    for (size_t batch_idx = 0; batch_idx < batches.size(); batch_idx++)
+    {
+        batch_items.push_back(make_item("batch_" + juce::String((int)batch_idx), batches[batch_idx].scoreJson));
+    }
+
+    auto measure = [&](const std::vector<BatchRenderItem>& items, std::vector<BatchRenderResult>& results) {
+        const auto start_time_ms = juce::Time::getMillisecondCounterHiRes();
+        results = BatchRenderer(enginePool).render(items);
+        return juce::Time::getMillisecondCounterHiRes() - start_time_ms;
+    };
+
+    std::vector<BatchRenderResult> phrase_results;
+    std::vector<BatchRenderResult> batch_results;
+    const auto phrase_wall_time_ms = measure(phrase_items, phrase_results);
+    const auto batch_wall_time_ms = measure(batch_items, batch_results);
+
+    batching_result->setProperty("one_by_one_wall_time_ms", phrase_wall_time_ms);
+    batching_result->setProperty("one_by_one_throughput_rtf", (phrase_wall_time_ms / 1000.0) / audio_length_in_seconds);
+    batching_result->setProperty("batched_wall_time_ms", batch_wall_time_ms);
+    batching_result->setProperty("batched_throughput_rtf", (batch_wall_time_ms / 1000.0) / audio_length_in_seconds);
+    batching_result->setProperty("speedup", batch_wall_time_ms > 0.0 ? phrase_wall_time_ms / batch_wall_time_ms : 0.0);
+
+    // Phrases cut out of a batch hear a little of their neighbours through the padding rests.
+    std::vector<double> signal_to_noise_ratios_db;
+    for (size_t batch_idx = 0; batch_idx < batches.size(); batch_idx++)
+    {
+        if (!batch_results[batch_idx].succeeded)
+        {
+            continue;
+        }
+
+        const auto& batch = batches[batch_idx];
+        for (int phrase_idx_in_batch = 0; phrase_idx_in_batch < (int)batch.phraseIndices.size(); phrase_idx_in_batch++)
+        {
+            const auto phrase_idx = (size_t)batch.phraseIndices[(size_t)phrase_idx_in_batch];
+            const auto phrase_audio = ScorePhraseBatcher::extractPhraseAudio(batch, phrase_idx_in_batch, phrases[phrase_idx], batch_results[batch_idx].audioBufferInfo.value());
+            if (phrase_audio.has_value() && phrase_results[phrase_idx].succeeded)
+            {
+                signal_to_noise_ratios_db.push_back(AudioComparison::getSignalToNoiseRatioInDecibels(phrase_results[phrase_idx].audioBufferInfo->audioBuffer, phrase_audio->audioBuffer));
+            }
+        }
+    }
+    batching_result->setProperty("snr_db", makeSignalToNoiseRatios(std::move(signal_to_noise_ratios_db)));
+
+    return juce::var(batching_result.get());
+}
+
+juce::var SynthesisBenchmark::measureQueryPath(VoicevoxEnginePool& enginePool, juce::int64 speakerId)
+{
+    juce::DynamicObject::Ptr query_path_result = new juce::DynamicObject();
+    query_path_result->setProperty("speaker_id", speakerId);
+
+    // One engine at a time, so the three stages of a sentence are timed on the same engine without contention.
+    std::vector<double> text_path_times_ms;
+    std::vector<double> audio_query_times_ms;
+    std::vector<double> synthesis_times_ms;
+    double total_text_path_time_ms = 0.0;
+    double total_audio_query_time_ms = 0.0;
+    double total_synthesis_time_ms = 0.0;
+    int num_failed = 0;
+
+    for (int iteration_idx = 0; iteration_idx < options.numIterations; iteration_idx++)
+    {
+        for (const auto& item : makeTalkItems(speakerId))
+        {
+            auto engine_lease = enginePool.acquire(speakerId);
+            if (!engine_lease)
+            {
+                num_failed++;
+                continue;
+            }
+
+            const auto audio_query_start_time_ms = juce::Time::getMillisecondCounterHiRes();
+            const auto audio_query = VoicevoxQueryClient::audioQuery(*engine_lease, speakerId, item.request.text);
+            const auto audio_query_time_ms = juce::Time::getMillisecondCounterHiRes() - audio_query_start_time_ms;
+
+            if (!audio_query.has_value())
+            {
+                num_failed++;
+                continue;
+            }
+
+            // Synthesis from a query already at hand: what a cached or supplied AudioQuery costs.
+            const auto synthesis_start_time_ms = juce::Time::getMillisecondCounterHiRes();
+            const auto synthesis_artefact = VoicevoxQueryClient::synthesis(*engine_lease, item.request.requestId, speakerId, audio_query.value());
+            const auto synthesis_time_ms = juce::Time::getMillisecondCounterHiRes() - synthesis_start_time_ms;
+
+            const auto text_path_start_time_ms = juce::Time::getMillisecondCounterHiRes();
+            const auto text_path_artefact = VoicevoxEnginePool::renderAndWait(std::move(engine_lease), item.request);
+            const auto text_path_time_ms = juce::Time::getMillisecondCounterHiRes() - text_path_start_time_ms;
+
+            if (!synthesis_artefact.wavBinary.has_value() || !text_path_artefact.has_value())
+            {
+                num_failed++;
+                continue;
+            }
+
+            text_path_times_ms.push_back(text_path_time_ms);
+            audio_query_times_ms.push_back(audio_query_time_ms);
+            synthesis_times_ms.push_back(synthesis_time_ms);
+            total_text_path_time_ms += text_path_time_ms;
+            total_audio_query_time_ms += audio_query_time_ms;
+            total_synthesis_time_ms += synthesis_time_ms;
+        }
+    }
+
+    query_path_result->setProperty("num_sentences", (int)text_path_times_ms.size());
+    query_path_result->setProperty("num_failed", num_failed);
+    query_path_result->setProperty("text_path_ms", makePercentiles(text_path_times_ms));
+    query_path_result->setProperty("audio_query_ms", makePercentiles(audio_query_times_ms));
+    query_path_result->setProperty("synthesis_ms", makePercentiles(synthesis_times_ms));
+
+    // The share of a text render spent before the waveform decoder, and what reusing the query saves.
+    query_path_result->setProperty("frontend_share", total_text_path_time_ms > 0.0 ? total_audio_query_time_ms / total_text_path_time_ms : 0.0);
+    query_path_result->setProperty("query_reuse_speedup", total_synthesis_time_ms > 0.0 ? total_text_path_time_ms / total_synthesis_time_ms : 0.0);
+
+    return juce::var(query_path_result.get());
+}
+
+//==============================================================================
+std::vector<BatchRenderItem> SynthesisBenchmark::makeSongItems(juce::int64 speakerId) const
+{
+    std::vector<BatchRenderItem> items;
+    for (const auto& score_file_name : options.scoreFileNames)
+    {
+        const auto score_file = options.scoreDirectory.getChildFile(score_file_name);
+        if (!score_file.existsAsFile())
+        {
+            continue;
+        }
+
+        BatchRenderItem item;
+        item.name = score_file.getFileNameWithoutExtension();
+        item.request.requestId = juce::Uuid();
+        item.request.speakerId = speakerId;
+        item.request.scoreJson = score_file.loadFileAsString();
+        item.request.sampleRate = 24000;
+        item.request.processType = cctn::VoicevoxEngineProcessType::kHumming;
+        items.push_back(std::move(item));
+    }
+
+    return items;
+}
+
+std::vector<BatchRenderItem> SynthesisBenchmark::makeTalkItems(juce::int64 speakerId) const
+{
+    std::vector<BatchRenderItem> items;
+    for (int sentence_idx = 0; sentence_idx < options.talkCorpus.size(); sentence_idx++)
+    {
+        BatchRenderItem item;
+        item.name = "talk_" + juce::String(sentence_idx);
+        item.request.requestId = juce::Uuid();
+        item.request.speakerId = speakerId;
+        item.request.text = options.talkCorpus[sentence_idx];
+        item.request.processType = cctn::VoicevoxEngineProcessType::kTalk;
+        items.push_back(std::move(item));
+    }
+
+    return items;
+}
+
+//==============================================================================
+juce::String SynthesisBenchmark::makeLongSongScore(int numPhrases)
+{
+    // A fixed song of short phrases walking up and down the scale, so numbers stay comparable between versions.
+    const juce::StringArray lyrics{ juce::CharPointer_UTF8("ら"), juce::CharPointer_UTF8("ら"), juce::CharPointer_UTF8("る"),
+                                    juce::CharPointer_UTF8("ら"), juce::CharPointer_UTF8("り"), juce::CharPointer_UTF8("ら") };
+    const int scale_keys[] = { 60, 62, 64, 65, 67, 69, 71, 72 };
+
+    juce::Array<juce::var> notes;
+    auto add_note = [&notes](juce::var key, int frameLength, const juce::String& lyric) {
+        juce::DynamicObject::Ptr note = new juce::DynamicObject();
+        note->setProperty("key", key);
+        note->setProperty("frame_length", frameLength);
+        note->setProperty("lyric", lyric);
+        notes.add(juce::var(note.get()));
+    };
+
+    for (int phrase_idx = 0; phrase_idx < numPhrases; phrase_idx++)
+    {
+        add_note(juce::var(), 30 + 15 * (phrase_idx % 3), "");
+
+        const int num_notes = 3 + phrase_idx % 6;
+        for (int note_idx = 0; note_idx < num_notes; note_idx++)
+        {
+            const int key_idx = (phrase_idx + note_idx) % (int)std::size(scale_keys);
+            add_note(scale_keys[key_idx], 20 + 10 * ((phrase_idx + note_idx) % 4), lyrics[(phrase_idx + note_idx) % lyrics.size()]);
+        }
+    }
+
+    add_note(juce::var(), 30, "");
+
+    juce::DynamicObject::Ptr score = new juce::DynamicObject();
+    score->setProperty("notes", notes);
+
+    return juce::JSON::toString(juce::var(score.get()), true);
+}
+
+juce::Array<juce::int64> SynthesisBenchmark::resolveSpeakerIds(VoicevoxEnginePool& enginePool, const juce::StringArray& speakers, const juce::StringArray& defaultSpeakerIdentifiers)
+{
+    const auto speaker_map = enginePool.getSpeakerIdentifierToSpeakerIdMap();
+    const auto speakers_to_resolve = speakers.isEmpty() ? juce::StringArray(defaultSpeakerIdentifiers[0]) : speakers;
+
+    juce::Array<juce::int64> speaker_ids;
+    for (const auto& speaker : speakers_to_resolve)
+    {
+        if (speaker.isNotEmpty() && speaker.containsOnly("0123456789"))
+        {
+            speaker_ids.add(speaker.getLargeIntValue());
+            continue;
+        }
+
+        const auto it = speaker_map.find(speaker);
+        if (it != speaker_map.end())
+        {
+            speaker_ids.add((juce::int64)it->second);
+        }
+    }
+
+    return speaker_ids;
+}
+
+juce::var SynthesisBenchmark::makePercentiles(std::vector<double> samples)
+{
+    std::sort(samples.begin(), samples.end());
+
+    juce::DynamicObject::Ptr percentiles = new juce::DynamicObject();
+    percentiles->setProperty("p50", LatencyRecorder::getPercentile(samples, 0.50));
+    percentiles->setProperty("p95", LatencyRecorder::getPercentile(samples, 0.95));
+    percentiles->setProperty("p99", LatencyRecorder::getPercentile(samples, 0.99));
+    percentiles->setProperty("max", samples.empty() ? 0.0 : samples.back());
+
+    return juce::var(percentiles.get());
+}
+
+juce::var SynthesisBenchmark::makePercentiles(const LatencyRecorder::Percentiles& percentiles)
+{
+    juce::DynamicObject::Ptr percentiles_object = new juce::DynamicObject();
+    percentiles_object->setProperty("p50", percentiles.p50Ms);
+    percentiles_object->setProperty("p95", percentiles.p95Ms);
+    percentiles_object->setProperty("p99", percentiles.p99Ms);
+    percentiles_object->setProperty("max", percentiles.maxMs);
+
+    return juce::var(percentiles_object.get());
+}
+
+juce::var SynthesisBenchmark::makeSignalToNoiseRatios(std::vector<double> signalToNoiseRatiosInDecibels)
+{
+    std::sort(signalToNoiseRatiosInDecibels.begin(), signalToNoiseRatiosInDecibels.end());
+
+    // The worst render matters most, so the low end is reported rather than the tail.
+    juce::DynamicObject::Ptr signal_to_noise_ratios = new juce::DynamicObject();
+    signal_to_noise_ratios->setProperty("num_compared", (int)signalToNoiseRatiosInDecibels.size());
+    signal_to_noise_ratios->setProperty("min", signalToNoiseRatiosInDecibels.empty() ? 0.0 : signalToNoiseRatiosInDecibels.front());
+    signal_to_noise_ratios->setProperty("p50", LatencyRecorder::getPercentile(signalToNoiseRatiosInDecibels, 0.50));
+
+    return juce::var(signal_to_noise_ratios.get());
+}
+
+juce::var SynthesisBenchmark::makeDictionaryInfo(const VoicevoxEnginePool& enginePool)
+{
+    juce::DynamicObject::Ptr dictionary_info = new juce::DynamicObject();
+
+    const auto load_info = enginePool.getDictionaryLoadInfo();
+    dictionary_info->setProperty("mapped", load_info.has_value());
+    if (load_info.has_value())
+    {
+        dictionary_info->setProperty("num_files", load_info->numFiles);
+        dictionary_info->setProperty("bytes", (juce::int64)load_info->numBytes);
+        dictionary_info->setProperty("map_ms", load_info->mapTimeMs);
+        dictionary_info->setProperty("touch_ms", load_info->touchTimeMs);
+    }
+
+    return juce::var(dictionary_info.get());
+}
+
+juce::var SynthesisBenchmark::makeSystemInfo()
+{
+    juce::DynamicObject::Ptr system_info = new juce::DynamicObject();
+    system_info->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    system_info->setProperty("cpu_model", juce::SystemStats::getCpuModel());
+    system_info->setProperty("num_cpus", juce::SystemStats::getNumCpus());
+    system_info->setProperty("num_physical_cpus", juce::SystemStats::getNumPhysicalCpus());
+    system_info->setProperty("memory_mb", juce::SystemStats::getMemorySizeInMegabytes());
+    system_info->setProperty("synthesis_priority_lowered", SynthesisThreadPriority::isEnabled());
+    system_info->setProperty("synthesis_affinity_mask", (juce::int64)SynthesisThreadPriority::getAffinityMask());
+
+    return juce::var(system_info.get());
+}
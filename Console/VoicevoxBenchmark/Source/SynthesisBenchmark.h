@@ -0,0 +1,83 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "Batch/BatchRenderer.h"
+#include "Metrics/LatencyRecorder.h"
+
+//==============================================================================
+// SynthesisBenchmark
+//
+// Measures the engine on fixed corpora for every combination of speaker and
+// number of engines rendering concurrently, and reports the numbers as json.
+//==============================================================================
+class SynthesisBenchmark final
+{
+public:
+    //==============================================================================
+    struct Options
+    {
+        juce::File scoreDirectory;
+        juce::StringArray scoreFileNames{ "score.json", "doremi.json", "doremi2.json", "all_mora.json" };
+        juce::StringArray talkCorpus;
+
+        // Speaker ids or identifiers; empty means the first speaker of each kind.
+        juce::StringArray songSpeakers;
+        juce::StringArray talkSpeakers;
+
+        // Phrases of the generated song rendered one by one and batched; 0 skips the comparison.
+        int numLongSongPhrases{ 50 };
+
+        juce::Array<int> engineCounts{ 1 };
+        int numIterations{ 3 };
+
+        // Whether the engines start on a memory-mapped dictionary; compare both in fresh processes.
+        bool mapDictionary{ true };
+
+        // Loaded by every engine of every run; compare variants against the renders of the default models.
+        VoicevoxModelVariant modelVariant{ VoicevoxModelVariant::kDefault };
+        // Names the model set in the report.
+        juce::String modelLabel;
+        // Where the first pass over each corpus is written as float wav, when set.
+        juce::File renderOutputDirectory;
+        // Renders written by an earlier run to compare against, typically with the default models, when set.
+        juce::File referenceRenderDirectory;
+
+        // Runs an AudioCallbackSimulator while each corpus renders and reports its xruns.
+        bool simulateAudioCallback{ false };
+    };
+
+    //==============================================================================
+    explicit SynthesisBenchmark(const Options& options);
+    ~SynthesisBenchmark();
+
+    //==============================================================================
+    // Runs every configuration and returns the report.
+    juce::var run();
+
+    //==============================================================================
+    static juce::StringArray getDefaultTalkCorpus();
+
+private:
+    //==============================================================================
+    juce::var runEngineCount(int numEngines);
+    juce::var measureCorpus(VoicevoxEnginePool& enginePool, const juce::String& corpusName, const std::vector<BatchRenderItem>& items);
+
+    juce::var measurePhraseBatching(VoicevoxEnginePool& enginePool, juce::int64 speakerId);
+    juce::var measureQueryPath(VoicevoxEnginePool& enginePool, juce::int64 speakerId);
+
+    std::vector<BatchRenderItem> makeSongItems(juce::int64 speakerId) const;
+    std::vector<BatchRenderItem> makeTalkItems(juce::int64 speakerId) const;
+
+    static juce::String makeLongSongScore(int numPhrases);
+    static juce::Array<juce::int64> resolveSpeakerIds(VoicevoxEnginePool& enginePool, const juce::StringArray& speakers, const juce::StringArray& defaultSpeakerIdentifiers);
+    static juce::var makePercentiles(std::vector<double> samples);
+    static juce::var makePercentiles(const LatencyRecorder::Percentiles& percentiles);
+    static juce::var makeSignalToNoiseRatios(std::vector<double> signalToNoiseRatiosInDecibels);
+    static juce::var makeSystemInfo();
+    static juce::var makeDictionaryInfo(const VoicevoxEnginePool& enginePool);
+
+    //==============================================================================
+    const Options options;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SynthesisBenchmark)
+};
@@ -0,0 +1,110 @@
+#include <juce_events/juce_events.h>
+#include "SynthesisDaemonServer.h"
+#include "Metrics/ProcessMemory.h"
+
+namespace
+{
+    constexpr int kStatusIntervalMs = 60 * 1000;
+
+    void printUsage()
+    {
+        std::cout << "Usage:" << std::endl
+                  << "  VoicevoxSynthesisDaemon [options]" << std::endl
+                  << std::endl
+                  << "Runs until it is killed. Plugins started with "
+                  << SynthesisDaemonProtocol::kPortEnvironmentVariableName << "=<port> render through it." << std::endl
+                  << std::endl
+                  << "Options:" << std::endl
+                  << "  --port <port>     Port on 127.0.0.1. (default: " << SynthesisDaemonProtocol::kDefaultPort << ")" << std::endl
+                  << "  --engines <count> Number of engines rendering in parallel. (default: "
+                  << VoicevoxEnginePool::getDefaultNumEngines() << ")" << std::endl
+                  << "  --cores <count>   Number of requests rendering at once. (default: "
+                  << InferenceScheduler::kCoreBudgetEnvironmentVariableName << ", or the engine count)" << std::endl
+                  << "  --model-variant <name> default, int8 or fp16. (default: "
+                  << VoicevoxModelVariants::kEnvironmentVariableName << ", or default)" << std::endl;
+    }
+
+    // Accepts "--name value" pairs.
+    juce::StringPairArray parseOptions(const juce::StringArray& arguments)
+    {
+        juce::StringPairArray options;
+        for (int argument_idx = 0; argument_idx < arguments.size(); argument_idx++)
+        {
+            const auto& argument = arguments[argument_idx];
+            if (argument.startsWith("--") && argument_idx + 1 < arguments.size())
+            {
+                options.set(argument.substring(2), arguments[++argument_idx]);
+            }
+        }
+
+        return options;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juce_initialiser;
+
+    juce::StringArray arguments;
+    for (int argument_idx = 1; argument_idx < argc; argument_idx++)
+    {
+        arguments.add(juce::CharPointer_UTF8(argv[argument_idx]));
+    }
+
+    if (arguments.contains("--help"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    const auto options = parseOptions(arguments);
+    const int port = options.containsKey("port") ? options["port"].getIntValue() : SynthesisDaemonProtocol::kDefaultPort;
+    const int num_engines = options.containsKey("engines") ? juce::jmax(1, options["engines"].getIntValue()) : VoicevoxEnginePool::getDefaultNumEngines();
+    const int core_budget = options.containsKey("cores") ? juce::jmax(1, options["cores"].getIntValue()) : InferenceScheduler::getDefaultCoreBudget(num_engines);
+    const auto model_variant = options.containsKey("model-variant") ? VoicevoxModelVariants::fromString(options["model-variant"])
+                                                                    : VoicevoxModelVariants::getFromEnvironment();
+
+    if (!model_variant.has_value())
+    {
+        std::cerr << "Unknown model variant: " << options["model-variant"] << std::endl;
+        return 1;
+    }
+
+    // Models are loaded once here, for every plugin that connects.
+    const auto engine_start_time_ms = juce::Time::getMillisecondCounterHiRes();
+    VoicevoxEnginePool engine_pool(num_engines);
+    auto pool_settings = engine_pool.getSettings();
+    pool_settings.modelVariant = model_variant.value();
+    engine_pool.setSettings(pool_settings);
+    engine_pool.start();
+    std::cout << "Started " << engine_pool.getNumEngines() << " engine(s) with the "
+              << VoicevoxModelVariants::toString(model_variant.value()) << " models in "
+              << juce::String(juce::Time::getMillisecondCounterHiRes() - engine_start_time_ms, 1) << " ms"
+              << ", resident " << ProcessMemory::formatBytes(ProcessMemory::getResidentSetSizeInBytes())
+              << ", core budget " << core_budget << std::endl;
+
+    SynthesisDaemonServer server(engine_pool, core_budget);
+    if (!server.start(port))
+    {
+        std::cerr << "Could not listen on 127.0.0.1:" << port << std::endl;
+        engine_pool.shutdown();
+        return 1;
+    }
+
+    std::cout << "Listening on 127.0.0.1:" << port
+              << ", shared memory in " << SynthesisDaemonProtocol::getSharedMemoryDirectory().getFullPathName() << std::endl;
+
+    while (true)
+    {
+        juce::Thread::sleep(kStatusIntervalMs);
+
+        const auto statistics = server.getStatistics();
+        std::cout << "Connections: " << statistics.numConnections
+                  << ", requests: " << statistics.numRequests
+                  << ", rendered: " << statistics.numRendered
+                  << ", resident: " << ProcessMemory::formatBytes(ProcessMemory::getResidentSetSizeInBytes()) << std::endl;
+    }
+
+    return 0;
+}
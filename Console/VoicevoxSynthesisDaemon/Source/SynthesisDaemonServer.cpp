@@ -0,0 +1,133 @@
+#include "SynthesisDaemonServer.h"
+#include "Audio/WavAudioCodec.h"
+
+//==============================================================================
+SynthesisDaemonServer::Connection::Connection(SynthesisDaemonServer& owner)
+    : juce::InterprocessConnection(false)
+    , ownerRef(owner)
+    , cancellationToken(std::make_shared<CancellationToken>())
+{
+}
+
+SynthesisDaemonServer::Connection::~Connection()
+{
+    disconnect();
+}
+
+void SynthesisDaemonServer::Connection::connectionMade()
+{
+    juce::Logger::outputDebugString("[SynthesisDaemonServer] connection from " + getConnectedHostName());
+
+    const juce::ScopedLock scoped_lock(ownerRef.lock);
+    ownerRef.statistics.numConnections++;
+}
+
+void SynthesisDaemonServer::Connection::connectionLost()
+{
+    cancellationToken->cancel();
+
+    const juce::ScopedLock scoped_lock(ownerRef.lock);
+    ownerRef.statistics.numConnections--;
+}
+
+void SynthesisDaemonServer::Connection::messageReceived(const juce::MemoryBlock& message)
+{
+    const auto parsed_message = SynthesisDaemonProtocol::parseMessage(message);
+    const auto message_type = SynthesisDaemonProtocol::getMessageType(parsed_message);
+
+    if (message_type == "get_metadata")
+    {
+        sendMessage(SynthesisDaemonProtocol::makeMetadataMessage(ownerRef.getMetadata()));
+    }
+    else if (message_type == "render")
+    {
+        const auto request = SynthesisDaemonProtocol::parseRequest(parsed_message);
+        const auto request_id = request.requestId;
+
+        {
+            const juce::ScopedLock scoped_lock(ownerRef.lock);
+            ownerRef.statistics.numRequests++;
+        }
+
+        ownerRef.requestQueue->submit(
+            request,
+            [this, request_id](const cctn::VoicevoxEngineArtefact& artefact) {
+                // The engine may return a wav; the plugin always gets samples.
+                sendMessage(SynthesisDaemonProtocol::makeRenderedMessage(request_id, WavAudioCodec::decodeArtefact(artefact)));
+
+                const juce::ScopedLock scoped_lock(ownerRef.lock);
+                ownerRef.statistics.numRendered++;
+            },
+            cancellationToken,
+            SynthesisDaemonProtocol::parsePriority(parsed_message),
+            SynthesisDaemonProtocol::parseTimelinePosition(parsed_message));
+    }
+}
+
+//==============================================================================
+SynthesisDaemonServer::SynthesisDaemonServer(VoicevoxEnginePool& enginePool, int coreBudget)
+    : enginePoolRef(enginePool)
+    , scheduler(enginePool, coreBudget)
+{
+    requestQueue = std::make_unique<VoicevoxRequestQueue>(scheduler, synthesisCache, audioQueryCache);
+
+    // Leftovers of clients which went away before taking their samples.
+    for (const auto& stale_file : SynthesisDaemonProtocol::getSharedMemoryDirectory().findChildFiles(juce::File::findFiles, false, "*.pcm"))
+    {
+        stale_file.deleteFile();
+    }
+}
+
+SynthesisDaemonServer::~SynthesisDaemonServer()
+{
+    stop();
+
+    // Waits for the requests in flight, so no callback refers to a connection any more.
+    requestQueue.reset();
+
+    const juce::ScopedLock scoped_lock(lock);
+    connections.clear();
+}
+
+//==============================================================================
+bool SynthesisDaemonServer::start(int port)
+{
+    return beginWaitingForSocket(port, "127.0.0.1");
+}
+
+void SynthesisDaemonServer::stop()
+{
+    juce::InterprocessConnectionServer::stop();
+
+    const juce::ScopedLock scoped_lock(lock);
+    for (auto& connection : connections)
+    {
+        connection->disconnect();
+    }
+}
+
+SynthesisDaemonServer::Statistics SynthesisDaemonServer::getStatistics() const
+{
+    const juce::ScopedLock scoped_lock(lock);
+    return statistics;
+}
+
+//==============================================================================
+juce::InterprocessConnection* SynthesisDaemonServer::createConnectionObject()
+{
+    const juce::ScopedLock scoped_lock(lock);
+    connections.push_back(std::make_unique<Connection>(*this));
+    return connections.back().get();
+}
+
+//==============================================================================
+SynthesisDaemonProtocol::Metadata SynthesisDaemonServer::getMetadata()
+{
+    SynthesisDaemonProtocol::Metadata metadata;
+    metadata.metaJson = enginePoolRef.getMetaJson();
+    metadata.speakerIdentifierToSpeakerId = enginePoolRef.getSpeakerIdentifierToSpeakerIdMap();
+    metadata.talkSpeakerIdentifierList = enginePoolRef.getTalkSpeakerIdentifierList();
+    metadata.hummingSpeakerIdentifierList = enginePoolRef.getHummingSpeakerIdentifierList();
+
+    return metadata;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <juce_events/juce_events.h>
+#include "Cache/AudioQueryCache.h"
+#include "Cache/SynthesisCache.h"
+#include "Daemon/SynthesisDaemonProtocol.h"
+#include "Engine/VoicevoxRequestQueue.h"
+
+//==============================================================================
+// SynthesisDaemonServer
+//
+// Serves the plugins running on this machine from one set of engines. Every
+// connection is a plugin instance; its requests share one request queue and
+// one cache with all other connections, and its rendered samples are handed
+// back through shared memory (see SynthesisDaemonProtocol).
+//==============================================================================
+class SynthesisDaemonServer final
+    : private juce::InterprocessConnectionServer
+{
+public:
+    //==============================================================================
+    struct Statistics
+    {
+        int numConnections{ 0 };
+        juce::int64 numRequests{ 0 };
+        juce::int64 numRendered{ 0 };
+    };
+
+    //==============================================================================
+    // The core budget bounds how many requests render at once, see InferenceScheduler.
+    SynthesisDaemonServer(VoicevoxEnginePool& enginePool, int coreBudget);
+    ~SynthesisDaemonServer() override;
+
+    //==============================================================================
+    // Listens on the loopback interface only.
+    bool start(int port);
+    void stop();
+
+    Statistics getStatistics() const;
+
+private:
+    //==============================================================================
+    class Connection final
+        : public juce::InterprocessConnection
+    {
+    public:
+        explicit Connection(SynthesisDaemonServer& owner);
+        ~Connection() override;
+
+        void connectionMade() override;
+        void connectionLost() override;
+        void messageReceived(const juce::MemoryBlock& message) override;
+
+    private:
+        SynthesisDaemonServer& ownerRef;
+        // Cancelled when the plugin goes away, so its pending requests are dropped.
+        CancellationTokenPtr cancellationToken;
+    };
+
+    //==============================================================================
+    // juce::InterprocessConnectionServer
+    juce::InterprocessConnection* createConnectionObject() override;
+
+    //==============================================================================
+    SynthesisDaemonProtocol::Metadata getMetadata();
+
+    //==============================================================================
+    VoicevoxEnginePool& enginePoolRef;
+    InferenceScheduler scheduler;
+    SynthesisCache synthesisCache;
+    AudioQueryCache audioQueryCache;
+    std::unique_ptr<VoicevoxRequestQueue> requestQueue;
+
+    mutable juce::CriticalSection lock;
+    // Kept until the server is destroyed: a request of a closed connection may still be calling back into it.
+    std::vector<std::unique_ptr<Connection>> connections;
+    Statistics statistics;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SynthesisDaemonServer)
+};
@@ -0,0 +1,100 @@
+#include "Cache/AudioQueryCache.h"
+
+namespace
+{
+    AudioQueryCache::Entry makeEntry(const juce::String& audioQueryJson, double frontendTimeMs = 0.0)
+    {
+        AudioQueryCache::Entry entry;
+        entry.audioQueryJson = audioQueryJson;
+        entry.frontendTimeMs = frontendTimeMs;
+
+        return entry;
+    }
+}
+
+//==============================================================================
+class AudioQueryCacheTests final
+    : public juce::UnitTest
+{
+public:
+    AudioQueryCacheTests()
+        : juce::UnitTest("AudioQueryCache", "Voicevox")
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest("Keys a sentence per speaker, apart from the renders");
+        {
+            expectEquals(AudioQueryCache::makeKey(1, " Hello. ").hash, AudioQueryCache::makeKey(1, "Hello.").hash);
+            expectNotEquals(AudioQueryCache::makeKey(2, "Hello.").hash, AudioQueryCache::makeKey(1, "Hello.").hash);
+
+            cctn::VoicevoxEngineRequest request;
+            request.speakerId = 1;
+            request.text = "Hello.";
+            request.processType = cctn::VoicevoxEngineProcessType::kTalk;
+            expectNotEquals(SynthesisCache::makeKey(request).normalizedRequest, AudioQueryCache::makeKey(1, "Hello.").normalizedRequest);
+        }
+
+        beginTest("Counts hits, misses and the frontend time saved");
+        {
+            AudioQueryCache audio_query_cache;
+            const auto key = AudioQueryCache::makeKey(1, "Hello.");
+
+            expect(!audio_query_cache.lookup(key).has_value());
+            audio_query_cache.store(key, makeEntry("{\"accent_phrases\": []}", 40.0));
+
+            const auto entry = audio_query_cache.lookup(key);
+            expect(entry.has_value());
+            expectEquals(entry->audioQueryJson, juce::String("{\"accent_phrases\": []}"));
+            expect(audio_query_cache.lookup(key).has_value());
+
+            const auto statistics = audio_query_cache.getStatistics();
+            expectEquals(statistics.numHits, (juce::int64)2);
+            expectEquals(statistics.numMisses, (juce::int64)1);
+            expectEquals(statistics.numEntries, 1);
+            expectEquals(statistics.savedFrontendTimeMs, 80.0);
+            expectWithinAbsoluteError(statistics.getHitRate(), 2.0 / 3.0, 1.0e-9);
+        }
+
+        beginTest("Evicts the least recently used query to stay within the byte budget");
+        {
+            AudioQueryCache audio_query_cache;
+            audio_query_cache.setByteBudget(20);
+
+            const auto first_key = AudioQueryCache::makeKey(1, "first");
+            const auto second_key = AudioQueryCache::makeKey(1, "second");
+            const auto third_key = AudioQueryCache::makeKey(1, "third");
+
+            audio_query_cache.store(first_key, makeEntry("0123456789"));
+            audio_query_cache.store(second_key, makeEntry("0123456789"));
+
+            // Using the first query makes the second one the oldest.
+            expect(audio_query_cache.lookup(first_key).has_value());
+            audio_query_cache.store(third_key, makeEntry("0123456789"));
+
+            expect(audio_query_cache.lookup(first_key).has_value());
+            expect(!audio_query_cache.lookup(second_key).has_value());
+            expect(audio_query_cache.lookup(third_key).has_value());
+            expectEquals(audio_query_cache.getStatistics().numEvictions, (juce::int64)1);
+        }
+
+        beginTest("Drops every query when the model version changes");
+        {
+            AudioQueryCache audio_query_cache;
+            audio_query_cache.setModelVersion("first");
+
+            const auto key = AudioQueryCache::makeKey(1, "Hello.");
+            audio_query_cache.store(key, makeEntry("{\"accent_phrases\": []}"));
+
+            audio_query_cache.setModelVersion("first");
+            expect(audio_query_cache.lookup(key).has_value());
+
+            audio_query_cache.setModelVersion("second");
+            expect(!audio_query_cache.lookup(key).has_value());
+            expectEquals(audio_query_cache.getStatistics().numBytesUsed, (size_t)0);
+        }
+    }
+};
+
+static AudioQueryCacheTests audioQueryCacheTests;
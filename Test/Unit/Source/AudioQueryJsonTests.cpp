@@ -0,0 +1,47 @@
+#include "Engine/AudioQueryJson.h"
+
+//==============================================================================
+class AudioQueryJsonTests final
+    : public juce::UnitTest
+{
+public:
+    AudioQueryJsonTests()
+        : juce::UnitTest("AudioQueryJson", "Voicevox")
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest("Normalizes the formatting of a query");
+        {
+            const auto normalized_audio_query = AudioQueryJson::normalize("  {\n  \"accent_phrases\" : [ ],\n  \"speedScale\" : 1.0\n}");
+            expect(normalized_audio_query.has_value());
+            expectEquals(normalized_audio_query.value(), AudioQueryJson::normalize("{\"accent_phrases\":[],\"speedScale\":1.0}").value_or(juce::String()));
+        }
+
+        beginTest("Treats anything without accent phrases as text");
+        {
+            expect(!AudioQueryJson::isAudioQuery(juce::String::fromUTF8("こんにちは。")));
+            expect(!AudioQueryJson::isAudioQuery("{ is this json? }"));
+            expect(!AudioQueryJson::isAudioQuery("{\"speedScale\": 1.0}"));
+            expect(!AudioQueryJson::isAudioQuery("[{\"accent_phrases\": []}]"));
+            expect(AudioQueryJson::isAudioQuery("{\"accent_phrases\": []}"));
+        }
+
+        beginTest("Trims the padding only on the sides asked for");
+        {
+            const juce::String audio_query_json("{\"accent_phrases\": [], \"prePhonemeLength\": 0.1, \"postPhonemeLength\": 0.1}");
+            expectEquals(AudioQueryJson::trimPadding(audio_query_json, false, false), audio_query_json);
+
+            const auto leading_trimmed = juce::JSON::parse(AudioQueryJson::trimPadding(audio_query_json, true, false));
+            expectEquals((double)leading_trimmed.getProperty("prePhonemeLength", juce::var()), 0.0);
+            expectEquals((double)leading_trimmed.getProperty("postPhonemeLength", juce::var()), 0.1);
+
+            const auto both_trimmed = juce::JSON::parse(AudioQueryJson::trimPadding(audio_query_json, true, true));
+            expectEquals((double)both_trimmed.getProperty("prePhonemeLength", juce::var()), 0.0);
+            expectEquals((double)both_trimmed.getProperty("postPhonemeLength", juce::var()), 0.0);
+        }
+    }
+};
+
+static AudioQueryJsonTests audioQueryJsonTests;
@@ -0,0 +1,52 @@
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+namespace
+{
+    // Every test in this target is registered under this category.
+    const char* const kTestCategory = "Voicevox";
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    const juce::ScopedJuceInitialiser_GUI juce_initialiser;
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+
+    // Optionally only the test named on the command line, e.g. "SynthesisCache".
+    if (argc > 1)
+    {
+        const auto test_name = juce::String(juce::CharPointer_UTF8(argv[1]));
+
+        juce::Array<juce::UnitTest*> tests;
+        for (auto* test : juce::UnitTest::getTestsInCategory(kTestCategory))
+        {
+            if (test->getName() == test_name)
+            {
+                tests.add(test);
+            }
+        }
+
+        if (tests.isEmpty())
+        {
+            std::cerr << "No test named " << test_name << std::endl;
+            return 1;
+        }
+
+        runner.runTests(tests);
+    }
+    else
+    {
+        runner.runTestsInCategory(kTestCategory);
+    }
+
+    int num_failures = 0;
+    for (int result_idx = 0; result_idx < runner.getNumResults(); result_idx++)
+    {
+        num_failures += runner.getResult(result_idx)->failures;
+    }
+
+    return num_failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,117 @@
+#include "Score/PhraseAudioCache.h"
+
+namespace
+{
+    constexpr double kSampleRate = 24000.0;
+    // At 24kHz a frame is exactly 256 samples.
+    constexpr int kSamplesPerFrame = 256;
+
+    ScorePhrase makePhrase(const juce::String& fingerprint, int startFrame, int numFrames, int paddingRestFrames)
+    {
+        ScorePhrase phrase;
+        phrase.startFrame = startFrame;
+        phrase.numFrames = numFrames;
+        phrase.leadingRestFrames = paddingRestFrames;
+        phrase.trailingRestFrames = paddingRestFrames;
+        phrase.fingerprint = fingerprint;
+
+        return phrase;
+    }
+
+    cctn::AudioBufferInfo makeConstantAudio(int numFrames, float value)
+    {
+        cctn::AudioBufferInfo audio_buffer_info;
+        audio_buffer_info.sampleRate = kSampleRate;
+        audio_buffer_info.audioBuffer.setSize(1, numFrames * kSamplesPerFrame);
+        audio_buffer_info.audioBuffer.clear();
+        for (int sample_idx = 0; sample_idx < audio_buffer_info.audioBuffer.getNumSamples(); sample_idx++)
+        {
+            audio_buffer_info.audioBuffer.setSample(0, sample_idx, value);
+        }
+
+        return audio_buffer_info;
+    }
+
+    float getSampleAtFrame(const cctn::AudioBufferInfo& audioBufferInfo, int frame)
+    {
+        return audioBufferInfo.audioBuffer.getSample(0, frame * kSamplesPerFrame);
+    }
+}
+
+//==============================================================================
+class PhraseAudioCacheTests final
+    : public juce::UnitTest
+{
+public:
+    PhraseAudioCacheTests()
+        : juce::UnitTest("PhraseAudioCache", "Voicevox")
+    {
+    }
+
+    void runTest() override
+    {
+        // Frames 15 to 85 and 95 to 145, each with 15 frames of padding on either side.
+        const std::vector<ScorePhrase> phrases{ makePhrase("first", 15, 70, 15), makePhrase("second", 95, 50, 15) };
+
+        beginTest("Waits for every phrase unless missing ones are allowed");
+        {
+            PhraseAudioCache phrase_audio_cache;
+            phrase_audio_cache.store("first", makeConstantAudio(70, 1.0f));
+
+            expect(!phrase_audio_cache.stitch(phrases, 130).has_value());
+
+            const auto partial_audio = phrase_audio_cache.stitch(phrases, 130, true);
+            expect(partial_audio.has_value());
+            expectEquals(getSampleAtFrame(partial_audio.value(), 50), 1.0f);
+            expectEquals(getSampleAtFrame(partial_audio.value(), 120), 0.0f);
+        }
+
+        beginTest("Places every phrase at its position in the score");
+        {
+            PhraseAudioCache phrase_audio_cache;
+            phrase_audio_cache.store("first", makeConstantAudio(70, 1.0f));
+            phrase_audio_cache.store("second", makeConstantAudio(50, 0.5f));
+
+            const auto stitched_audio = phrase_audio_cache.stitch(phrases, 130);
+            expect(stitched_audio.has_value());
+            expectEquals(stitched_audio->sampleRate, kSampleRate);
+
+            // The last phrase's trailing padding reaches past the end of the score.
+            expectEquals(stitched_audio->audioBuffer.getNumSamples(), 145 * kSamplesPerFrame);
+
+            expectEquals(getSampleAtFrame(stitched_audio.value(), 5), 0.0f);
+            expectEquals(getSampleAtFrame(stitched_audio.value(), 50), 1.0f);
+            expectEquals(getSampleAtFrame(stitched_audio.value(), 90), 0.0f);
+            expectEquals(getSampleAtFrame(stitched_audio.value(), 120), 0.5f);
+        }
+
+        beginTest("Fades each phrase over its padding rests");
+        {
+            PhraseAudioCache phrase_audio_cache;
+            phrase_audio_cache.store("first", makeConstantAudio(70, 1.0f));
+            phrase_audio_cache.store("second", makeConstantAudio(50, 1.0f));
+
+            const auto stitched_audio = phrase_audio_cache.stitch(phrases, 130);
+            expect(stitched_audio.has_value());
+
+            expectEquals(getSampleAtFrame(stitched_audio.value(), 15), 0.0f);
+            const auto fade_in_sample = getSampleAtFrame(stitched_audio.value(), 22);
+            expect(fade_in_sample > 0.0f && fade_in_sample < 1.0f);
+            const auto fade_out_sample = getSampleAtFrame(stitched_audio.value(), 78);
+            expect(fade_out_sample > 0.0f && fade_out_sample < 1.0f);
+        }
+
+        beginTest("Drops the audio of phrases no longer in the score");
+        {
+            PhraseAudioCache phrase_audio_cache;
+            phrase_audio_cache.store("first", makeConstantAudio(70, 1.0f));
+            phrase_audio_cache.store("removed", makeConstantAudio(10, 1.0f));
+
+            phrase_audio_cache.retainOnly(phrases);
+            expect(phrase_audio_cache.contains("first"));
+            expect(!phrase_audio_cache.contains("removed"));
+        }
+    }
+};
+
+static PhraseAudioCacheTests phraseAudioCacheTests;
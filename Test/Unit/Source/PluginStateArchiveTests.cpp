@@ -0,0 +1,138 @@
+#include "State/PluginStateArchive.h"
+
+namespace
+{
+    PluginStateArchive::Contents makeContents()
+    {
+        PluginStateArchive::Contents contents;
+        contents.talkText = juce::String::fromUTF8("こんにちは。");
+        contents.songDocument = "{\"tracks\": []}";
+        contents.selectedTalkSpeakerIdentifier = "talk speaker";
+        contents.selectedHummingSpeakerIdentifier = "humming speaker";
+
+        return contents;
+    }
+
+    juce::MemoryBlock writeStateWithVersion(int version)
+    {
+        juce::ValueTree state("VoicevoxPluginState");
+        state.setProperty("version", version, nullptr);
+        state.setProperty("talkText", "text", nullptr);
+
+        juce::MemoryBlock state_data;
+        {
+            juce::MemoryOutputStream output_stream(state_data, false);
+            state.writeToStream(output_stream);
+        }
+
+        return state_data;
+    }
+}
+
+//==============================================================================
+class PluginStateArchiveTests final
+    : public juce::UnitTest
+{
+public:
+    PluginStateArchiveTests()
+        : juce::UnitTest("PluginStateArchive", "Voicevox")
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest("Round-trips the document and the speakers");
+        {
+            const auto contents = makeContents();
+
+            juce::MemoryBlock state_data;
+            PluginStateArchive::write(contents, state_data);
+
+            const auto restored = PluginStateArchive::read(state_data.getData(), (int)state_data.getSize());
+            expect(restored.has_value());
+            expectEquals(restored->version, PluginStateArchive::kCurrentVersion);
+            expectEquals(restored->talkText, contents.talkText);
+            expectEquals(restored->songDocument, contents.songDocument);
+            expectEquals(restored->selectedTalkSpeakerIdentifier, contents.selectedTalkSpeakerIdentifier);
+            expectEquals(restored->selectedHummingSpeakerIdentifier, contents.selectedHummingSpeakerIdentifier);
+            expect(!restored->embedsRenderedAudio);
+            expectEquals((int)restored->compressedAudio.getSize(), 0);
+        }
+
+        beginTest("Embeds the rendered audio only when asked to");
+        {
+            juce::AudioBuffer<float> audio_buffer(1, 2400);
+            for (int sample_idx = 0; sample_idx < audio_buffer.getNumSamples(); sample_idx++)
+            {
+                audio_buffer.setSample(0, sample_idx, 0.5f * std::sin((float)sample_idx * 0.05f));
+            }
+
+            auto contents = makeContents();
+            contents.compressedAudio = PluginStateArchive::compressAudio(audio_buffer, 24000.0);
+            expect(contents.compressedAudio.getSize() > 0);
+
+            juce::MemoryBlock state_without_audio;
+            PluginStateArchive::write(contents, state_without_audio);
+            const auto restored_without_audio = PluginStateArchive::read(state_without_audio.getData(), (int)state_without_audio.getSize());
+            expect(restored_without_audio.has_value());
+            expectEquals((int)restored_without_audio->compressedAudio.getSize(), 0);
+
+            contents.embedsRenderedAudio = true;
+            juce::MemoryBlock state_with_audio;
+            PluginStateArchive::write(contents, state_with_audio);
+            const auto restored = PluginStateArchive::read(state_with_audio.getData(), (int)state_with_audio.getSize());
+            expect(restored.has_value());
+            expect(restored->embedsRenderedAudio);
+
+            const auto decompressed_audio = PluginStateArchive::decompressAudio(restored->compressedAudio);
+            expect(decompressed_audio.has_value());
+            expectEquals(decompressed_audio->sampleRate, 24000.0);
+            expectEquals(decompressed_audio->audioBuffer.getNumSamples(), audio_buffer.getNumSamples());
+
+            // 24 bits, so well within a thousandth.
+            float max_error = 0.0f;
+            for (int sample_idx = 0; sample_idx < audio_buffer.getNumSamples(); sample_idx++)
+            {
+                max_error = juce::jmax(max_error, std::abs(decompressed_audio->audioBuffer.getSample(0, sample_idx) - audio_buffer.getSample(0, sample_idx)));
+            }
+
+            expectLessThan(max_error, 1.0e-3f);
+        }
+
+        beginTest("Accepts its own and older versions and ignores newer ones");
+        {
+            const auto current_state = writeStateWithVersion(PluginStateArchive::kCurrentVersion);
+            expect(PluginStateArchive::read(current_state.getData(), (int)current_state.getSize()).has_value());
+
+            // A version 1 state only had the VOICEVOX score, so everything but the document is recalled.
+            const auto first_state = writeStateWithVersion(1);
+            const auto restored_first_state = PluginStateArchive::read(first_state.getData(), (int)first_state.getSize());
+            expect(restored_first_state.has_value());
+            expectEquals(restored_first_state->talkText, juce::String("text"));
+            expect(restored_first_state->songDocument.isEmpty());
+
+            const auto newer_state = writeStateWithVersion(PluginStateArchive::kCurrentVersion + 1);
+            expect(!PluginStateArchive::read(newer_state.getData(), (int)newer_state.getSize()).has_value());
+
+            const auto unversioned_state = writeStateWithVersion(0);
+            expect(!PluginStateArchive::read(unversioned_state.getData(), (int)unversioned_state.getSize()).has_value());
+        }
+
+        beginTest("Ignores data that is not a plugin state");
+        {
+            juce::MemoryBlock other_state;
+            {
+                juce::MemoryOutputStream output_stream(other_state, false);
+                juce::ValueTree("SomethingElse").writeToStream(output_stream);
+            }
+            expect(!PluginStateArchive::read(other_state.getData(), (int)other_state.getSize()).has_value());
+
+            const char garbage[] = "not a value tree";
+            expect(!PluginStateArchive::read(garbage, (int)sizeof(garbage)).has_value());
+
+            expect(!PluginStateArchive::decompressAudio({}).has_value());
+        }
+    }
+};
+
+static PluginStateArchiveTests pluginStateArchiveTests;
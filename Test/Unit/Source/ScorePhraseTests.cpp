@@ -0,0 +1,156 @@
+#include "Score/ScorePhraseBatcher.h"
+#include "Score/ScorePhraseSplitter.h"
+#include "Cache/SynthesisCache.h"
+
+namespace
+{
+    juce::var makeNote(int key, int numFrames, const juce::String& lyric)
+    {
+        juce::DynamicObject::Ptr note = new juce::DynamicObject();
+        note->setProperty("key", key);
+        note->setProperty("frame_length", numFrames);
+        note->setProperty("lyric", lyric);
+
+        return juce::var(note.get());
+    }
+
+    // Rest 30, "do" 20, "re" 20, rest, "mi" 20, without a rest at the end.
+    juce::String makeScoreJson(int middleRestFrames = 40, int lastKey = 64)
+    {
+        juce::Array<juce::var> notes;
+        notes.add(ScorePhraseSplitter::makeRest(30));
+        notes.add(makeNote(60, 20, "do"));
+        notes.add(makeNote(62, 20, "re"));
+        notes.add(ScorePhraseSplitter::makeRest(middleRestFrames));
+        notes.add(makeNote(lastKey, 20, "mi"));
+
+        juce::DynamicObject::Ptr score = new juce::DynamicObject();
+        score->setProperty("notes", notes);
+
+        return juce::JSON::toString(juce::var(score.get()), true);
+    }
+}
+
+//==============================================================================
+class ScorePhraseTests final
+    : public juce::UnitTest
+{
+public:
+    ScorePhraseTests()
+        : juce::UnitTest("ScorePhrase", "Voicevox")
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest("Splits at rests and pads each phrase");
+        {
+            const auto phrases = ScorePhraseSplitter().split(makeScoreJson(), "salt");
+            expectEquals((int)phrases.size(), 2);
+
+            expectEquals(phrases[0].leadingRestFrames, 15);
+            expectEquals(phrases[0].trailingRestFrames, 15);
+            expectEquals(phrases[0].startFrame, 15);
+            expectEquals(phrases[0].numFrames, 70);
+            expectEquals(ScorePhraseSplitter::getTotalFrames(phrases[0].scoreJson), phrases[0].numFrames);
+
+            // Nothing follows the last phrase, so it gets a synthetic trailing rest.
+            expectEquals(phrases[1].startFrame, 95);
+            expectEquals(phrases[1].numFrames, 50);
+            expectEquals(ScorePhraseSplitter::getTotalFrames(makeScoreJson()), 130);
+        }
+
+        beginTest("Fingerprints follow the notes and the salt");
+        {
+            const ScorePhraseSplitter splitter;
+            const auto phrases = splitter.split(makeScoreJson(), "salt");
+
+            const auto same_phrases = splitter.split(makeScoreJson(), "salt");
+            expectEquals(same_phrases[0].fingerprint, phrases[0].fingerprint);
+            expectEquals(same_phrases[1].fingerprint, phrases[1].fingerprint);
+
+            const auto other_speaker_phrases = splitter.split(makeScoreJson(), "other salt");
+            expectNotEquals(other_speaker_phrases[0].fingerprint, phrases[0].fingerprint);
+
+            // Editing one phrase leaves the fingerprint of the other alone.
+            const auto edited_phrases = splitter.split(makeScoreJson(40, 65), "salt");
+            expectEquals(edited_phrases[0].fingerprint, phrases[0].fingerprint);
+            expectNotEquals(edited_phrases[1].fingerprint, phrases[1].fingerprint);
+
+            // Moving a phrase keeps its fingerprint, as long as its padding rests stay the same.
+            const auto moved_phrases = splitter.split(makeScoreJson(50), "salt");
+            expectEquals(moved_phrases[1].fingerprint, phrases[1].fingerprint);
+            expectEquals(moved_phrases[1].startFrame, phrases[1].startFrame + 10);
+        }
+
+        beginTest("Batches phrases up to a bucket multiple");
+        {
+            const auto phrases = ScorePhraseSplitter().split(makeScoreJson(), "salt");
+            const auto batches = ScorePhraseBatcher().makeBatches({ &phrases[0], &phrases[1] });
+            expectEquals((int)batches.size(), 1);
+
+            const auto& batch = batches[0];
+            expectEquals((int)batch.phraseIndices.size(), 2);
+            expectEquals(batch.phraseStartFrames[0], 0);
+            expectEquals(batch.phraseStartFrames[1], 70);
+            expectEquals(batch.numFrames, ScorePhraseBatcher::kBucketFrames);
+            expectEquals(ScorePhraseSplitter::getTotalFrames(batch.scoreJson), batch.numFrames);
+        }
+
+        beginTest("Makes a batch per engine while there are enough phrases");
+        {
+            std::vector<ScorePhrase> phrases(3);
+            for (auto& phrase : phrases)
+            {
+                phrase.numFrames = 200;
+                phrase.scoreJson = "{\"notes\": []}";
+            }
+
+            const std::vector<const ScorePhrase*> phrase_pointers{ &phrases[0], &phrases[1], &phrases[2] };
+
+            const auto single_batch = ScorePhraseBatcher().makeBatches(phrase_pointers, 1);
+            expectEquals((int)single_batch.size(), 1);
+            expectEquals(single_batch[0].numFrames, 768);
+
+            expectEquals((int)ScorePhraseBatcher().makeBatches(phrase_pointers, 3).size(), 3);
+            expectEquals((int)ScorePhraseBatcher(ScorePhraseBatcher::kBucketFrames).makeBatches(phrase_pointers, 1).size(), 3);
+        }
+
+        beginTest("Cuts a phrase back out of the rendered batch");
+        {
+            const auto phrases = ScorePhraseSplitter().split(makeScoreJson(), "salt");
+            const auto batch = ScorePhraseBatcher().makeBatches({ &phrases[0], &phrases[1] })[0];
+
+            // 24kHz gives 256 samples per frame; every sample holds its own index.
+            cctn::AudioBufferInfo batch_audio;
+            batch_audio.sampleRate = 24000.0;
+            batch_audio.audioBuffer.setSize(1, batch.numFrames * 256);
+            for (int sample_idx = 0; sample_idx < batch_audio.audioBuffer.getNumSamples(); sample_idx++)
+            {
+                batch_audio.audioBuffer.setSample(0, sample_idx, (float)sample_idx);
+            }
+
+            const auto phrase_audio = ScorePhraseBatcher::extractPhraseAudio(batch, 1, phrases[1], batch_audio);
+            expect(phrase_audio.has_value());
+            expectEquals(phrase_audio->audioBuffer.getNumSamples(), 50 * 256);
+            expectEquals(phrase_audio->audioBuffer.getSample(0, 0), 70.0f * 256.0f);
+
+            expect(!ScorePhraseBatcher::extractPhraseAudio(batch, 2, phrases[1], batch_audio).has_value());
+        }
+
+        beginTest("Keys each phrase on its own, whichever batch it was rendered in");
+        {
+            const auto phrases = ScorePhraseSplitter().split(makeScoreJson(), "salt");
+            const auto moved_phrases = ScorePhraseSplitter().split(makeScoreJson(50), "salt");
+
+            // The last phrase is unchanged, only moved later in the score.
+            const auto phrase_key = SynthesisCache::makeKey(ScorePhraseBatcher::makePhraseRequest(phrases[1], 3000, 24000.0));
+            expectEquals(SynthesisCache::makeKey(ScorePhraseBatcher::makePhraseRequest(moved_phrases[1], 3000, 24000.0)).hash, phrase_key.hash);
+
+            expectNotEquals(SynthesisCache::makeKey(ScorePhraseBatcher::makePhraseRequest(phrases[1], 3001, 24000.0)).hash, phrase_key.hash);
+            expectNotEquals(SynthesisCache::makeKey(ScorePhraseBatcher::makePhraseRequest(phrases[0], 3000, 24000.0)).hash, phrase_key.hash);
+        }
+    }
+};
+
+static ScorePhraseTests scorePhraseTests;
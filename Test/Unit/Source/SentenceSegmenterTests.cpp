@@ -0,0 +1,64 @@
+#include "Text/SentenceSegmenter.h"
+
+//==============================================================================
+class SentenceSegmenterTests final
+    : public juce::UnitTest
+{
+public:
+    SentenceSegmenterTests()
+        : juce::UnitTest("SentenceSegmenter", "Voicevox")
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest("Splits at sentence terminators");
+        {
+            const auto sentences = SentenceSegmenter().split(juce::String::fromUTF8("こんにちは。元気ですか？はい! Yes?"));
+            expectEquals(sentences.size(), 4);
+            expectEquals(sentences[0], juce::String::fromUTF8("こんにちは。"));
+            expectEquals(sentences[1], juce::String::fromUTF8("元気ですか？"));
+            expectEquals(sentences[2], juce::String::fromUTF8("はい!"));
+            expectEquals(sentences[3], juce::String("Yes?"));
+        }
+
+        beginTest("Splits at line breaks and drops empty lines");
+        {
+            const auto sentences = SentenceSegmenter().split(juce::String::fromUTF8("一行目\r\n\n  二行目  \n"));
+            expectEquals(sentences.size(), 2);
+            expectEquals(sentences[0], juce::String::fromUTF8("一行目"));
+            expectEquals(sentences[1], juce::String::fromUTF8("二行目"));
+        }
+
+        beginTest("Keeps closing brackets and repeated terminators with the sentence");
+        {
+            const auto sentences = SentenceSegmenter().split(juce::String::fromUTF8("「はい。」本当？！次。"));
+            expectEquals(sentences.size(), 3);
+            expectEquals(sentences[0], juce::String::fromUTF8("「はい。」"));
+            expectEquals(sentences[1], juce::String::fromUTF8("本当？！"));
+            expectEquals(sentences[2], juce::String::fromUTF8("次。"));
+        }
+
+        beginTest("Text without terminators is one sentence");
+        {
+            expectEquals(SentenceSegmenter().split("no terminator").size(), 1);
+            expectEquals(SentenceSegmenter().split("  \n ").size(), 0);
+        }
+
+        beginTest("Long sentences are split at clause separators");
+        {
+            const auto text = juce::String::fromUTF8("あいうえお、かきくけこ、さしすせそ。");
+
+            expectEquals(SentenceSegmenter().split(text).size(), 1);
+
+            const auto segments = SentenceSegmenter(10).split(text);
+            expectEquals(segments.size(), 3);
+            expectEquals(segments[0], juce::String::fromUTF8("あいうえお、"));
+            expectEquals(segments[1], juce::String::fromUTF8("かきくけこ、"));
+            expectEquals(segments[2], juce::String::fromUTF8("さしすせそ。"));
+            expectEquals(segments.joinIntoString({}), text);
+        }
+    }
+};
+
+static SentenceSegmenterTests sentenceSegmenterTests;
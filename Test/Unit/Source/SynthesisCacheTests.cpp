@@ -0,0 +1,140 @@
+#include "Cache/SynthesisCache.h"
+
+namespace
+{
+    // One channel of 100 float samples.
+    constexpr size_t kEntrySizeInBytes = 100 * sizeof(float);
+
+    cctn::VoicevoxEngineRequest makeTalkRequest(const juce::String& text, juce::int64 speakerId = 1)
+    {
+        cctn::VoicevoxEngineRequest request;
+        request.requestId = juce::Uuid();
+        request.speakerId = speakerId;
+        request.text = text;
+        request.processType = cctn::VoicevoxEngineProcessType::kTalk;
+
+        return request;
+    }
+
+    SynthesisCache::Entry makeEntry(double renderTimeMs = 0.0)
+    {
+        cctn::AudioBufferInfo audio_buffer_info;
+        audio_buffer_info.sampleRate = 24000.0;
+        audio_buffer_info.audioBuffer.setSize(1, 100);
+        audio_buffer_info.audioBuffer.clear();
+
+        SynthesisCache::Entry entry;
+        entry.audioBufferInfo = audio_buffer_info;
+        entry.renderTimeMs = renderTimeMs;
+
+        return entry;
+    }
+}
+
+//==============================================================================
+class SynthesisCacheTests final
+    : public juce::UnitTest
+{
+public:
+    SynthesisCacheTests()
+        : juce::UnitTest("SynthesisCache", "Voicevox")
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest("Keys ignore formatting but not content");
+        {
+            auto request = makeTalkRequest({});
+            request.processType = cctn::VoicevoxEngineProcessType::kHumming;
+            request.scoreJson = "{ \"notes\" : [ ] }";
+
+            auto reformatted_request = request;
+            reformatted_request.requestId = juce::Uuid();
+            reformatted_request.scoreJson = "{\"notes\":[]}";
+            expectEquals(SynthesisCache::makeKey(reformatted_request).hash, SynthesisCache::makeKey(request).hash);
+
+            expectEquals(SynthesisCache::makeKey(makeTalkRequest(" Hello. ")).hash, SynthesisCache::makeKey(makeTalkRequest("Hello.")).hash);
+            expectNotEquals(SynthesisCache::makeKey(makeTalkRequest("Hello.", 2)).hash, SynthesisCache::makeKey(makeTalkRequest("Hello.")).hash);
+        }
+
+        beginTest("Keys an AudioQuery apart from the text and from other queries");
+        {
+            const auto request = makeTalkRequest({});
+            const auto key = SynthesisCache::makeKey(request, "{ \"accent_phrases\" : [ ], \"speedScale\" : 1.0 }");
+
+            expectEquals(SynthesisCache::makeKey(request, "{\"accent_phrases\":[],\"speedScale\":1.0}").hash, key.hash);
+            expectNotEquals(SynthesisCache::makeKey(request, "{\"accent_phrases\":[],\"speedScale\":1.5}").hash, key.hash);
+            expectNotEquals(SynthesisCache::makeKey(request).hash, key.hash);
+
+            // Engine requests keep the keys they had before queries were keyed.
+            expectEquals(SynthesisCache::makeKey(request, {}).hash, SynthesisCache::makeKey(request).hash);
+        }
+
+        beginTest("Counts hits, misses and the render time saved");
+        {
+            SynthesisCache synthesis_cache;
+            const auto key = SynthesisCache::makeKey(makeTalkRequest("Hello."));
+
+            expect(!synthesis_cache.lookup(key).has_value());
+            synthesis_cache.store(key, makeEntry(250.0));
+            expect(synthesis_cache.lookup(key).has_value());
+            expect(synthesis_cache.lookup(key).has_value());
+
+            const auto statistics = synthesis_cache.getStatistics();
+            expectEquals(statistics.numHits, (juce::int64)2);
+            expectEquals(statistics.numMisses, (juce::int64)1);
+            expectEquals(statistics.numEntries, 1);
+            expectEquals(statistics.numBytesUsed, kEntrySizeInBytes);
+            expectEquals(statistics.savedRenderTimeMs, 500.0);
+            expectWithinAbsoluteError(statistics.getHitRate(), 2.0 / 3.0, 1.0e-9);
+        }
+
+        beginTest("Evicts the least recently used entry to stay within the byte budget");
+        {
+            SynthesisCache synthesis_cache;
+            synthesis_cache.setByteBudget(kEntrySizeInBytes * 2);
+
+            const auto first_key = SynthesisCache::makeKey(makeTalkRequest("first"));
+            const auto second_key = SynthesisCache::makeKey(makeTalkRequest("second"));
+            const auto third_key = SynthesisCache::makeKey(makeTalkRequest("third"));
+
+            synthesis_cache.store(first_key, makeEntry());
+            synthesis_cache.store(second_key, makeEntry());
+
+            // Using the first entry makes the second one the oldest.
+            expect(synthesis_cache.lookup(first_key).has_value());
+            synthesis_cache.store(third_key, makeEntry());
+
+            expect(synthesis_cache.lookup(first_key).has_value());
+            expect(!synthesis_cache.lookup(second_key).has_value());
+            expect(synthesis_cache.lookup(third_key).has_value());
+
+            const auto statistics = synthesis_cache.getStatistics();
+            expectEquals(statistics.numEvictions, (juce::int64)1);
+            expectEquals(statistics.numBytesUsed, kEntrySizeInBytes * 2);
+
+            // Lowering the budget evicts right away.
+            synthesis_cache.setByteBudget(kEntrySizeInBytes);
+            expectEquals(synthesis_cache.getStatistics().numEntries, 1);
+            expect(synthesis_cache.lookup(third_key).has_value());
+        }
+
+        beginTest("Does not keep entries without audio or beyond the budget");
+        {
+            SynthesisCache synthesis_cache;
+            synthesis_cache.setByteBudget(kEntrySizeInBytes / 2);
+
+            const auto key = SynthesisCache::makeKey(makeTalkRequest("Hello."));
+            synthesis_cache.store(key, makeEntry());
+            expect(!synthesis_cache.lookup(key).has_value());
+
+            synthesis_cache.setByteBudget(kEntrySizeInBytes);
+            synthesis_cache.store(key, SynthesisCache::Entry());
+            expect(!synthesis_cache.lookup(key).has_value());
+            expectEquals(synthesis_cache.getStatistics().numBytesUsed, (size_t)0);
+        }
+    }
+};
+
+static SynthesisCacheTests synthesisCacheTests;
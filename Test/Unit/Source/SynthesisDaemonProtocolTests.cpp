@@ -0,0 +1,150 @@
+#include "Daemon/SynthesisDaemonProtocol.h"
+
+//==============================================================================
+class SynthesisDaemonProtocolTests final
+    : public juce::UnitTest
+{
+public:
+    SynthesisDaemonProtocolTests()
+        : juce::UnitTest("SynthesisDaemonProtocol", "Voicevox")
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest("Round-trips the metadata");
+        {
+            SynthesisDaemonProtocol::Metadata metadata;
+            metadata.metaJson = juce::JSON::parse("[{\"name\": \"speaker\", \"styles\": [{\"id\": 3}]}]");
+            metadata.speakerIdentifierToSpeakerId["speaker/normal"] = 3;
+            metadata.speakerIdentifierToSpeakerId["singer/normal"] = 3000;
+            metadata.talkSpeakerIdentifierList.add("speaker/normal");
+            metadata.hummingSpeakerIdentifierList.add("singer/normal");
+
+            expectEquals(SynthesisDaemonProtocol::getMessageType(SynthesisDaemonProtocol::parseMessage(SynthesisDaemonProtocol::makeMetadataRequestMessage())),
+                         juce::String("get_metadata"));
+
+            const auto message = SynthesisDaemonProtocol::parseMessage(SynthesisDaemonProtocol::makeMetadataMessage(metadata));
+            expectEquals(SynthesisDaemonProtocol::getMessageType(message), juce::String("metadata"));
+
+            const auto parsed_metadata = SynthesisDaemonProtocol::parseMetadata(message);
+            expectEquals(juce::JSON::toString(parsed_metadata.metaJson, true), juce::JSON::toString(metadata.metaJson, true));
+            expect(parsed_metadata.speakerIdentifierToSpeakerId == metadata.speakerIdentifierToSpeakerId);
+            expect(parsed_metadata.talkSpeakerIdentifierList == metadata.talkSpeakerIdentifierList);
+            expect(parsed_metadata.hummingSpeakerIdentifierList == metadata.hummingSpeakerIdentifierList);
+        }
+
+        beginTest("Round-trips a render request");
+        {
+            cctn::VoicevoxEngineRequest request;
+            request.requestId = juce::Uuid();
+            request.speakerId = 3000;
+            request.scoreJson = "{\"notes\": []}";
+            request.sampleRate = 24000;
+            request.processType = cctn::VoicevoxEngineProcessType::kHumming;
+
+            const auto message = SynthesisDaemonProtocol::parseMessage(
+                SynthesisDaemonProtocol::makeRenderMessage(request, RequestPriority::kBackground, 12.5));
+            expectEquals(SynthesisDaemonProtocol::getMessageType(message), juce::String("render"));
+
+            const auto parsed_request = SynthesisDaemonProtocol::parseRequest(message);
+            expect(parsed_request.requestId == request.requestId);
+            expectEquals((juce::int64)parsed_request.speakerId, (juce::int64)request.speakerId);
+            expect(parsed_request.processType == cctn::VoicevoxEngineProcessType::kHumming);
+            expectEquals(parsed_request.scoreJson, request.scoreJson);
+            expectEquals((double)parsed_request.sampleRate, 24000.0);
+
+            expect(SynthesisDaemonProtocol::parsePriority(message) == RequestPriority::kBackground);
+            expectEquals(SynthesisDaemonProtocol::parseTimelinePosition(message).value_or(0.0), 12.5);
+        }
+
+        beginTest("Talk requests are interactive without a timeline position by default");
+        {
+            cctn::VoicevoxEngineRequest request;
+            request.requestId = juce::Uuid();
+            request.speakerId = 3;
+            request.text = juce::String::fromUTF8("こんにちは。");
+            request.processType = cctn::VoicevoxEngineProcessType::kTalk;
+
+            const auto message = SynthesisDaemonProtocol::parseMessage(
+                SynthesisDaemonProtocol::makeRenderMessage(request, RequestPriority::kInteractive, std::nullopt));
+
+            const auto parsed_request = SynthesisDaemonProtocol::parseRequest(message);
+            expect(parsed_request.processType == cctn::VoicevoxEngineProcessType::kTalk);
+            expectEquals(parsed_request.text, request.text);
+
+            expect(SynthesisDaemonProtocol::parsePriority(message) == RequestPriority::kInteractive);
+            expect(!SynthesisDaemonProtocol::parseTimelinePosition(message).has_value());
+        }
+
+        beginTest("Hands rendered audio over through shared memory");
+        {
+            cctn::AudioBufferInfo audio_buffer_info;
+            audio_buffer_info.sampleRate = 24000.0;
+            audio_buffer_info.audioBuffer.setSize(2, 480);
+            for (int channel_idx = 0; channel_idx < 2; channel_idx++)
+            {
+                for (int sample_idx = 0; sample_idx < 480; sample_idx++)
+                {
+                    audio_buffer_info.audioBuffer.setSample(channel_idx, sample_idx, (float)(channel_idx * 1000 + sample_idx));
+                }
+            }
+
+            const juce::Uuid request_id;
+            const auto message = SynthesisDaemonProtocol::parseMessage(SynthesisDaemonProtocol::makeRenderedMessage(request_id, audio_buffer_info));
+            expectEquals(SynthesisDaemonProtocol::getMessageType(message), juce::String("rendered"));
+
+            const auto shared_memory_file = SynthesisDaemonProtocol::getSharedMemoryDirectory().getChildFile(message.getProperty("shared_memory_file", juce::var()).toString());
+            expect(shared_memory_file.existsAsFile());
+
+            const auto artefact = SynthesisDaemonProtocol::parseRenderedMessage(message);
+            expect(artefact.requestId == request_id);
+            expect(artefact.audioBufferInfo.has_value());
+            expectEquals(artefact.audioBufferInfo->sampleRate, 24000.0);
+            expectEquals(artefact.audioBufferInfo->audioBuffer.getNumChannels(), 2);
+            expectEquals(artefact.audioBufferInfo->audioBuffer.getNumSamples(), 480);
+            expectEquals(artefact.audioBufferInfo->audioBuffer.getSample(1, 479), 1479.0f);
+
+            // The client deletes the file once it has taken the samples.
+            expect(!shared_memory_file.exists());
+        }
+
+        beginTest("Only takes the request's own file, with a valid layout");
+        {
+            cctn::AudioBufferInfo audio_buffer_info;
+            audio_buffer_info.sampleRate = 24000.0;
+            audio_buffer_info.audioBuffer.setSize(1, 480);
+            audio_buffer_info.audioBuffer.clear();
+
+            const auto other_file = juce::File::createTempFile(".pcm");
+            expect(other_file.replaceWithData(audio_buffer_info.audioBuffer.getReadPointer(0), 480 * sizeof(float)));
+
+            const juce::Uuid request_id;
+            auto message = SynthesisDaemonProtocol::parseMessage(SynthesisDaemonProtocol::makeRenderedMessage(request_id, audio_buffer_info));
+            const auto shared_memory_file = SynthesisDaemonProtocol::getSharedMemoryDirectory().getChildFile(message.getProperty("shared_memory_file", juce::var()).toString());
+
+            // A path, even to a file of the right size, is neither read nor deleted.
+            message.getDynamicObject()->setProperty("shared_memory_file", other_file.getFullPathName());
+            expect(!SynthesisDaemonProtocol::parseRenderedMessage(message).audioBufferInfo.has_value());
+            expect(other_file.existsAsFile());
+
+            message.getDynamicObject()->setProperty("shared_memory_file", shared_memory_file.getFileName());
+            message.getDynamicObject()->setProperty("num_channels", -1);
+            expect(!SynthesisDaemonProtocol::parseRenderedMessage(message).audioBufferInfo.has_value());
+            expect(!shared_memory_file.exists());
+
+            other_file.deleteFile();
+        }
+
+        beginTest("A failed render carries no audio");
+        {
+            const juce::Uuid request_id;
+            const auto artefact = SynthesisDaemonProtocol::parseRenderedMessage(
+                SynthesisDaemonProtocol::parseMessage(SynthesisDaemonProtocol::makeRenderedMessage(request_id, std::nullopt)));
+            expect(artefact.requestId == request_id);
+            expect(!artefact.audioBufferInfo.has_value());
+        }
+    }
+};
+
+static SynthesisDaemonProtocolTests synthesisDaemonProtocolTests;
@@ -0,0 +1,130 @@
+#include "Batch/TalkScript.h"
+
+namespace
+{
+    constexpr double kSampleRate = 100.0;
+
+    std::optional<juce::int64> resolveNumericSpeaker(const juce::String& speaker)
+    {
+        if (speaker.isEmpty() || !speaker.containsOnly("0123456789"))
+        {
+            return std::nullopt;
+        }
+
+        return speaker.getLargeIntValue();
+    }
+
+    TalkScriptLine makeLine(const juce::String& text, double gapInSeconds)
+    {
+        TalkScriptLine line;
+        line.speakerId = 1;
+        line.text = text;
+        line.gapInSeconds = gapInSeconds;
+
+        return line;
+    }
+
+    cctn::AudioBufferInfo makeConstantAudio(int numSamples, float value, double sampleRate = kSampleRate)
+    {
+        cctn::AudioBufferInfo audio_buffer_info;
+        audio_buffer_info.sampleRate = sampleRate;
+        audio_buffer_info.audioBuffer.setSize(1, numSamples);
+        for (int sample_idx = 0; sample_idx < numSamples; sample_idx++)
+        {
+            audio_buffer_info.audioBuffer.setSample(0, sample_idx, value);
+        }
+
+        return audio_buffer_info;
+    }
+}
+
+//==============================================================================
+class TalkScriptTests final
+    : public juce::UnitTest
+{
+public:
+    TalkScriptTests()
+        : juce::UnitTest("TalkScript", "Voicevox")
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest("Parses speakers, text and gaps");
+        {
+            juce::String error_message;
+            const auto lines = TalkScript::parse("# cast\n1\tHello.\n\n 2 \tGood bye.\t0.5\n", resolveNumericSpeaker, 0.3, error_message);
+            expect(lines.has_value());
+            expectEquals((int)lines->size(), 2);
+
+            expectEquals(lines->at(0).speakerId, (juce::int64)1);
+            expectEquals(lines->at(0).text, juce::String("Hello."));
+            expectEquals(lines->at(0).gapInSeconds, 0.3);
+
+            expectEquals(lines->at(1).speakerId, (juce::int64)2);
+            expectEquals(lines->at(1).text, juce::String("Good bye."));
+            expectEquals(lines->at(1).gapInSeconds, 0.5);
+        }
+
+        beginTest("Reports the first row it cannot use");
+        {
+            juce::String error_message;
+            expect(!TalkScript::parse("1\tHello.\nnobody\tHello.\n", resolveNumericSpeaker, 0.3, error_message).has_value());
+            expect(error_message.startsWith("Line 2: unknown speaker"));
+
+            expect(!TalkScript::parse("1\t \n", resolveNumericSpeaker, 0.3, error_message).has_value());
+            expect(error_message.startsWith("Line 1: expected"));
+        }
+
+        beginTest("Lays the lines out end to end with their gaps");
+        {
+            const std::vector<TalkScriptLine> lines{ makeLine("a", 0.5), makeLine("b", 0.5) };
+            const std::vector<std::optional<cctn::AudioBufferInfo>> line_audio{ makeConstantAudio(50, 1.0f), makeConstantAudio(20, 2.0f) };
+
+            std::vector<TalkScriptLineTiming> line_timings;
+            const auto timeline = TalkScript::assembleTimeline(lines, line_audio, line_timings);
+            expect(timeline.has_value());
+
+            // No gap after the last line.
+            expectEquals(timeline->audioBuffer.getNumSamples(), 50 + 50 + 20);
+            expectEquals(timeline->audioBuffer.getSample(0, 49), 1.0f);
+            expectEquals(timeline->audioBuffer.getSample(0, 75), 0.0f);
+            expectEquals(timeline->audioBuffer.getSample(0, 100), 2.0f);
+
+            expectEquals((int)line_timings.size(), 2);
+            expectEquals(line_timings[1].startTimeInSeconds, 1.0);
+            expectEquals(line_timings[1].lengthInSeconds, 0.2);
+        }
+
+        beginTest("Leaves out lines without audio or at another sample rate");
+        {
+            const std::vector<TalkScriptLine> lines{ makeLine("a", 0.5), makeLine("b", 0.5), makeLine("c", 0.5), makeLine("d", 0.0) };
+            const std::vector<std::optional<cctn::AudioBufferInfo>> line_audio{ makeConstantAudio(50, 1.0f),
+                                                                                std::nullopt,
+                                                                                makeConstantAudio(50, 1.0f, kSampleRate * 2.0),
+                                                                                makeConstantAudio(20, 2.0f) };
+
+            TalkScriptRenderResult result;
+            result.timeline = TalkScript::assembleTimeline(lines, line_audio, result.lineTimings);
+            expect(result.timeline.has_value());
+            expectEquals(result.getNumFailedLines(), 2);
+
+            expect(!result.lineTimings[1].succeeded);
+            expect(!result.lineTimings[2].succeeded);
+            expect(result.lineTimings[3].succeeded);
+            expectEquals(result.lineTimings[3].startTimeInSeconds, 1.0);
+        }
+
+        beginTest("No timeline when no line rendered");
+        {
+            const std::vector<TalkScriptLine> lines{ makeLine("a", 0.5) };
+            const std::vector<std::optional<cctn::AudioBufferInfo>> line_audio{ std::nullopt };
+
+            std::vector<TalkScriptLineTiming> line_timings;
+            expect(!TalkScript::assembleTimeline(lines, line_audio, line_timings).has_value());
+            expect(!line_timings[0].succeeded);
+        }
+    }
+};
+
+static TalkScriptTests talkScriptTests;
@@ -0,0 +1,49 @@
+#include "Engine/VoicevoxModelVariant.h"
+
+//==============================================================================
+class VoicevoxModelVariantTests final
+    : public juce::UnitTest
+{
+public:
+    VoicevoxModelVariantTests()
+        : juce::UnitTest("VoicevoxModelVariant", "Voicevox")
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest("Round-trips the variant names");
+        {
+            for (const auto variant : { VoicevoxModelVariant::kDefault, VoicevoxModelVariant::kInt8, VoicevoxModelVariant::kFp16 })
+            {
+                expect(VoicevoxModelVariants::fromString(VoicevoxModelVariants::toString(variant)) == variant);
+            }
+
+            expect(VoicevoxModelVariants::fromString(" INT8 ") == VoicevoxModelVariant::kInt8);
+            expect(!VoicevoxModelVariants::fromString("fp32").has_value());
+        }
+
+        beginTest("Finds a variant only where its models are installed");
+        {
+            const auto engine_directory = juce::File::createTempFile("engine");
+            expect(engine_directory.createDirectory());
+
+            const auto default_model_directory = VoicevoxModelVariants::getModelDirectory(engine_directory, VoicevoxModelVariant::kDefault);
+            const auto int8_model_directory = VoicevoxModelVariants::getModelDirectory(engine_directory, VoicevoxModelVariant::kInt8);
+            expectEquals(default_model_directory.getFileName(), juce::String("model"));
+            expectEquals(int8_model_directory.getFileName(), juce::String("model_int8"));
+
+            // An empty directory is not an installed variant.
+            expect(int8_model_directory.createDirectory());
+            expect(!VoicevoxModelVariants::isInstalled(engine_directory, VoicevoxModelVariant::kInt8));
+
+            expect(int8_model_directory.getChildFile("0.vvm").replaceWithText("model"));
+            expect(VoicevoxModelVariants::isInstalled(engine_directory, VoicevoxModelVariant::kInt8));
+            expect(!VoicevoxModelVariants::isInstalled(engine_directory, VoicevoxModelVariant::kFp16));
+
+            engine_directory.deleteRecursively();
+        }
+    }
+};
+
+static VoicevoxModelVariantTests voicevoxModelVariantTests;